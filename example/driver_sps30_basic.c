@@ -62,7 +62,11 @@ uint8_t sps30_basic_init(sps30_interface_t interface)
     DRIVER_SPS30_LINK_IIC_WRITE_COMMAND(&gs_handle, sps30_interface_iic_write_cmd);
     DRIVER_SPS30_LINK_IIC_READ_COMMAND(&gs_handle, sps30_interface_iic_read_cmd);
     DRIVER_SPS30_LINK_DELAY_MS(&gs_handle, sps30_interface_delay_ms);
+    DRIVER_SPS30_LINK_DELAY_US(&gs_handle, sps30_interface_delay_us);
     DRIVER_SPS30_LINK_DEBUG_PRINT(&gs_handle, sps30_interface_debug_print);
+#if (SPS30_ENABLE_TRACE == 1) || (SPS30_ENABLE_STATS == 1)
+    DRIVER_SPS30_LINK_NOW_US(&gs_handle, sps30_interface_now_us);
+#endif
     
     /* set the interface */
     res = sps30_set_interface(&gs_handle, interface);
@@ -133,6 +137,7 @@ uint8_t sps30_basic_deinit(void)
     return 0;
 }
 
+#if (SPS30_ENABLE_FLOAT == 1)
 /**
  * @brief      basic example read
  * @param[out] *pm pointer to a sps30_pm_t structure
@@ -156,6 +161,31 @@ uint8_t sps30_basic_read(sps30_pm_t *pm)
         return 0;
     }
 }
+#else
+/**
+ * @brief      basic example read as integers
+ * @param[out] *pm pointer to a sps30_pm_u16_t structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the float-less build measures in the uint16 format
+ */
+uint8_t sps30_basic_read_u16(sps30_pm_u16_t *pm)
+{
+    uint8_t res;
+    
+    /* read data */
+    res = sps30_read_u16(&gs_handle, pm);
+    if (res != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+#endif
 
 /**
  * @brief  basic example start fan cleaning
@@ -53,7 +53,11 @@ extern "C"{
 /**
  * @brief sps30 basic example default definition
  */
+#if (SPS30_ENABLE_FLOAT == 1)
 #define SPS30_BASIC_DEFAULT_FORMAT                        SPS30_FORMAT_IEEE754           /**< ieee754 */
+#else
+#define SPS30_BASIC_DEFAULT_FORMAT                        SPS30_FORMAT_UINT16            /**< uint16 */
+#endif
 #define SPS30_BASIC_DEFAULT_AUTO_CLEANING_INTERVAL        3600 * 24                      /**< 1 day */
 
 /**
@@ -75,6 +79,7 @@ uint8_t sps30_basic_init(sps30_interface_t interface);
  */
 uint8_t sps30_basic_deinit(void);
 
+#if (SPS30_ENABLE_FLOAT == 1)
 /**
  * @brief      basic example read
  * @param[out] *pm pointer to a sps30_pm_t structure
@@ -84,6 +89,17 @@ uint8_t sps30_basic_deinit(void);
  * @note       none
  */
 uint8_t sps30_basic_read(sps30_pm_t *pm);
+#else
+/**
+ * @brief      basic example read as integers
+ * @param[out] *pm pointer to a sps30_pm_u16_t structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the float-less build measures in the uint16 format
+ */
+uint8_t sps30_basic_read_u16(sps30_pm_u16_t *pm);
+#endif
 
 /**
  * @brief  basic example start fan cleaning
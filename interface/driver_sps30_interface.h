@@ -50,6 +50,17 @@ extern "C"{
  * @{
  */
 
+/**
+ * @brief sps30 interface clock structure definition
+ */
+typedef struct sps30_interface_clock_s
+{
+    uint32_t (*now_ms)(void *user);                 /**< point to a now ms function address */
+    void (*delay_ms)(void *user, uint32_t ms);      /**< point to an advance ms function address */
+    void (*delay_us)(void *user, uint32_t us);      /**< point to an advance us function address */
+    void *user;                                     /**< user context */
+} sps30_interface_clock_t;
+
 /**
  * @brief  interface iic bus init
  * @return status code
@@ -148,6 +159,38 @@ uint8_t sps30_interface_uart_flush(void);
  */
 void sps30_interface_delay_ms(uint32_t ms);
 
+/**
+ * @brief     interface delay us
+ * @param[in] us time
+ * @note      none
+ */
+void sps30_interface_delay_us(uint32_t us);
+
+/**
+ * @brief  interface get the current time
+ * @return current time in ms
+ * @note   reads the linked clock when one is set, else the platform timer
+ */
+uint32_t sps30_interface_now_ms(void);
+
+/**
+ * @brief  interface get the current time in us
+ * @return monotonic time in us
+ * @note   reads the linked clock in ms when one is set, else the platform timer,
+ *         link it with DRIVER_SPS30_LINK_NOW_US for the trace time and the stats latency
+ */
+uint32_t sps30_interface_now_us(void);
+
+/**
+ * @brief     interface set the time source
+ * @param[in] *clock pointer to a clock structure or NULL
+ * @note      when set, sps30_interface_delay_ms, sps30_interface_delay_us and
+ *            sps30_interface_now_ms use it instead of the platform timer,
+ *            so a virtual clock makes every wait of the driver and the tests
+ *            return at once, NULL restores the real time
+ */
+void sps30_interface_set_clock(const sps30_interface_clock_t *clock);
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
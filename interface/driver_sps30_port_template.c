@@ -0,0 +1,222 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_sps30_port_template.c
+ * @brief     driver sps30 port template source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2021-07-25
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2021/07/25  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_sps30.h"
+
+#if (SPS30_STATIC_PORT == 1)
+
+#if (SPS30_ENABLE_IIC == 1)
+/**
+ * @brief     port iic init
+ * @param[in] *user pointer to the user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      none
+ */
+uint8_t sps30_port_iic_init(void *user)
+{
+    return 0;
+}
+
+/**
+ * @brief     port iic deinit
+ * @param[in] *user pointer to the user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
+ */
+uint8_t sps30_port_iic_deinit(void *user)
+{
+    return 0;
+}
+
+/**
+ * @brief     port iic write command
+ * @param[in] *user pointer to the user context
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t sps30_port_iic_write_cmd(void *user, uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+
+/**
+ * @brief      port iic read command
+ * @param[in]  *user pointer to the user context
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t sps30_port_iic_read_cmd(void *user, uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+#endif
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief     port uart init
+ * @param[in] *user pointer to the user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart init failed
+ * @note      none
+ */
+uint8_t sps30_port_uart_init(void *user)
+{
+    return 0;
+}
+
+/**
+ * @brief     port uart deinit
+ * @param[in] *user pointer to the user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart deinit failed
+ * @note      none
+ */
+uint8_t sps30_port_uart_deinit(void *user)
+{
+    return 0;
+}
+
+/**
+ * @brief      port uart read
+ * @param[in]  *user pointer to the user context
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     length of the read data
+ * @note       none
+ */
+uint16_t sps30_port_uart_read(void *user, uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+
+/**
+ * @brief     port uart flush
+ * @param[in] *user pointer to the user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart flush failed
+ * @note      none
+ */
+uint8_t sps30_port_uart_flush(void *user)
+{
+    return 0;
+}
+
+/**
+ * @brief     port uart write
+ * @param[in] *user pointer to the user context
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t sps30_port_uart_write(void *user, uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+#endif
+
+/**
+ * @brief     port delay ms
+ * @param[in] *user pointer to the user context
+ * @param[in] ms time
+ * @note      none
+ */
+void sps30_port_delay_ms(void *user, uint32_t ms)
+{
+    
+}
+
+/**
+ * @brief     port delay us
+ * @param[in] *user pointer to the user context
+ * @param[in] us time
+ * @note      none
+ */
+void sps30_port_delay_us(void *user, uint32_t us)
+{
+    
+}
+
+#if (SPS30_ENABLE_TRACE == 1)
+/**
+ * @brief     port trace
+ * @param[in] *user pointer to the user context
+ * @param[in] type sps30_trace_t transaction type
+ * @param[in] *buf pointer to the transaction bytes
+ * @param[in] len transaction length
+ * @param[in] res transaction result
+ * @param[in] time_us trace clock in us
+ * @note      none
+ */
+void sps30_port_trace(void *user, uint8_t type, uint8_t *buf, uint16_t len, uint8_t res, uint32_t time_us)
+{
+    
+}
+#endif
+
+#if (SPS30_STATIC_PORT_CLOCK == 1)
+/**
+ * @brief     port get the current time
+ * @param[in] *user pointer to the user context
+ * @return    monotonic time in us
+ * @note      none
+ */
+uint32_t sps30_port_now_us(void *user)
+{
+    return 0;
+}
+#endif
+
+#endif
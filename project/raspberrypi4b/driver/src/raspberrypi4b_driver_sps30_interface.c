@@ -38,6 +38,7 @@
 #include "iic.h"
 #include "uart.h"
 #include <stdarg.h>
+#include <time.h>
 
 /**
  * @brief iic device name definition
@@ -59,6 +60,11 @@ static int iic_gs_fd;                       /**< iic handle */
  */
 static int uart_gs_fd;                      /**< uart handle */
 
+/**
+ * @brief linked clock, NULL for the platform timer
+ */
+static const sps30_interface_clock_t *gs_clock = NULL;    /**< clock handle */
+
 /**
  * @brief  interface iic bus init
  * @return status code
@@ -202,9 +208,81 @@ uint8_t sps30_interface_uart_flush(void)
  */
 void sps30_interface_delay_ms(uint32_t ms)
 {
+    if (gs_clock != NULL)
+    {
+        gs_clock->delay_ms(gs_clock->user, ms);
+        
+        return;
+    }
+    
     usleep(1000 * ms);
 }
 
+/**
+ * @brief     interface delay us
+ * @param[in] us time
+ * @note      none
+ */
+void sps30_interface_delay_us(uint32_t us)
+{
+    if (gs_clock != NULL)
+    {
+        gs_clock->delay_us(gs_clock->user, us);
+        
+        return;
+    }
+    
+    usleep(us);
+}
+
+/**
+ * @brief  interface get the current time
+ * @return current time in ms
+ * @note   none
+ */
+uint32_t sps30_interface_now_ms(void)
+{
+    struct timespec ts;
+    
+    if (gs_clock != NULL)
+    {
+        return gs_clock->now_ms(gs_clock->user);
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000);
+}
+
+/**
+ * @brief  interface get the current time in us
+ * @return monotonic time in us
+ * @note   none
+ */
+uint32_t sps30_interface_now_us(void)
+{
+    struct timespec ts;
+    
+    if (gs_clock != NULL)
+    {
+        return gs_clock->now_ms(gs_clock->user) * 1000;
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000);
+}
+
+/**
+ * @brief     interface set the time source
+ * @param[in] *clock pointer to a clock structure or NULL
+ * @note      none
+ */
+void sps30_interface_set_clock(const sps30_interface_clock_t *clock)
+{
+    gs_clock = clock;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
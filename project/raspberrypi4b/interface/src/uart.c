@@ -38,6 +38,7 @@
 #include <fcntl.h>
 #include <string.h>
 #include <termios.h>
+#include <errno.h>
 
 /**
  * @brief     uart config
@@ -394,7 +395,14 @@ uint8_t uart_read(int fd, uint8_t *buf, uint32_t *len)
     
     /* read data */
     l = read(fd, buf, *len);
-    if (l < 0) 
+    if ((l < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+    {
+        /* no data available now */
+        *len = 0;
+        
+        return 0;
+    }
+    else if (l < 0) 
     {
         perror("uart: read failed.\n");
         
@@ -0,0 +1,154 @@
+/**
+ * Copyright (C) LibDriver 2015-2021 All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      bench.c
+ * @brief     bench source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_sps30_api_bench_test.h"
+#include <getopt.h>
+#include <stdlib.h>
+
+/**
+ * @brief     sps30 bench function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+uint8_t sps30_bench(uint8_t argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"times", required_argument, NULL, 1},
+        {NULL, 0, NULL, 0},
+    };
+    uint32_t times = 10000;
+    
+    /* init 0 */
+    optind = 0;
+    
+    /* parse */
+    do
+    {
+        /* parse the args */
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        
+        /* judge the result */
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                sps30_interface_debug_print("Usage:\n");
+                sps30_interface_debug_print("  sps30_bench [--times=<num>]\n");
+                sps30_interface_debug_print("  sps30_bench (-h | --help)\n");
+                sps30_interface_debug_print("\n");
+                sps30_interface_debug_print("Options:\n");
+                sps30_interface_debug_print("  -h, --help                              Show the help.\n");
+                sps30_interface_debug_print("      --times=<num>                       Set the calls of each api.([default: 10000])\n");
+                
+                return 0;
+            }
+            
+            /* running times */
+            case 1 :
+            {
+                /* set the times */
+                times = atol(optarg);
+                
+                break;
+            }
+            
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+            
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+    
+    /* run the api bench against the software model */
+    if (sps30_api_bench_test(times) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      prints one json line per api, so the output can be compared between releases
+ */
+int main(int argc, char **argv)
+{
+    uint8_t res;
+
+    res = sps30_bench((uint8_t)argc, argv);
+    if (res == 0)
+    {
+        /* run success */
+    }
+    else if (res == 1)
+    {
+        sps30_interface_debug_print("sps30: run failed.\n");
+    }
+    else if (res == 5)
+    {
+        sps30_interface_debug_print("sps30: param is invalid.\n");
+    }
+    else
+    {
+        sps30_interface_debug_print("sps30: unknown status code.\n");
+    }
+
+    return (res == 0) ? 0 : 1;
+}
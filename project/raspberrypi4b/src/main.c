@@ -36,6 +36,10 @@
 
 #include "driver_sps30_register_test.h"
 #include "driver_sps30_read_test.h"
+#include "driver_sps30_bench_test.h"
+#include "driver_sps30_sim_test.h"
+#include "driver_sps30_replay_test.h"
+#include "driver_sps30_fault_test.h"
 #include "driver_sps30_basic.h"
 #include <getopt.h>
 #include <stdlib.h>
@@ -207,6 +211,54 @@ uint8_t sps30(uint8_t argc, char **argv)
             return 0;
         }
     }
+    else if (strcmp("t_sim", type) == 0)
+    {
+        /* sim test */
+        if (sps30_sim_test(interface, times) != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_replay", type) == 0)
+    {
+        /* replay test */
+        if (sps30_replay_test(interface, times) != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_fault", type) == 0)
+    {
+        /* fault test */
+        if (sps30_fault_test(interface, times) != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_bench", type) == 0)
+    {
+        /* bench test */
+        if (sps30_bench_test(times) != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
     else if (strcmp("e_read", type) == 0)
     {
         uint8_t res;
@@ -225,6 +277,7 @@ uint8_t sps30(uint8_t argc, char **argv)
         /* loop */
         for (i = 0; i < times; i++)
         {
+#if (SPS30_ENABLE_FLOAT == 1)
             sps30_pm_t pm;
             
             /* read data */
@@ -248,6 +301,31 @@ uint8_t sps30(uint8_t argc, char **argv)
             sps30_interface_debug_print("sps30: pm4.0 is %0.2f cm3.\n", pm.pm4p0_cm3);
             sps30_interface_debug_print("sps30: pm10.0 is %0.2f cm3.\n", pm.pm10_cm3);
             sps30_interface_debug_print("sps30: typical is %0.2f um.\n", pm.typical_particle_um);
+#else
+            sps30_pm_u16_t pm;
+            
+            /* read data */
+            res = sps30_basic_read_u16(&pm);
+            if (res != 0)
+            {
+                (void)sps30_basic_deinit();
+                
+                return 1;
+            }
+            
+            /* print */
+            sps30_interface_debug_print("sps30: %d/%d.\n", i + 1, times);
+            sps30_interface_debug_print("sps30: pm1.0 is %d ug/m3.\n", pm.pm1p0_ug_m3);
+            sps30_interface_debug_print("sps30: pm2.5 is %d ug/m3.\n", pm.pm2p5_ug_m3);
+            sps30_interface_debug_print("sps30: pm4.0 is %d ug/m3.\n", pm.pm4p0_ug_m3);
+            sps30_interface_debug_print("sps30: pm10.0 is %d ug/m3.\n", pm.pm10_ug_m3);
+            sps30_interface_debug_print("sps30: pm0.5 is %d cm3.\n", pm.pm0p5_cm3);
+            sps30_interface_debug_print("sps30: pm1.0 is %d cm3.\n", pm.pm1p0_cm3);
+            sps30_interface_debug_print("sps30: pm2.5 is %d cm3.\n", pm.pm2p5_cm3);
+            sps30_interface_debug_print("sps30: pm4.0 is %d cm3.\n", pm.pm4p0_cm3);
+            sps30_interface_debug_print("sps30: pm10.0 is %d cm3.\n", pm.pm10_cm3);
+            sps30_interface_debug_print("sps30: typical is %d nm.\n", pm.typical_particle_nm);
+#endif
             
             /* delay 2000 ms */
             sps30_interface_delay_ms(2000);
@@ -290,7 +368,7 @@ uint8_t sps30(uint8_t argc, char **argv)
     else if (strcmp("e_sn", type) == 0)
     {
         uint8_t res;
-        char sn[9];
+        char sn[17];
         
         /* init */
         res = sps30_basic_init(interface);
@@ -413,6 +491,10 @@ uint8_t sps30(uint8_t argc, char **argv)
         sps30_interface_debug_print("  sps30 (-p | --port)\n");
         sps30_interface_debug_print("  sps30 (-t reg | --test=reg) [--interface=<iic | uart>]\n");
         sps30_interface_debug_print("  sps30 (-t read | --test=read) [--interface=<iic | uart>] [--times=<num>]\n");
+        sps30_interface_debug_print("  sps30 (-t sim | --test=sim) [--interface=<iic | uart>] [--times=<num>]\n");
+        sps30_interface_debug_print("  sps30 (-t replay | --test=replay) [--interface=<iic | uart>] [--times=<num>]\n");
+        sps30_interface_debug_print("  sps30 (-t fault | --test=fault) [--interface=<iic | uart>] [--times=<num>]\n");
+        sps30_interface_debug_print("  sps30 (-t bench | --test=bench) [--times=<num>]\n");
         sps30_interface_debug_print("  sps30 (-e read | --example=read) [--interface=<iic | uart>] [--times=<num>]\n");
         sps30_interface_debug_print("  sps30 (-e type | --example=type) [--interface=<iic | uart>]\n");
         sps30_interface_debug_print("  sps30 (-e sn | --example=sn) [--interface=<iic | uart>]\n");
@@ -427,7 +509,8 @@ uint8_t sps30(uint8_t argc, char **argv)
         sps30_interface_debug_print("  -i, --information                       Show the chip information.\n");
         sps30_interface_debug_print("      --interface=<iic | uart>            Set the chip interface.([default: iic])\n");
         sps30_interface_debug_print("  -p, --port                              Display the pin connections of the current board.\n");
-        sps30_interface_debug_print("  -t <reg | read>, --test=<reg | read>    Run the driver test.\n");
+        sps30_interface_debug_print("  -t <reg | read | sim | replay | fault | bench>, --test=<reg | read | sim | replay | fault | bench>\n");
+        sps30_interface_debug_print("                                          Run the driver test.\n");
         sps30_interface_debug_print("      --times=<num>                       Set the running times.([default: 3])\n");
         
         return 0;
@@ -474,11 +557,11 @@ uint8_t sps30(uint8_t argc, char **argv)
  *             - 0 success
  * @note      none
  */
-int main(uint8_t argc, char **argv)
+int main(int argc, char **argv)
 {
     uint8_t res;
 
-    res = sps30(argc, argv);
+    res = sps30((uint8_t)argc, argv);
     if (res == 0)
     {
         /* run success */
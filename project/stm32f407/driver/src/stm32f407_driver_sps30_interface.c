@@ -40,6 +40,11 @@
 #include "uart.h"
 #include <stdarg.h>
 
+/**
+ * @brief linked clock, NULL for the platform timer
+ */
+static const sps30_interface_clock_t *gs_clock = NULL;    /**< clock handle */
+
 /**
  * @brief  interface iic bus init
  * @return status code
@@ -165,9 +170,73 @@ uint8_t sps30_interface_uart_flush(void)
  */
 void sps30_interface_delay_ms(uint32_t ms)
 {
+    if (gs_clock != NULL)
+    {
+        gs_clock->delay_ms(gs_clock->user, ms);
+        
+        return;
+    }
+    
     delay_ms(ms);
 }
 
+/**
+ * @brief     interface delay us
+ * @param[in] us time
+ * @note      none
+ */
+void sps30_interface_delay_us(uint32_t us)
+{
+    if (gs_clock != NULL)
+    {
+        gs_clock->delay_us(gs_clock->user, us);
+        
+        return;
+    }
+    
+    delay_us(us);
+}
+
+/**
+ * @brief  interface get the current time
+ * @return current time in ms
+ * @note   none
+ */
+uint32_t sps30_interface_now_ms(void)
+{
+    if (gs_clock != NULL)
+    {
+        return gs_clock->now_ms(gs_clock->user);
+    }
+    
+    return HAL_GetTick();
+}
+
+/**
+ * @brief  interface get the current time in us
+ * @return monotonic time in us
+ * @note   the resolution is the 1 ms hal tick
+ */
+uint32_t sps30_interface_now_us(void)
+{
+    if (gs_clock != NULL)
+    {
+        return gs_clock->now_ms(gs_clock->user) * 1000;
+    }
+    
+    return HAL_GetTick() * 1000;
+}
+
+/**
+ * @brief     interface set the time source
+ * @param[in] *clock pointer to a clock structure or NULL
+ * @note      none
+ */
+void sps30_interface_set_clock(const sps30_interface_clock_t *clock)
+{
+    gs_clock = clock;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
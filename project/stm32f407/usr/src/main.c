@@ -235,6 +235,7 @@ uint8_t sps30(uint8_t argc, char **argv)
         /* loop */
         for (i = 0; i < times; i++)
         {
+#if (SPS30_ENABLE_FLOAT == 1)
             sps30_pm_t pm;
             
             /* read data */
@@ -258,6 +259,31 @@ uint8_t sps30(uint8_t argc, char **argv)
             sps30_interface_debug_print("sps30: pm4.0 is %0.2f cm3.\n", pm.pm4p0_cm3);
             sps30_interface_debug_print("sps30: pm10.0 is %0.2f cm3.\n", pm.pm10_cm3);
             sps30_interface_debug_print("sps30: typical is %0.2f um.\n", pm.typical_particle_um);
+#else
+            sps30_pm_u16_t pm;
+            
+            /* read data */
+            res = sps30_basic_read_u16(&pm);
+            if (res != 0)
+            {
+                (void)sps30_basic_deinit();
+                
+                return 1;
+            }
+            
+            /* print */
+            sps30_interface_debug_print("sps30: %d/%d.\n", i + 1, times);
+            sps30_interface_debug_print("sps30: pm1.0 is %d ug/m3.\n", pm.pm1p0_ug_m3);
+            sps30_interface_debug_print("sps30: pm2.5 is %d ug/m3.\n", pm.pm2p5_ug_m3);
+            sps30_interface_debug_print("sps30: pm4.0 is %d ug/m3.\n", pm.pm4p0_ug_m3);
+            sps30_interface_debug_print("sps30: pm10.0 is %d ug/m3.\n", pm.pm10_ug_m3);
+            sps30_interface_debug_print("sps30: pm0.5 is %d cm3.\n", pm.pm0p5_cm3);
+            sps30_interface_debug_print("sps30: pm1.0 is %d cm3.\n", pm.pm1p0_cm3);
+            sps30_interface_debug_print("sps30: pm2.5 is %d cm3.\n", pm.pm2p5_cm3);
+            sps30_interface_debug_print("sps30: pm4.0 is %d cm3.\n", pm.pm4p0_cm3);
+            sps30_interface_debug_print("sps30: pm10.0 is %d cm3.\n", pm.pm10_cm3);
+            sps30_interface_debug_print("sps30: typical is %d nm.\n", pm.typical_particle_nm);
+#endif
             
             /* delay 2000 ms */
             sps30_interface_delay_ms(2000);
@@ -300,7 +326,7 @@ uint8_t sps30(uint8_t argc, char **argv)
     else if (strcmp("e_sn", type) == 0)
     {
         uint8_t res;
-        char sn[9];
+        char sn[17];
         
         /* init */
         res = sps30_basic_init(interface);
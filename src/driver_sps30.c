@@ -81,448 +81,2758 @@
 #define SPS30_UART_COMMAND_READ_VERSION                            0xD1           /**< read version command */
 #define SPS30_UART_COMMAND_READ_DEVICE_STATUS_REG                  0xD2           /**< read device status register command */
 #define SPS30_UART_COMMAND_RESET                                   0xD3           /**< reset command */
+#define SPS30_UART_FRAME_START_MEASUREMENT_IEEE754                 0              /**< start measurement ieee754 frame */
+#define SPS30_UART_FRAME_START_MEASUREMENT_UINT16                  1              /**< start measurement uint16 frame */
+#define SPS30_UART_FRAME_STOP_MEASUREMENT                          2              /**< stop measurement frame */
+#define SPS30_UART_FRAME_READ_MEASURED_VALUES                      3              /**< read measured values frame */
+#define SPS30_UART_FRAME_SLEEP                                     4              /**< sleep frame */
+#define SPS30_UART_FRAME_WAKE_UP                                   5              /**< wake up frame */
+#define SPS30_UART_FRAME_START_FAN_CLEANING                        6              /**< start fan cleaning frame */
+#define SPS30_UART_FRAME_READ_AUTO_CLEANING_INTERVAL               7              /**< read auto cleaning interval frame */
+#define SPS30_UART_FRAME_READ_PRODUCT_TYPE                         8              /**< read product type frame */
+#define SPS30_UART_FRAME_READ_SERIAL_NUMBER                        9              /**< read serial number frame */
+#define SPS30_UART_FRAME_READ_VERSION                              10             /**< read version frame */
+#define SPS30_UART_FRAME_READ_DEVICE_STATUS_REG                    11             /**< read device status register frame */
+#define SPS30_UART_FRAME_CLEAR_DEVICE_STATUS_REG                   12             /**< clear device status register frame */
+#define SPS30_UART_FRAME_RESET                                     13             /**< reset frame */
+#define SPS30_UART_FRAME_NONE                                      0xFF           /**< no fixed frame, built at runtime */
 
+#if (SPS30_ENABLE_IIC == 1)
 /**
- * @brief     generate the crc
+ * @brief crc-8 lookup table, polynomial 0x31
+ */
+static const uint8_t gs_sps30_crc8_table[256] =
+{
+    0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97, 0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E,
+    0x43, 0x72, 0x21, 0x10, 0x87, 0xB6, 0xE5, 0xD4, 0xFA, 0xCB, 0x98, 0xA9, 0x3E, 0x0F, 0x5C, 0x6D,
+    0x86, 0xB7, 0xE4, 0xD5, 0x42, 0x73, 0x20, 0x11, 0x3F, 0x0E, 0x5D, 0x6C, 0xFB, 0xCA, 0x99, 0xA8,
+    0xC5, 0xF4, 0xA7, 0x96, 0x01, 0x30, 0x63, 0x52, 0x7C, 0x4D, 0x1E, 0x2F, 0xB8, 0x89, 0xDA, 0xEB,
+    0x3D, 0x0C, 0x5F, 0x6E, 0xF9, 0xC8, 0x9B, 0xAA, 0x84, 0xB5, 0xE6, 0xD7, 0x40, 0x71, 0x22, 0x13,
+    0x7E, 0x4F, 0x1C, 0x2D, 0xBA, 0x8B, 0xD8, 0xE9, 0xC7, 0xF6, 0xA5, 0x94, 0x03, 0x32, 0x61, 0x50,
+    0xBB, 0x8A, 0xD9, 0xE8, 0x7F, 0x4E, 0x1D, 0x2C, 0x02, 0x33, 0x60, 0x51, 0xC6, 0xF7, 0xA4, 0x95,
+    0xF8, 0xC9, 0x9A, 0xAB, 0x3C, 0x0D, 0x5E, 0x6F, 0x41, 0x70, 0x23, 0x12, 0x85, 0xB4, 0xE7, 0xD6,
+    0x7A, 0x4B, 0x18, 0x29, 0xBE, 0x8F, 0xDC, 0xED, 0xC3, 0xF2, 0xA1, 0x90, 0x07, 0x36, 0x65, 0x54,
+    0x39, 0x08, 0x5B, 0x6A, 0xFD, 0xCC, 0x9F, 0xAE, 0x80, 0xB1, 0xE2, 0xD3, 0x44, 0x75, 0x26, 0x17,
+    0xFC, 0xCD, 0x9E, 0xAF, 0x38, 0x09, 0x5A, 0x6B, 0x45, 0x74, 0x27, 0x16, 0x81, 0xB0, 0xE3, 0xD2,
+    0xBF, 0x8E, 0xDD, 0xEC, 0x7B, 0x4A, 0x19, 0x28, 0x06, 0x37, 0x64, 0x55, 0xC2, 0xF3, 0xA0, 0x91,
+    0x47, 0x76, 0x25, 0x14, 0x83, 0xB2, 0xE1, 0xD0, 0xFE, 0xCF, 0x9C, 0xAD, 0x3A, 0x0B, 0x58, 0x69,
+    0x04, 0x35, 0x66, 0x57, 0xC0, 0xF1, 0xA2, 0x93, 0xBD, 0x8C, 0xDF, 0xEE, 0x79, 0x48, 0x1B, 0x2A,
+    0xC1, 0xF0, 0xA3, 0x92, 0x05, 0x34, 0x67, 0x56, 0x78, 0x49, 0x1A, 0x2B, 0xBC, 0x8D, 0xDE, 0xEF,
+    0x82, 0xB3, 0xE0, 0xD1, 0x46, 0x77, 0x24, 0x15, 0x3B, 0x0A, 0x59, 0x68, 0xFF, 0xCE, 0x9D, 0xAC,
+};
+#endif
+
+/**
+ * @brief command description structure definition
+ */
+typedef struct sps30_command_desc_s
+{
+    uint16_t iic_command;    /**< iic command */
+    uint8_t iic_len;         /**< iic read length, 0 means write only */
+    uint8_t uart_frame;      /**< uart fixed frame index */
+    uint8_t uart_len;        /**< uart response frame length */
+    uint8_t timing;          /**< command timing */
+} sps30_command_desc_t;
+
+/**
+ * @brief command description table, indexed by sps30_async_command_t
+ */
+static const sps30_command_desc_t gs_sps30_command_desc[15] =
+{
+    {SPS30_IIC_COMMAND_READ_MEASURED_VALUES,              0,  SPS30_UART_FRAME_READ_MEASURED_VALUES,              0,  SPS30_TIMING_READ_MEASURED_VALUES},
+    {SPS30_IIC_COMMAND_READ_DATA_READY_FLAG,              3,  SPS30_UART_FRAME_NONE,                              0,  SPS30_TIMING_READ_DATA_READY_FLAG},
+    {SPS30_IIC_COMMAND_START_MEASUREMENT,                 0,  SPS30_UART_FRAME_START_MEASUREMENT_IEEE754,         7,  SPS30_TIMING_START_MEASUREMENT},
+    {SPS30_IIC_COMMAND_STOP_MEASUREMENT,                  0,  SPS30_UART_FRAME_STOP_MEASUREMENT,                  7,  SPS30_TIMING_STOP_MEASUREMENT},
+    {SPS30_IIC_COMMAND_SLEEP,                             0,  SPS30_UART_FRAME_SLEEP,                             7,  SPS30_TIMING_SLEEP},
+    {SPS30_IIC_COMMAND_WAKE_UP,                           0,  SPS30_UART_FRAME_WAKE_UP,                           7,  SPS30_TIMING_WAKE_UP},
+    {SPS30_IIC_COMMAND_START_FAN_CLEANING,                0,  SPS30_UART_FRAME_START_FAN_CLEANING,                7,  SPS30_TIMING_START_FAN_CLEANING},
+    {SPS30_IIC_COMMAND_READ_WRITE_AUTO_CLEANING_INTERVAL, 0,  SPS30_UART_FRAME_NONE,                              7,  SPS30_TIMING_AUTO_CLEANING_INTERVAL},
+    {SPS30_IIC_COMMAND_READ_WRITE_AUTO_CLEANING_INTERVAL, 6,  SPS30_UART_FRAME_READ_AUTO_CLEANING_INTERVAL,       11, SPS30_TIMING_AUTO_CLEANING_INTERVAL},
+    {SPS30_IIC_COMMAND_READ_VERSION,                      3,  SPS30_UART_FRAME_READ_VERSION,                      14, SPS30_TIMING_VERSION},
+    {SPS30_IIC_COMMAND_READ_DEVICE_STATUS_REG,            6,  SPS30_UART_FRAME_READ_DEVICE_STATUS_REG,            12, SPS30_TIMING_DEVICE_STATUS},
+    {SPS30_IIC_COMMAND_CLEAR_DEVICE_STATUS_REG,           0,  SPS30_UART_FRAME_CLEAR_DEVICE_STATUS_REG,           12, SPS30_TIMING_CLEAR_DEVICE_STATUS},
+    {SPS30_IIC_COMMAND_RESET,                             0,  SPS30_UART_FRAME_RESET,                             7,  SPS30_TIMING_RESET},
+    {SPS30_IIC_COMMAND_READ_PRODUCT_TYPE,                 12, SPS30_UART_FRAME_READ_PRODUCT_TYPE,                 16, SPS30_TIMING_PRODUCT_TYPE},
+    {SPS30_IIC_COMMAND_READ_SERIAL_NUMBER,                24, SPS30_UART_FRAME_READ_SERIAL_NUMBER,                24, SPS30_TIMING_SERIAL_NUMBER},
+};
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief uart fixed frame structure definition
+ */
+typedef struct sps30_uart_frame_s
+{
+    uint8_t len;       /**< stuffed frame length */
+    uint8_t buf[8];    /**< stuffed frame */
+} sps30_uart_frame_t;
+
+/**
+ * @brief pre-stuffed uart frames of the fixed commands, indexed by SPS30_UART_FRAME_*
+ */
+static const sps30_uart_frame_t gs_sps30_uart_frame[14] =
+{
+    {8, {0x7E, 0x00, 0x00, 0x02, 0x01, 0x03, 0xF9, 0x7E}},
+    {8, {0x7E, 0x00, 0x00, 0x02, 0x01, 0x05, 0xF7, 0x7E}},
+    {6, {0x7E, 0x00, 0x01, 0x00, 0xFE, 0x7E}},
+    {6, {0x7E, 0x00, 0x03, 0x00, 0xFC, 0x7E}},
+    {6, {0x7E, 0x00, 0x10, 0x00, 0xEF, 0x7E}},
+    {7, {0x7E, 0x00, 0x7D, 0x31, 0x00, 0xEE, 0x7E}},
+    {6, {0x7E, 0x00, 0x56, 0x00, 0xA9, 0x7E}},
+    {8, {0x7E, 0x00, 0x80, 0x01, 0x00, 0x7D, 0x5E, 0x7E}},
+    {7, {0x7E, 0x00, 0xD0, 0x01, 0x00, 0x2E, 0x7E}},
+    {7, {0x7E, 0x00, 0xD0, 0x01, 0x03, 0x2B, 0x7E}},
+    {6, {0x7E, 0x00, 0xD1, 0x00, 0x2E, 0x7E}},
+    {7, {0x7E, 0x00, 0xD2, 0x01, 0x00, 0x2C, 0x7E}},
+    {7, {0x7E, 0x00, 0xD2, 0x01, 0x01, 0x2B, 0x7E}},
+    {6, {0x7E, 0x00, 0xD3, 0x00, 0x2C, 0x7E}},
+};
+#endif
+
+/**
+ * @brief default timing table in us, indexed by sps30_timing_t
+ */
+static const uint32_t gs_sps30_timing_default[SPS30_TIMING_MAX] =
+{
+    20000, 20000, 20000, 20000, 5000, 100000, 20000, 20000,
+    20000, 20000, 20000, 20000, 20000, 100000, 20000,
+};
+
+/**
+ * @brief     count a bus transaction
  * @param[in] *handle pointer to an sps30 handle structure
- * @param[in] *data pointer to a data buffer
- * @param[in] count data length
- * @return    crc
+ * @param[in] res bus function result
+ * @param[in] tx written bytes
+ * @param[in] rx read bytes
  * @note      none
  */
-static uint8_t a_sps30_generate_crc(sps30_handle_t *handle, uint8_t* data, uint8_t count) 
+static void a_sps30_stats_bus(sps30_handle_t *handle, uint8_t res, uint16_t tx, uint16_t rx)
 {
-    if (handle->iic_uart == SPS30_INTERFACE_IIC)
+#if (SPS30_ENABLE_STATS == 1)
+    if (res != 0)                                     /* check result */
     {
-        uint8_t current_byte;
-        uint8_t crc = 0xFF;
-        uint8_t crc_bit;
-
-        for (current_byte = 0; current_byte < count; ++current_byte)        /* calculate crc */
-        {
-            crc ^= (data[current_byte]);                                    /* xor data */
-            for (crc_bit = 8; crc_bit > 0; --crc_bit)                       /* 8 bit */
-            {
-                if ((crc & 0x80) != 0)                                      /* if 7th bit is 1 */
-                {
-                    crc = (crc << 1) ^ 0x31;                                /* xor */
-                }
-                else
-                {
-                    crc = crc << 1;                                         /* left shift 1 */
-                }
-            }
-        }
+        handle->stats.bus_error++;                    /* count the bus error */
         
-        return crc;                                                         /* return crc */
+        return;                                       /* return */
     }
-    else
+    handle->stats.transaction++;                      /* count the transaction */
+    handle->stats.tx_bytes += tx;                     /* count the written bytes */
+    handle->stats.rx_bytes += rx;                     /* count the read bytes */
+#else
+    (void)handle;
+    (void)res;
+    (void)tx;
+    (void)rx;
+#endif
+}
+
+/**
+ * @brief      get the linked clock time
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no clock is linked
+ * @note       now_us is in the handle only with the trace or the stats enabled,
+ *             the static port has sps30_port_now_us with SPS30_STATIC_PORT_CLOCK 1
+ */
+static uint8_t a_sps30_clock_us(sps30_handle_t *handle, uint32_t *us)
+{
+#if (SPS30_STATIC_PORT == 1) && (SPS30_STATIC_PORT_CLOCK == 1)
+    *us = sps30_port_now_us(handle->user);                 /* run the port function */
+    
+    return 0;                                              /* success return 0 */
+#elif (SPS30_STATIC_PORT != 1) && ((SPS30_ENABLE_TRACE == 1) || (SPS30_ENABLE_STATS == 1))
+    if (handle->now_us_ctx != NULL)                        /* check now_us_ctx */
     {
-        uint8_t i;
-        uint32_t crc = 0x00;
+        *us = handle->now_us_ctx(handle->user);            /* run with the user context */
         
-        for (i = 0; i < count; i++)                                         /* sum */
-        {
-            crc += data[i];                                                 /* sum */
-        }
+        return 0;                                          /* success return 0 */
+    }
+    if (handle->now_us != NULL)                            /* check now_us */
+    {
+        *us = handle->now_us();                            /* run without the user context */
         
-        return (uint8_t)(~(crc & 0xFF));                                    /* take the least significant byte of the result and invert it */
+        return 0;                                          /* success return 0 */
     }
+    
+    return 1;                                              /* no clock */
+#else
+    (void)handle;                                          /* no clock in this build */
+    (void)us;                                              /* no clock in this build */
+    
+    return 1;                                              /* no clock */
+#endif
 }
 
+#if (SPS30_ENABLE_TRACE == 1) || (SPS30_ENABLE_STATS == 1)
 /**
- * @brief      read bytes
- * @param[in]  *handle pointer to an sps30 handle structure
- * @param[in]  addr iic device address
- * @param[in]  reg iic register address
- * @param[out] *data pointer to a data buffer
- * @param[in]  len data length
- * @param[in]  delay_ms delay time in ms
- * @return     status code
- *             - 0 success
- *             - 1 read failed
- * @note       none
+ * @brief     get the driver time
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @return    time in us
+ * @note      the linked now_us clock, else the delay time spent by the driver since sps30_init,
+ *            the value wraps around, only the differences are used
  */
-static uint8_t a_sps30_iic_read(sps30_handle_t *handle, uint8_t addr, uint16_t reg, uint8_t *data, uint16_t len, uint16_t delay_ms)
+static uint32_t a_sps30_time_us(sps30_handle_t *handle)
 {
-    uint8_t buf[2];
+    uint32_t us;
     
-    buf[0] = (reg >> 8) & 0xFF;                                  /* set msb */
-    buf[1] = (reg >> 0) & 0xFF;                                  /* set lsb */
-    if (handle->iic_write_cmd(addr, (uint8_t *)buf, 2) != 0)     /* write data */
+    if (a_sps30_clock_us(handle, &us) == 0)                /* check the clock */
     {
-        return 1;                                                /* return error */
+        return us;                                         /* return the clock time */
     }
-    handle->delay_ms(delay_ms);                                  /* delay ms */
-    if (handle->iic_read_cmd(addr, (uint8_t *)data, len) != 0)   /* read data */
+    
+    return handle->delay_time_us;                          /* return the delay time */
+}
+#endif
+
+/**
+ * @brief     trace a bus transaction
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] type trace type
+ * @param[in] *buf pointer to the transaction bytes
+ * @param[in] len transaction length
+ * @param[in] res transaction result
+ * @note      none
+ */
+static void a_sps30_trace(sps30_handle_t *handle, uint8_t type, uint8_t *buf, uint16_t len, uint8_t res)
+{
+#if (SPS30_ENABLE_TRACE == 1)
+#if (SPS30_STATIC_PORT == 1)
+    sps30_port_trace(handle->user, type, buf, len, res, a_sps30_time_us(handle));          /* run the port function */
+#else
+    if (handle->trace != NULL)                                                             /* check trace */
     {
-        return 1;                                                /* return error */
+        handle->trace(handle->user, type, buf, len, res, a_sps30_time_us(handle));         /* run the trace function */
     }
+#endif
+#else
+    (void)handle;
+    (void)type;
+    (void)buf;
+    (void)len;
+    (void)res;
+#endif
+}
+
+/**
+ * @brief     count the delay time
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] ms delay time in ms
+ * @param[in] us delay time in us
+ * @note      none
+ */
+static void a_sps30_stats_delay(sps30_handle_t *handle, uint32_t ms, uint32_t us)
+{
+#if (SPS30_ENABLE_STATS == 1)
+    handle->stats.delay_us += us;                                  /* add the us */
+    handle->stats.delay_ms += ms + handle->stats.delay_us / 1000;  /* add the ms and the us carry */
+    handle->stats.delay_us %= 1000;                                /* keep the remainder */
+#else
+    (void)handle;
+    (void)ms;
+    (void)us;
+#endif
+}
+
+/**
+ * @brief     count a crc error
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @note      none
+ */
+static void a_sps30_stats_crc(sps30_handle_t *handle)
+{
+#if (SPS30_ENABLE_STATS == 1)
+    handle->stats.crc_error++;        /* count the crc error */
+#else
+    (void)handle;
+#endif
+}
+
+#if (SPS30_ENABLE_STATS == 1)
+/**
+ * @brief     count a finished command
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] timing command timing
+ * @param[in] res command result
+ * @param[in] ms command latency in ms
+ * @note      a not ready result is counted without latency
+ */
+static void a_sps30_stats_command(sps30_handle_t *handle, uint8_t timing, uint8_t res, uint32_t ms)
+{
+    uint8_t n;
     
-    return 0;                                                    /* success return 0 */
+    handle->stats.command[timing]++;                                         /* count the command */
+    if (res == 1)                                                            /* failed */
+    {
+        handle->stats.command_error[timing]++;                               /* count the error */
+    }
+    if (res != 0)                                                            /* no latency */
+    {
+        return;                                                              /* return */
+    }
+    for (n = 0; (n < SPS30_STATS_BUCKET_NUM - 1) && (ms != 0); n++)          /* find the log2 bucket */
+    {
+        ms >>= 1;                                                            /* next power of 2 */
+    }
+    if (timing == SPS30_TIMING_READ_MEASURED_VALUES)                         /* read */
+    {
+        handle->stats.read_latency[n]++;                                     /* count the read latency */
+    }
+    else
+    {
+        handle->stats.command_latency[n]++;                                  /* count the command latency */
+    }
 }
+#endif
 
 /**
- * @brief     write bytes
+ * @brief     count a finished async command
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] now_ms current time in ms
+ * @param[in] res command result
+ * @note      the latency is the now_ms span since the command began
+ */
+static void a_sps30_stats_async(sps30_handle_t *handle, uint32_t now_ms, uint8_t res)
+{
+#if (SPS30_ENABLE_STATS == 1)
+    a_sps30_stats_command(handle, gs_sps30_command_desc[handle->async_command].timing, res,
+                          (uint32_t)(now_ms - handle->stats_begin_ms));                      /* count the command */
+#else
+    (void)handle;
+    (void)now_ms;
+    (void)res;
+#endif
+}
+
+#if (SPS30_ENABLE_IIC == 1)
+/**
+ * @brief     call the linked iic_init function
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      none
+ */
+static uint8_t a_sps30_link_iic_init(sps30_handle_t *handle)
+{
+#if (SPS30_STATIC_PORT == 1)
+    return sps30_port_iic_init(handle->user);              /* run the port function */
+#else
+    if (handle->iic_init_ctx != NULL)                      /* check iic_init_ctx */
+    {
+        return handle->iic_init_ctx(handle->user);         /* run with the user context */
+    }
+    
+    return handle->iic_init();                             /* run without the user context */
+#endif
+}
+
+/**
+ * @brief     call the linked iic_deinit function
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
+ */
+static uint8_t a_sps30_link_iic_deinit(sps30_handle_t *handle)
+{
+#if (SPS30_STATIC_PORT == 1)
+    return sps30_port_iic_deinit(handle->user);            /* run the port function */
+#else
+    if (handle->iic_deinit_ctx != NULL)                    /* check iic_deinit_ctx */
+    {
+        return handle->iic_deinit_ctx(handle->user);       /* run with the user context */
+    }
+    
+    return handle->iic_deinit();                           /* run without the user context */
+#endif
+}
+
+/**
+ * @brief     call the linked iic_write_cmd function
  * @param[in] *handle pointer to an sps30 handle structure
  * @param[in] addr iic device address
- * @param[in] reg iic register address
- * @param[in] *data pointer to a data buffer
+ * @param[in] *buf pointer to a data buffer
  * @param[in] len data length
- * @param[in] delay_ms delay time in ms
  * @return    status code
  *            - 0 success
  *            - 1 write failed
  * @note      none
  */
-static uint8_t a_sps30_iic_write(sps30_handle_t *handle, uint8_t addr, uint16_t reg, uint8_t *data, uint16_t len, uint16_t delay_ms)
+static uint8_t a_sps30_link_iic_write_cmd(sps30_handle_t *handle, uint8_t addr, uint8_t *buf, uint16_t len)
 {
-    uint8_t buf[16];
+    uint8_t res;
     
-    if (len > 14)                                                    /* check length */
+#if (SPS30_STATIC_PORT == 1)
+    res = sps30_port_iic_write_cmd(handle->user, addr, buf, len);               /* run the port function */
+#else
+    if (handle->iic_write_cmd_ctx != NULL)                                      /* check iic_write_cmd_ctx */
     {
-        return 1;                                                    /* return error */
+        res = handle->iic_write_cmd_ctx(handle->user, addr, buf, len);          /* run with the user context */
     }
-    buf[0] = (reg >> 8) & 0xFF;                                      /* set msb */
-    buf[1] = (reg >> 0) & 0xFF;                                      /* set lsb */
-    memcpy((uint8_t *)&buf[2], data, len);                           /* copy data */
-    if (handle->iic_write_cmd(addr, (uint8_t *)buf, len + 2) != 0)   /* write data */
+    else
     {
-        return 1;                                                    /* return error */
+        res = handle->iic_write_cmd(addr, buf, len);                            /* run without the user context */
     }
-    handle->delay_ms(delay_ms);                                      /* delay ms */
+#endif
+    a_sps30_stats_bus(handle, res, len, 0);                                     /* count the transaction */
+    a_sps30_trace(handle, SPS30_TRACE_IIC_WRITE, buf, len, res);                /* trace the transaction */
     
-    return 0;                                                        /* success return 0 */
+    return res;                                                                 /* return the result */
 }
 
 /**
- * @brief      uart get the rx frame
+ * @brief      call the linked iic_read_cmd function
  * @param[in]  *handle pointer to an sps30 handle structure
- * @param[in]  len buffer length
- * @param[out] *output pointer to an output buffer
- * @param[in]  out_len output length
+ * @param[in]  addr iic device address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
  * @return     status code
  *             - 0 success
- *             - 1 uart get rx frame failed
+ *             - 1 read failed
  * @note       none
  */
-static uint8_t a_sps30_uart_get_rx_frame(sps30_handle_t *handle, uint16_t len, uint8_t *output, uint16_t out_len)
+static uint8_t a_sps30_link_iic_read_cmd(sps30_handle_t *handle, uint8_t addr, uint8_t *buf, uint16_t len)
 {
-    uint16_t i, point;
+    uint8_t res;
     
-    output[0] = handle->buf[0];                                                                          /* set buf[0] */
-    point = 1;                                                                                           /* set point 1 */
-    for (i = 1; i < (len - 1); i++)                                                                      /* run n -2 times */
+#if (SPS30_STATIC_PORT == 1)
+    res = sps30_port_iic_read_cmd(handle->user, addr, buf, len);                /* run the port function */
+#else
+    if (handle->iic_read_cmd_ctx != NULL)                                       /* check iic_read_cmd_ctx */
     {
-        if (point >= (out_len - 1))                                                                      /* check length */
-        {
-            return 1;                                                                                    /* return error */
-        }
-        if (((handle->buf[i] == 0x7D) && (handle->buf[i + 1]) == 0x5E) ||                                /* check buffer */
-            ((handle->buf[i] == 0x7D) && (handle->buf[i + 1]) == 0x5D) ||
-            ((handle->buf[i] == 0x7D) && (handle->buf[i + 1]) == 0x31) ||
-            ((handle->buf[i] == 0x7D) && (handle->buf[i + 1]) == 0x33)
-           )
-        {
-            switch (handle->buf[i + 1])                                                                  /* judge */
-            {
-                case 0x5E :                                                                              /* 0x5E */
-                {
-                    output[point] = 0x7E;                                                                /* set output */
-                    point++;                                                                             /* point++ */
-                    i++;                                                                                 /* i++ */
-                    
-                    break;                                                                               /* break */
-                }
-                case 0x5D :                                                                              /* 0x5D */
-                {
-                    output[point] = 0x7D;                                                                /* set output */
-                    point++;                                                                             /* point++ */
-                    i++;                                                                                 /* i++ */
-                    
-                    break;                                                                               /* break */
-                }
-                case 0x31 :                                                                              /* 0x31 */
-                {
-                    output[point] = 0x11;                                                                /* set output */
-                    point++;                                                                             /* point++ */
-                    i++;                                                                                 /* i++ */
-                    
-                    break;                                                                               /* break */
-                }
-                case 0x33 :                                                                              /* 0x33 */
-                {
-                    output[point] = 0x13;                                                                /* set output */
-                    point++;                                                                             /* point++ */
-                    i++;                                                                                 /* i++ */
-                    
-                    break;                                                                               /* break */
-                }
-                default :
-                {
-                    break;                                                                               /* break */
-                }
-            }
-        }
-        else
-        {
-            output[point] = handle->buf[i];                                                              /* set output */
-            point++;                                                                                     /* point++ */
-        }
+        res = handle->iic_read_cmd_ctx(handle->user, addr, buf, len);           /* run with the user context */
     }
-    output[point] = handle->buf[len - 1];                                                                /* set the end part */
-    point++;                                                                                             /* point++ */
-    if (point != out_len)                                                                                /* check point */
+    else
     {
-        return 1;                                                                                        /* return error */
+        res = handle->iic_read_cmd(addr, buf, len);                             /* run without the user context */
     }
+#endif
+    a_sps30_stats_bus(handle, res, 0, len);                                     /* count the transaction */
+    a_sps30_trace(handle, SPS30_TRACE_IIC_READ, buf, len, res);                 /* trace the transaction */
     
-    return 0;                                                                                            /* success return 0 */
+    return res;                                                                 /* return the result */
 }
+#endif
 
+#if (SPS30_ENABLE_UART == 1)
 /**
- * @brief      uart set the tx frame
- * @param[in]  *handle pointer to an sps30 handle structure
- * @param[in]  *input pointer to an input buffer
- * @param[in]  in_len input length
- * @param[out] *out_len pointer to an output length buffer
- * @return     status code
- *             - 0 success
- *             - 1 uart set tx frame failed
- * @note       none
+ * @brief     call the linked uart_init function
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart init failed
+ * @note      none
  */
-static uint8_t a_sps30_uart_set_tx_frame(sps30_handle_t *handle, uint8_t *input, uint16_t in_len, uint16_t *out_len)
+static uint8_t a_sps30_link_uart_init(sps30_handle_t *handle)
 {
-    uint16_t i;
+#if (SPS30_STATIC_PORT == 1)
+    return sps30_port_uart_init(handle->user);             /* run the port function */
+#else
+    if (handle->uart_init_ctx != NULL)                     /* check uart_init_ctx */
+    {
+        return handle->uart_init_ctx(handle->user);        /* run with the user context */
+    }
     
-    memset(handle->buf, 0, sizeof(uint8_t) * 256);                                                            /* clear buffer */
-    handle->buf[0] = input[0];                                                                                /* set buf[0] */
-    *out_len = 1;                                                                                             /* set output length */
-    for (i = 1; i < (in_len - 1); i++)
+    return handle->uart_init();                            /* run without the user context */
+#endif
+}
+
+/**
+ * @brief     call the linked uart_deinit function
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart deinit failed
+ * @note      none
+ */
+static uint8_t a_sps30_link_uart_deinit(sps30_handle_t *handle)
+{
+#if (SPS30_STATIC_PORT == 1)
+    return sps30_port_uart_deinit(handle->user);           /* run the port function */
+#else
+    if (handle->uart_deinit_ctx != NULL)                   /* check uart_deinit_ctx */
     {
-        if ((*out_len) >= 255)                                                                                /* check output length */
-        {
-            return 1;                                                                                         /* return error */
-        }
-        if ((input[i] == 0x7E) || (input[i] == 0x7D) ||                                                       /* check data */
-            (input[i] == 0x11) || (input[i] == 0x13)
-           )
-        {
-            switch (input[i])                                                                                 /* judge input */
-            {
-                case 0x7E :                                                                                   /* 0x7E */
-                {
-                    handle->buf[*out_len] = 0x7D;                                                             /* 0x7D */
-                    (*out_len)++;                                                                             /* output length++ */
-                    handle->buf[*out_len] = 0x5E;                                                             /* 0x5E */
-                    (*out_len)++;                                                                             /* output length++ */
-                    
-                    break;                                                                                    /* break */
-                }
-                case 0x7D :                                                                                   /* 0x7D */
-                {
-                    handle->buf[*out_len] = 0x7D;                                                             /* set 0x7D */
-                    (*out_len)++;                                                                             /* output length++ */
-                    handle->buf[*out_len] = 0x5D;                                                             /* set 0x5D */
-                    (*out_len)++;                                                                             /* output length++ */
-                    
-                    break;                                                                                    /* break */
-                }
-                case 0x11 :                                                                                   /* 0x11 */
-                {
-                    handle->buf[*out_len] = 0x7D;                                                             /* set 0x7D */
-                    (*out_len)++;                                                                             /* output length++ */
-                    handle->buf[*out_len] = 0x31;                                                             /* set 0x31 */
-                    (*out_len)++;                                                                             /* output length++ */
-                    
-                    break;                                                                                    /* break */
-                }
-                case 0x13 :                                                                                   /* 0x13 */
-                {
-                    handle->buf[*out_len] = 0x7D;                                                             /* set 0x7D */
-                    (*out_len)++;                                                                             /* output length++ */
-                    handle->buf[*out_len] = 0x33;                                                             /* set 0x33 */
-                    (*out_len)++;                                                                             /* output length++ */
-                    
-                    break;                                                                                    /* break */
-                }
-                default :
-                {
-                    break;                                                                                    /* break */
-                }
-            }
-        }
-        else
-        {
-            handle->buf[*out_len] = input[i];                                                                 /* set the buffer */
-            (*out_len)++;                                                                                     /* output length++ */
-        }
+        return handle->uart_deinit_ctx(handle->user);      /* run with the user context */
     }
-    handle->buf[*out_len] = input[in_len - 1];
-    (*out_len)++;                                                                                             /* copy the end frame */
     
-    return 0;                                                                                                 /* success return 0 */
+    return handle->uart_deinit();                          /* run without the user context */
+#endif
 }
 
 /**
- * @brief      write read bytes
+ * @brief      call the linked uart_read function
  * @param[in]  *handle pointer to an sps30 handle structure
- * @param[in]  *input pointer to an input buffer
- * @param[in]  in_len input length
- * @param[in]  delay_ms delay time in ms
- * @param[out] *output pointer to an output buffer
- * @param[in]  out_len output length
- * @return     status code
- *             - 0 success
- *             - 1 write read failed
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     read length
  * @note       none
  */
-static uint8_t a_sps30_uart_write_read(sps30_handle_t *handle, uint8_t *input, uint16_t in_len,
-                                       uint16_t delay_ms, uint8_t *output, uint16_t out_len)
+static uint16_t a_sps30_link_uart_read(sps30_handle_t *handle, uint8_t *buf, uint16_t len)
 {
-    uint16_t len;
+    uint16_t res;
     
-    if (a_sps30_uart_set_tx_frame(handle, input, in_len, (uint16_t *)&len) != 0)  /* set tx frame */
-    {
-        return 1;                                                                 /* return error */
-    }
-    if (handle->uart_flush() != 0)                                                /* uart flush */
+#if (SPS30_STATIC_PORT == 1)
+    res = sps30_port_uart_read(handle->user, buf, len);                         /* run the port function */
+#else
+    if (handle->uart_read_ctx != NULL)                                          /* check uart_read_ctx */
     {
-        return 1;                                                                 /* return error */
+        res = handle->uart_read_ctx(handle->user, buf, len);                    /* run with the user context */
     }
-    if (handle->uart_write(handle->buf, len) != 0)                                /* write data */
+    else
     {
-        return 1;                                                                 /* return error */
+        res = handle->uart_read(buf, len);                                      /* run without the user context */
     }
-    handle->delay_ms(delay_ms);                                                   /* delay ms */
-    len = handle->uart_read(handle->buf, 256);                                    /* read data */
-    if (a_sps30_uart_get_rx_frame(handle, len, output, out_len) != 0)             /* get rx frame */
+#endif
+    if (res != 0)                                                               /* check the read length */
     {
-        return 1;                                                                 /* return error */
+        a_sps30_stats_bus(handle, 0, 0, res);                                   /* count the transaction */
+        a_sps30_trace(handle, SPS30_TRACE_UART_READ, buf, res, 0);              /* trace the transaction */
     }
     
-    return 0;                                                                     /* success return 0 */
+    return res;                                                                 /* return the read length */
 }
 
 /**
- * @brief     print error
+ * @brief     call the linked uart_write function
  * @param[in] *handle pointer to an sps30 handle structure
- * @param[in] e error code
- * @return    error code
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
  * @note      none
  */
-static uint8_t a_sps30_uart_error(sps30_handle_t *handle, uint8_t e)
+static uint8_t a_sps30_link_uart_write(sps30_handle_t *handle, uint8_t *buf, uint16_t len)
 {
-    switch (e)
+    uint8_t res;
+    
+#if (SPS30_STATIC_PORT == 1)
+    res = sps30_port_uart_write(handle->user, buf, len);                        /* run the port function */
+#else
+    if (handle->uart_write_ctx != NULL)                                         /* check uart_write_ctx */
     {
-        case 0x00 :
+        res = handle->uart_write_ctx(handle->user, buf, len);                   /* run with the user context */
+    }
+    else
+    {
+        res = handle->uart_write(buf, len);                                     /* run without the user context */
+    }
+#endif
+    a_sps30_stats_bus(handle, res, len, 0);                                     /* count the transaction */
+    a_sps30_trace(handle, SPS30_TRACE_UART_WRITE, buf, len, res);               /* trace the transaction */
+    
+    return res;                                                                 /* return the result */
+}
+
+/**
+ * @brief     call the linked uart_flush function
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart flush failed
+ * @note      none
+ */
+static uint8_t a_sps30_link_uart_flush(sps30_handle_t *handle)
+{
+#if (SPS30_STATIC_PORT == 1)
+    return sps30_port_uart_flush(handle->user);            /* run the port function */
+#else
+    if (handle->uart_flush_ctx != NULL)                    /* check uart_flush_ctx */
+    {
+        return handle->uart_flush_ctx(handle->user);       /* run with the user context */
+    }
+    
+    return handle->uart_flush();                           /* run without the user context */
+#endif
+}
+#endif
+
+/**
+ * @brief     call the linked delay_ms function
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_sps30_link_delay_ms(sps30_handle_t *handle, uint32_t ms)
+{
+#if (SPS30_STATIC_PORT == 1)
+    sps30_port_delay_ms(handle->user, ms);                 /* run the port function */
+#else
+    if (handle->delay_ms_ctx != NULL)                      /* check delay_ms_ctx */
+    {
+        handle->delay_ms_ctx(handle->user, ms);            /* run with the user context */
+    }
+    else
+    {
+        handle->delay_ms(ms);                              /* run without the user context */
+    }
+#endif
+    a_sps30_stats_delay(handle, ms, 0);                    /* count the delay time */
+#if (SPS30_ENABLE_TRACE == 1) || (SPS30_ENABLE_STATS == 1)
+    handle->delay_time_us += ms * 1000;                    /* advance the delay time */
+#endif
+}
+
+/**
+ * @brief     call the linked delay_us function
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] us time
+ * @note      none
+ */
+static void a_sps30_link_delay_us(sps30_handle_t *handle, uint32_t us)
+{
+#if (SPS30_STATIC_PORT == 1)
+    sps30_port_delay_us(handle->user, us);                 /* run the port function */
+#else
+    if (handle->delay_us_ctx != NULL)                      /* check delay_us_ctx */
+    {
+        handle->delay_us_ctx(handle->user, us);            /* run with the user context */
+    }
+    else
+    {
+        handle->delay_us(us);                              /* run without the user context */
+    }
+#endif
+    a_sps30_stats_delay(handle, 0, us);                    /* count the delay time */
+#if (SPS30_ENABLE_TRACE == 1) || (SPS30_ENABLE_STATS == 1)
+    handle->delay_time_us += us;                           /* advance the delay time */
+#endif
+}
+
+/**
+ * @brief     get the command timing in ms
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] timing command timing
+ * @return    delay time in ms
+ * @note      the time is rounded up to the next ms
+ */
+static uint16_t a_sps30_timing_ms(sps30_handle_t *handle, uint8_t timing)
+{
+    return (uint16_t)((handle->timing_us[timing] + 999) / 1000);        /* round up to ms */
+}
+
+/**
+ * @brief     wait the command timing
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] timing command timing
+ * @note      when delay_us is linked the whole ms run with delay_ms and
+ *            only the remainder runs with delay_us, else it is rounded up to ms
+ */
+static void a_sps30_delay_timing(sps30_handle_t *handle, uint8_t timing)
+{
+    uint32_t us;
+    
+    us = handle->timing_us[timing];                                        /* get the delay */
+#if (SPS30_STATIC_PORT != 1)
+    if ((handle->delay_us == NULL) && (handle->delay_us_ctx == NULL))      /* no delay_us */
+    {
+        us = (us + 999) / 1000 * 1000;                                     /* round up to ms */
+    }
+#endif
+    if (us >= 1000)                                                        /* check the whole ms */
+    {
+        a_sps30_link_delay_ms(handle, us / 1000);                          /* delay ms */
+    }
+    if ((us % 1000) != 0)                                                  /* check the remainder */
+    {
+        a_sps30_link_delay_us(handle, us % 1000);                          /* delay us */
+    }
+}
+
+#if (SPS30_ENABLE_IIC == 1)
+/**
+ * @brief     calculate the iic crc
+ * @param[in] *data pointer to a data buffer
+ * @param[in] count data length
+ * @return    crc
+ * @note      crc-8 with polynomial 0x31 and init 0xFF, one table lookup per byte
+ */
+static uint8_t a_sps30_iic_crc(uint8_t *data, uint16_t count) 
+{
+    uint16_t i;
+    uint8_t crc = 0xFF;
+    
+    for (i = 0; i < count; i++)                                 /* calculate crc */
+    {
+        crc = gs_sps30_crc8_table[crc ^ data[i]];               /* look up the table */
+    }
+    
+    return crc;                                                 /* return crc */
+}
+#endif
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief     calculate the uart checksum
+ * @param[in] *data pointer to a data buffer
+ * @param[in] count data length
+ * @return    checksum
+ * @note      none
+ */
+static uint8_t a_sps30_uart_checksum(uint8_t *data, uint16_t count) 
+{
+    uint16_t i;
+    uint32_t sum = 0x00;
+    
+    for (i = 0; i < count; i++)                                 /* sum */
+    {
+        sum += data[i];                                         /* sum */
+    }
+    
+    return (uint8_t)(~(sum & 0xFF));                            /* take the least significant byte of the result and invert it */
+}
+#endif
+
+#if (SPS30_ENABLE_IIC == 1)
+/**
+ * @brief     send a command
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] addr iic device address
+ * @param[in] reg iic register address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      none
+ */
+static uint8_t a_sps30_iic_send(sps30_handle_t *handle, uint8_t addr, uint16_t reg, uint8_t *data, uint16_t len)
+{
+    uint8_t buf[16];
+    
+    if (len > 14)                                                                  /* check length */
+    {
+        return 1;                                                                  /* return error */
+    }
+    buf[0] = (reg >> 8) & 0xFF;                                                    /* set msb */
+    buf[1] = (reg >> 0) & 0xFF;                                                    /* set lsb */
+    if (len != 0)                                                                  /* check length */
+    {
+        memcpy((uint8_t *)&buf[2], data, len);                                     /* copy data */
+    }
+    if (a_sps30_link_iic_write_cmd(handle, addr, (uint8_t *)buf, len + 2) != 0)    /* write data */
+    {
+        return 1;                                                                  /* return error */
+    }
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      read bytes
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  addr iic device address
+ * @param[in]  reg iic register address
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len data length
+ * @param[in]  timing command timing
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_sps30_iic_read(sps30_handle_t *handle, uint8_t addr, uint16_t reg, uint8_t *data, uint16_t len, uint8_t timing)
+{
+    if (a_sps30_iic_send(handle, addr, reg, NULL, 0) != 0)                     /* write command */
+    {
+        return 1;                                                              /* return error */
+    }
+    a_sps30_delay_timing(handle, timing);                                      /* wait the command timing */
+    if (a_sps30_link_iic_read_cmd(handle, addr, (uint8_t *)data, len) != 0)    /* read data */
+    {
+        return 1;                                                              /* return error */
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     write bytes
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] addr iic device address
+ * @param[in] reg iic register address
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @param[in] timing command timing
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_sps30_iic_write(sps30_handle_t *handle, uint8_t addr, uint16_t reg, uint8_t *data, uint16_t len, uint8_t timing)
+{
+    if (a_sps30_iic_send(handle, addr, reg, data, len) != 0)       /* write command */
+    {
+        return 1;                                                  /* return error */
+    }
+    a_sps30_delay_timing(handle, timing);                          /* wait the command timing */
+    
+    return 0;                                                      /* success return 0 */
+}
+#endif
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief      uart unstuff a frame
+ * @param[in]  *input pointer to a stuffed frame buffer
+ * @param[in]  in_len stuffed frame length
+ * @param[out] *output pointer to an output buffer
+ * @param[in]  out_size output buffer size
+ * @param[out] *out_len pointer to an output length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 uart unstuff failed
+ * @note       the bytes between two escapes are copied as one run
+ */
+static uint8_t a_sps30_uart_unstuff(uint8_t *input, uint16_t in_len, uint8_t *output, uint16_t out_size, uint16_t *out_len)
+{
+    uint8_t *p;
+    uint8_t *end;
+    uint8_t *esc;
+    uint16_t run;
+    uint16_t point;
+    
+    if ((in_len < 2) || (out_size < 2))                                                 /* check length */
+    {
+        return 1;                                                                       /* return error */
+    }
+    output[0] = input[0];                                                               /* set the start */
+    point = 1;                                                                          /* set point 1 */
+    p = &input[1];                                                                      /* skip the start */
+    end = &input[in_len - 1];                                                           /* stop before the end */
+    while (p < end)                                                                     /* run to the end */
+    {
+        esc = (uint8_t *)memchr(p, 0x7D, (size_t)(end - p));                            /* find the next escape */
+        run = (uint16_t)((esc == NULL) ? (end - p) : (esc - p));                        /* get the run length */
+        if ((point + run) >= out_size)                                                  /* check length */
         {
-            break;
+            return 1;                                                                   /* return error */
         }
-        case 0x01 :
+        memcpy(&output[point], p, run);                                                 /* copy the run */
+        point += run;                                                                   /* point += run */
+        p += run;                                                                       /* p += run */
+        if (esc == NULL)                                                                /* no more escape */
         {
-            handle->debug_print("sps30: wrong data length for this command error.\n");        /* wrong data length for this command error */
-            
-            break;
+            break;                                                                      /* break */
         }
-        case 0x02 :
+        if ((point + 1) >= out_size)                                                    /* check length */
         {
-            handle->debug_print("sps30: unknown command.\n");                                 /* unknown command */
-            
-            break;
+            return 1;                                                                   /* return error */
         }
-        case 0x03 :
+        if ((p[1] == 0x5E) || (p[1] == 0x5D) || (p[1] == 0x31) || (p[1] == 0x33))       /* check the escaped byte */
         {
-            handle->debug_print("sps30: no access right for command.\n");                     /* no access right for command */
-            
-            break;
+            output[point] = p[1] ^ 0x20;                                                /* restore the byte */
+            p += 2;                                                                     /* skip the pair */
         }
-        case 0x04 :
+        else
         {
-            handle->debug_print("sps30: illegal command parameter or parameter "
-                                "out of allowed range.\n");                                   /* illegal command parameter or parameter out of allowed range */
-            
-            break;
+            output[point] = p[0];                                                       /* keep the byte */
+            p += 1;                                                                     /* skip the byte */
         }
-        case 0x28 :
+        point++;                                                                        /* point++ */
+    }
+    output[point] = input[in_len - 1];                                                  /* set the end */
+    point++;                                                                            /* point++ */
+    *out_len = point;                                                                   /* set the output length */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      uart stuff a frame
+ * @param[in]  *input pointer to a frame buffer
+ * @param[in]  in_len frame length
+ * @param[out] *output pointer to an output buffer
+ * @param[in]  out_size output buffer size
+ * @param[out] *out_len pointer to an output length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 uart stuff failed
+ * @note       none
+ */
+static uint8_t a_sps30_uart_stuff(uint8_t *input, uint16_t in_len, uint8_t *output, uint16_t out_size, uint16_t *out_len)
+{
+    uint8_t c;
+    uint16_t i;
+    uint16_t point;
+    
+    if ((in_len < 2) || (out_size < in_len))                                            /* check length */
+    {
+        return 1;                                                                       /* return error */
+    }
+    output[0] = input[0];                                                               /* set the start */
+    point = 1;                                                                          /* set point 1 */
+    for (i = 1; i < (in_len - 1); i++)                                                  /* stuff the data */
+    {
+        c = input[i];                                                                   /* get the byte */
+        if ((c == 0x7E) || (c == 0x7D) || (c == 0x11) || (c == 0x13))                   /* check the reserved byte */
         {
-            handle->debug_print("sps30: internal function argument out of range.\n");         /* internal function argument out of range */
-            
-            break;
+            if ((point + 2) >= out_size)                                                /* check length */
+            {
+                return 1;                                                               /* return error */
+            }
+            output[point] = 0x7D;                                                       /* set the escape */
+            output[point + 1] = c ^ 0x20;                                               /* set the escaped byte */
+            point += 2;                                                                 /* point += 2 */
         }
-        case 0x43 :
+        else
         {
-            handle->debug_print("sps30: command not allowed in current state.\n");            /* command not allowed in current state */
-            
-            break;
+            if ((point + 1) >= out_size)                                                /* check length */
+            {
+                return 1;                                                               /* return error */
+            }
+            output[point] = c;                                                          /* set the byte */
+            point++;                                                                    /* point++ */
         }
-        default :
+    }
+    output[point] = input[in_len - 1];                                                  /* set the end */
+    point++;                                                                            /* point++ */
+    *out_len = point;                                                                   /* set the output length */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      uart get the rx frame
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  len buffer length
+ * @param[out] *output pointer to an output buffer
+ * @param[in]  out_len output length
+ * @return     status code
+ *             - 0 success
+ *             - 1 uart get rx frame failed
+ * @note       none
+ */
+static uint8_t a_sps30_uart_get_rx_frame(sps30_handle_t *handle, uint16_t len, uint8_t *output, uint16_t out_len)
+{
+    uint16_t point;
+    
+    if (handle->uart_receive_mode == SPS30_UART_RECEIVE_MODE_FEED)                              /* feed mode */
+    {
+        if ((handle->feed_done != 1) || (handle->feed_len != out_len))                          /* check the fed frame */
         {
-            handle->debug_print("sps30: unknown code.\n");                                    /* unknown code */
-            
-            break;
+            return 1;                                                                           /* return error */
         }
+        memcpy(output, handle->buf, out_len);                                                   /* the fed frame is already unstuffed */
+        
+        return 0;                                                                               /* success return 0 */
+    }
+    if (a_sps30_uart_unstuff(handle->buf, len, output, out_len, (uint16_t *)&point) != 0)        /* unstuff the frame */
+    {
+        return 1;                                                                               /* return error */
+    }
+    if (point != out_len)                                                                       /* check point */
+    {
+        return 1;                                                                               /* return error */
+    }
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      uart set the tx frame
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  *input pointer to an input buffer
+ * @param[in]  in_len input length
+ * @param[out] *out_len pointer to an output length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 uart set tx frame failed
+ * @note       the frame is stuffed straight into the uart buffer
+ */
+static uint8_t a_sps30_uart_set_tx_frame(sps30_handle_t *handle, uint8_t *input, uint16_t in_len, uint16_t *out_len)
+{
+    return a_sps30_uart_stuff(input, in_len, handle->buf, handle->buf_size, out_len);        /* stuff the frame */
+}
+
+/**
+ * @brief      uart receive the available bytes of a frame
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[out] *len pointer to a frame length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is full
+ *             - 2 frame is not complete
+ * @note       bytes before the start delimiter are dropped and
+ *             handle->rx_point must be cleared before the first call
+ */
+static uint8_t a_sps30_uart_receive(sps30_handle_t *handle, uint16_t *len)
+{
+    uint16_t i;
+    uint16_t l;
+    uint16_t point;
+    
+    point = handle->rx_point;                                                                 /* get the point */
+    if (point >= handle->buf_size)                                                            /* check the point */
+    {
+        return 1;                                                                             /* return error */
+    }
+    l = a_sps30_link_uart_read(handle, &handle->buf[point], handle->buf_size - point);        /* read the available data */
+    if ((point == 0) && (l != 0))                                                             /* no start delimiter yet */
+    {
+        i = 0;                                                                                /* init 0 */
+        while ((i < l) && (handle->buf[i] != 0x7E))                                           /* find the start delimiter */
+        {
+            i++;                                                                              /* i++ */
+        }
+        l -= i;                                                                               /* drop the leading data */
+        memmove(handle->buf, &handle->buf[i], l);                                             /* move to the start */
+    }
+    for (i = (point == 0) ? 1 : point; i < (point + l); i++)                                  /* check the new data */
+    {
+        if (handle->buf[i] == 0x7E)                                                           /* end delimiter */
+        {
+            *len = i + 1;                                                        /* set the frame length */
+            
+            return 0;                                                                         /* success return 0 */
+        }
+    }
+    handle->rx_point = point + l;                                                             /* add the length */
+    if (handle->rx_point >= handle->buf_size)                                                 /* check the point */
+    {
+        return 1;                                                                             /* return error */
+    }
+    
+    return 2;                                                                                 /* return pending */
+}
+
+/**
+ * @brief      uart read a frame until the end delimiter
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  timeout_ms deadline in ms
+ * @param[out] *len pointer to a frame length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read timeout
+ * @note       none
+ */
+static uint8_t a_sps30_uart_read_frame(sps30_handle_t *handle, uint16_t timeout_ms, uint16_t *len)
+{
+    uint8_t res;
+    uint16_t elapsed;
+    
+    handle->rx_point = 0;                                        /* init 0 */
+    elapsed = 0;                                                 /* init 0 */
+    while (1)                                                    /* loop */
+    {
+        res = a_sps30_uart_receive(handle, len);                 /* receive the available data */
+        if (res == 0)                                            /* check result */
+        {
+            return 0;                                            /* success return 0 */
+        }
+        if ((res == 1) || (elapsed >= timeout_ms))               /* check the deadline */
+        {
+            return 1;                                            /* return error */
+        }
+        a_sps30_link_delay_ms(handle, 1);                        /* delay 1 ms */
+        elapsed++;                                               /* elapsed++ */
+    }
+}
+
+/**
+ * @brief     uart wait for the fed frame
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] timeout_ms deadline in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait timeout or frame is invalid
+ * @note      a rejected frame fails the wait at once
+ */
+static uint8_t a_sps30_uart_wait_feed(sps30_handle_t *handle, uint16_t timeout_ms)
+{
+    uint16_t elapsed;
+    
+    elapsed = 0;                                                 /* init 0 */
+    while (handle->feed_done != 1)                               /* wait for the frame */
+    {
+        if (handle->feed_done == 2)                              /* check the rejected frame */
+        {
+            handle->feed_state = 0;                              /* stop the parser */
+            handle->debug_print("sps30: frame is invalid.\n");   /* frame is invalid */
+            
+            return 1;                                            /* return error */
+        }
+        if (elapsed >= timeout_ms)                               /* check the deadline */
+        {
+            handle->feed_state = 0;                              /* stop the parser */
+            
+            return 1;                                            /* return error */
+        }
+        a_sps30_link_delay_ms(handle, 1);                        /* delay 1 ms */
+        elapsed++;                                               /* elapsed++ */
+    }
+    
+    return 0;                                                    /* success return 0 */
+}
+
+/**
+ * @brief     uart send a stuffed frame
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] *frame pointer to a stuffed frame
+ * @param[in] len frame length
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      in the feed mode the parser is armed once the frame is written,
+ *            so the inner buffer is never shared by the tx and the rx frame
+ */
+static uint8_t a_sps30_uart_send_frame(sps30_handle_t *handle, const uint8_t *frame, uint16_t len)
+{
+    if (a_sps30_link_uart_flush(handle) != 0)                                     /* uart flush */
+    {
+        return 1;                                                                 /* return error */
+    }
+    handle->feed_state = 0;                                                       /* stop the parser */
+    handle->feed_done = 0;                                                        /* clear the done flag */
+    if (a_sps30_link_uart_write(handle, (uint8_t *)frame, len) != 0)              /* write data */
+    {
+        return 1;                                                                 /* return error */
+    }
+    if (handle->uart_receive_mode == SPS30_UART_RECEIVE_MODE_FEED)                /* feed mode */
+    {
+        handle->feed_state = 1;                                                   /* wait for the start delimiter */
+    }
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     uart send a frame
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] *input pointer to an input buffer
+ * @param[in] in_len input length
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      none
+ */
+static uint8_t a_sps30_uart_send(sps30_handle_t *handle, uint8_t *input, uint16_t in_len)
+{
+    uint16_t len;
+    
+    if (a_sps30_uart_set_tx_frame(handle, input, in_len, (uint16_t *)&len) != 0)  /* set tx frame */
+    {
+        return 1;                                                                 /* return error */
+    }
+    
+    return a_sps30_uart_send_frame(handle, handle->buf, len);                     /* send the stuffed frame */
+}
+
+/**
+ * @brief      uart read the response frame
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  timing command timing
+ * @param[out] *output pointer to an output buffer
+ * @param[in]  out_len output length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_sps30_uart_read_response(sps30_handle_t *handle, uint8_t timing, uint8_t *output, uint16_t out_len)
+{
+    uint16_t len;
+    
+    if (handle->uart_receive_mode == SPS30_UART_RECEIVE_MODE_FRAME)               /* frame mode */
+    {
+        if (a_sps30_uart_read_frame(handle, a_sps30_timing_ms(handle, timing),
+                                    (uint16_t *)&len) != 0)                       /* read until the frame end */
+        {
+            return 1;                                                             /* return error */
+        }
+    }
+    else if (handle->uart_receive_mode == SPS30_UART_RECEIVE_MODE_FEED)           /* feed mode */
+    {
+        if (a_sps30_uart_wait_feed(handle, a_sps30_timing_ms(handle, timing)) != 0)   /* wait for the fed frame */
+        {
+            return 1;                                                             /* return error */
+        }
+        len = 0;                                                                  /* not used */
+    }
+    else                                                                          /* delay mode */
+    {
+        a_sps30_delay_timing(handle, timing);                                     /* wait the command timing */
+        len = a_sps30_link_uart_read(handle, handle->buf,
+                                     handle->buf_size);                           /* read data */
+    }
+    if (a_sps30_uart_get_rx_frame(handle, len, output, out_len) != 0)             /* get rx frame */
+    {
+        return 1;                                                                 /* return error */
+    }
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief      write read bytes
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  *input pointer to an input buffer
+ * @param[in]  in_len input length
+ * @param[in]  timing command timing
+ * @param[out] *output pointer to an output buffer
+ * @param[in]  out_len output length
+ * @return     status code
+ *             - 0 success
+ *             - 1 write read failed
+ * @note       none
+ */
+static uint8_t a_sps30_uart_write_read(sps30_handle_t *handle, uint8_t *input, uint16_t in_len,
+                                       uint8_t timing, uint8_t *output, uint16_t out_len)
+{
+    if (a_sps30_uart_send(handle, input, in_len) != 0)                            /* send frame */
+    {
+        return 1;                                                                 /* return error */
+    }
+    
+    return a_sps30_uart_read_response(handle, timing, output, out_len);           /* read the response */
+}
+
+/**
+ * @brief      write a fixed frame and read bytes
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  frame fixed frame index
+ * @param[in]  timing command timing
+ * @param[out] *output pointer to an output buffer
+ * @param[in]  out_len output length
+ * @return     status code
+ *             - 0 success
+ *             - 1 write read failed
+ * @note       the pre-stuffed frame is written as it is, no checksum or stuffing runs
+ */
+static uint8_t a_sps30_uart_write_read_frame(sps30_handle_t *handle, uint8_t frame,
+                                             uint8_t timing, uint8_t *output, uint16_t out_len)
+{
+    if (a_sps30_uart_send_frame(handle, gs_sps30_uart_frame[frame].buf,
+                                gs_sps30_uart_frame[frame].len) != 0)             /* send the fixed frame */
+    {
+        return 1;                                                                 /* return error */
+    }
+    
+    return a_sps30_uart_read_response(handle, timing, output, out_len);           /* read the response */
+}
+#endif
+
+#if (SPS30_ENABLE_IIC == 1)
+/**
+ * @brief      check the crc of the iic words and pack the payload
+ * @param[in]  *buf pointer to a word buffer
+ * @param[in]  words number of words
+ * @return     status code
+ *             - 0 success
+ *             - 1 crc error
+ * @note       the payload is packed in place without the crc bytes
+ */
+static uint8_t a_sps30_iic_get_payload(uint8_t *buf, uint16_t words)
+{
+    uint16_t i;
+    
+    for (i = 0; i < words; i++)                                                             /* check all words */
+    {
+        if (buf[i * 3 + 2] != a_sps30_iic_crc((uint8_t *)&buf[i * 3], 2))                   /* check crc */
+        {
+            return 1;                                                                       /* return error */
+        }
+        buf[i * 2 + 0] = buf[i * 3 + 0];                                                    /* copy msb */
+        buf[i * 2 + 1] = buf[i * 3 + 1];                                                    /* copy lsb */
+    }
+    
+    return 0;                                                                               /* success return 0 */
+}
+#endif
+
+#if (SPS30_ENABLE_FLOAT == 1)
+/**
+ * @brief      decode the measured values
+ * @param[in]  format data format
+ * @param[in]  *payload pointer to a big endian payload buffer
+ * @param[in]  mask or of the fields to decode
+ * @param[out] *pm pointer to an sps30 pm structure
+ * @note       the payload holds 4 bytes per field with ieee754 and 2 bytes with uint16,
+ *             up to the last field set in the mask
+ */
+static void a_sps30_decode_pm(uint8_t format, uint8_t *payload, uint16_t mask, sps30_pm_t *pm)
+{
+    union float_u
+    {
+        float f;
+        uint32_t i;
+    };
+    union float_u f;
+    float *field[10];
+    uint8_t i;
+    
+    field[0] = &pm->pm1p0_ug_m3;                                                        /* pm1.0 ug/m3 */
+    field[1] = &pm->pm2p5_ug_m3;                                                        /* pm2.5 ug/m3 */
+    field[2] = &pm->pm4p0_ug_m3;                                                        /* pm4.0 ug/m3 */
+    field[3] = &pm->pm10_ug_m3;                                                         /* pm10 ug/m3 */
+    field[4] = &pm->pm0p5_cm3;                                                          /* pm0.5 cm3 */
+    field[5] = &pm->pm1p0_cm3;                                                          /* pm1.0 cm3 */
+    field[6] = &pm->pm2p5_cm3;                                                          /* pm2.5 cm3 */
+    field[7] = &pm->pm4p0_cm3;                                                          /* pm4.0 cm3 */
+    field[8] = &pm->pm10_cm3;                                                           /* pm10 cm3 */
+    field[9] = &pm->typical_particle_um;                                                /* typical particle um */
+    for (i = 0; i < 10; i++)                                                            /* decode 10 values */
+    {
+        if ((mask & (1 << i)) == 0)                                                     /* not selected */
+        {
+            continue;                                                                   /* skip the field */
+        }
+        if (format == SPS30_FORMAT_IEEE754)                                             /* float */
+        {
+            f.i = (uint32_t)(payload[i * 4 + 0]) << 24 | (uint32_t)(payload[i * 4 + 1]) << 16 |
+                  (uint32_t)(payload[i * 4 + 2]) << 8 | (uint32_t)(payload[i * 4 + 3]) << 0;      /* copy data */
+            *field[i] = f.f;                                                            /* set the value */
+        }
+        else                                                                            /* uint16 */
+        {
+            *field[i] = (float)(((uint16_t)(payload[i * 2 + 0]) << 8) |
+                                ((uint16_t)(payload[i * 2 + 1]) << 0));                 /* set the value */
+            if (i == 9)                                                                 /* typical particle size */
+            {
+                *field[i] /= 1000.0f;                                                   /* div 1000 */
+            }
+        }
+    }
+}
+#endif
+
+/**
+ * @brief      decode the uint16 measured values
+ * @param[in]  *payload pointer to a big endian payload buffer
+ * @param[out] *pm pointer to an sps30 pm u16 structure
+ * @note       the typical particle size is kept in nm
+ */
+static void a_sps30_decode_pm_u16(uint8_t *payload, sps30_pm_u16_t *pm)
+{
+    uint16_t *field[10];
+    uint8_t i;
+    
+    field[0] = &pm->pm1p0_ug_m3;                                                        /* pm1.0 ug/m3 */
+    field[1] = &pm->pm2p5_ug_m3;                                                        /* pm2.5 ug/m3 */
+    field[2] = &pm->pm4p0_ug_m3;                                                        /* pm4.0 ug/m3 */
+    field[3] = &pm->pm10_ug_m3;                                                         /* pm10 ug/m3 */
+    field[4] = &pm->pm0p5_cm3;                                                          /* pm0.5 cm3 */
+    field[5] = &pm->pm1p0_cm3;                                                          /* pm1.0 cm3 */
+    field[6] = &pm->pm2p5_cm3;                                                          /* pm2.5 cm3 */
+    field[7] = &pm->pm4p0_cm3;                                                          /* pm4.0 cm3 */
+    field[8] = &pm->pm10_cm3;                                                           /* pm10 cm3 */
+    field[9] = &pm->typical_particle_nm;                                                /* typical particle nm */
+    for (i = 0; i < 10; i++)                                                            /* decode 10 values */
+    {
+        *field[i] = (uint16_t)(((uint16_t)(payload[i * 2 + 0]) << 8) |
+                               ((uint16_t)(payload[i * 2 + 1]) << 0));                  /* set the value */
+    }
+}
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief     print error
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] e error code
+ * @return    error code
+ * @note      none
+ */
+static uint8_t a_sps30_uart_error(sps30_handle_t *handle, uint8_t e)
+{
+#if (SPS30_ENABLE_STATS == 1)
+    if (e != 0)                                                                               /* check the state */
+    {
+        handle->stats.state_error++;                                                          /* count the state error */
+    }
+#endif
+    switch (e)
+    {
+        case 0x00 :
+        {
+            break;
+        }
+        case 0x01 :
+        {
+            handle->debug_print("sps30: wrong data length for this command error.\n");        /* wrong data length for this command error */
+            
+            break;
+        }
+        case 0x02 :
+        {
+            handle->debug_print("sps30: unknown command.\n");                                 /* unknown command */
+            
+            break;
+        }
+        case 0x03 :
+        {
+            handle->debug_print("sps30: no access right for command.\n");                     /* no access right for command */
+            
+            break;
+        }
+        case 0x04 :
+        {
+            handle->debug_print("sps30: illegal command parameter or parameter "
+                                "out of allowed range.\n");                                   /* illegal command parameter or parameter out of allowed range */
+            
+            break;
+        }
+        case 0x28 :
+        {
+            handle->debug_print("sps30: internal function argument out of range.\n");         /* internal function argument out of range */
+            
+            break;
+        }
+        case 0x43 :
+        {
+            handle->debug_print("sps30: command not allowed in current state.\n");            /* command not allowed in current state */
+            
+            break;
+        }
+        default :
+        {
+            handle->debug_print("sps30: unknown code.\n");                                    /* unknown code */
+            
+            break;
+        }
+    }
+    
+    return e;                                                                                 /* return error code */
+}
+
+/**
+ * @brief     uart check the response frame
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] *frame pointer to an unstuffed frame
+ * @param[in] len frame length
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_sps30_uart_check_frame(sps30_handle_t *handle, uint8_t *frame, uint16_t len)
+{
+    if (frame[len - 2] != a_sps30_uart_checksum((uint8_t *)&frame[1], len - 3))     /* check crc */
+    {
+        a_sps30_stats_crc(handle);                                                 /* count the crc error */
+        handle->debug_print("sps30: crc check error.\n");                          /* crc check error */
+        
+        return 1;                                                                   /* return error */
+    }
+    if (a_sps30_uart_error(handle, frame[3]) != 0)                                  /* check status */
+    {
+        return 1;                                                                   /* return error */
+    }
+    
+    return 0;                                                                       /* success return 0 */
+}
+#endif
+
+/**
+ * @brief     check whether the async deadline is reached
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] now_ms current time in ms
+ * @return    1 if the deadline is reached, otherwise 0
+ * @note      the compare is safe across the counter wrap around
+ */
+static uint8_t a_sps30_async_expired(sps30_handle_t *handle, uint32_t now_ms)
+{
+    return ((int32_t)(now_ms - handle->async_deadline) >= 0) ? 1 : 0;        /* check the deadline */
+}
+
+/**
+ * @brief     send a command of the description table
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] command async command
+ * @param[in] param command param
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      none
+ */
+static uint8_t a_sps30_send_command(sps30_handle_t *handle, uint8_t command, uint32_t param)
+{
+    const sps30_command_desc_t *desc = &gs_sps30_command_desc[command];
+    
+    if (handle->iic_uart != 0)                                                                 /* uart */
+    {
+#if (SPS30_ENABLE_UART == 1)
+        uint8_t input_buf[6 + 5];
+        uint8_t frame;
+        uint8_t len;
+        uint8_t wake_up = 0xFF;
+        
+        frame = desc->uart_frame;                                                              /* get the fixed frame */
+        if (command == SPS30_ASYNC_COMMAND_START_MEASUREMENT)                                  /* start measurement */
+        {
+            if (param == SPS30_FORMAT_UINT16)                                                  /* uint16 format */
+            {
+                frame = SPS30_UART_FRAME_START_MEASUREMENT_UINT16;                             /* set the uint16 frame */
+            }
+            else if (param != SPS30_FORMAT_IEEE754)                                            /* unknown format */
+            {
+                frame = SPS30_UART_FRAME_NONE;                                                 /* build the frame */
+            }
+            else
+            {
+                
+            }
+        }
+        if (command == SPS30_ASYNC_COMMAND_WAKE_UP)                                            /* wake up */
+        {
+            if (a_sps30_link_uart_write(handle, (uint8_t *)&wake_up, 1) != 0)                  /* write data */
+            {
+                return 1;                                                                      /* return error */
+            }
+        }
+        handle->rx_point = 0;                                                                  /* clear the receive point */
+        if (frame != SPS30_UART_FRAME_NONE)                                                    /* fixed frame */
+        {
+            return a_sps30_uart_send_frame(handle, gs_sps30_uart_frame[frame].buf,
+                                           gs_sps30_uart_frame[frame].len);                    /* send the fixed frame */
+        }
+        input_buf[0] = 0x7E;                                                                   /* set start */
+        input_buf[1] = 0x00;                                                                   /* set addr */
+        if (command == SPS30_ASYNC_COMMAND_START_MEASUREMENT)                                  /* start measurement */
+        {
+            input_buf[2] = SPS30_UART_COMMAND_START_MEASUREMENT;                               /* set command */
+            input_buf[4] = 0x01;                                                               /* set 0x01 */
+            input_buf[5] = (uint8_t)param;                                                     /* set format */
+            len = 2;                                                                           /* set length */
+        }
+        else                                                                                   /* set auto cleaning interval */
+        {
+            input_buf[2] = SPS30_UART_COMMAND_READ_WRITE_AUTO_CLEANING_INTERVAL;               /* set command */
+            input_buf[4] = 0x00;                                                               /* set 0x00 */
+            input_buf[5] = (param >> 24) & 0xFF;                                               /* set 32 - 24 bits */
+            input_buf[6] = (param >> 16) & 0xFF;                                               /* set 24 - 16 bits */
+            input_buf[7] = (param >> 8) & 0xFF;                                                /* set 16 - 8 bits */
+            input_buf[8] = (param >> 0) & 0xFF;                                                /* set 8 - 0 bits */
+            len = 5;                                                                           /* set length */
+        }
+        input_buf[3] = len;                                                                    /* set length */
+        input_buf[4 + len] = a_sps30_uart_checksum((uint8_t *)&input_buf[1], 3 + len);         /* set crc */
+        input_buf[5 + len] = 0x7E;                                                             /* set stop */
+        
+        return a_sps30_uart_send(handle, (uint8_t *)input_buf, 6 + len);                       /* send frame */
+#else
+        return 1;                                                                              /* interface is disabled */
+#endif
+    }
+    else                                                                                       /* iic */
+    {
+#if (SPS30_ENABLE_IIC == 1)
+        uint8_t buf[6];
+        uint16_t reg;
+        uint16_t len;
+        
+        reg = desc->iic_command;                                                               /* set command */
+        len = 0;                                                                               /* init 0 */
+        if ((command == SPS30_ASYNC_COMMAND_READ) &&
+            (handle->read_mode == SPS30_READ_MODE_CHECK_FLAG))                                 /* read */
+        {
+            reg = SPS30_IIC_COMMAND_READ_DATA_READY_FLAG;                                      /* check the flag first */
+        }
+        else if (command == SPS30_ASYNC_COMMAND_START_MEASUREMENT)                             /* start measurement */
+        {
+            buf[0] = (uint8_t)param;                                                           /* set format */
+            buf[1] = 0x00;                                                                     /* set dummy */
+            buf[2] = a_sps30_iic_crc((uint8_t *)buf, 2);                                       /* generate crc */
+            len = 3;                                                                           /* set length */
+        }
+        else if (command == SPS30_ASYNC_COMMAND_SET_AUTO_CLEANING_INTERVAL)                    /* set auto cleaning interval */
+        {
+            buf[0] = (param >> 24) & 0xFF;                                                     /* set byte 4 */
+            buf[1] = (param >> 16) & 0xFF;                                                     /* set byte 3 */
+            buf[2] = a_sps30_iic_crc((uint8_t *)&buf[0], 2);                                   /* set crc */
+            buf[3] = (param >> 8) & 0xFF;                                                      /* set byte 2 */
+            buf[4] = (param >> 0) & 0xFF;                                                      /* set byte 1 */
+            buf[5] = a_sps30_iic_crc((uint8_t *)&buf[3], 2);                                   /* set crc */
+            len = 6;                                                                           /* set length */
+        }
+        else if (command == SPS30_ASYNC_COMMAND_WAKE_UP)                                       /* wake up */
+        {
+            (void)a_sps30_iic_send(handle, SPS30_ADDRESS, reg, NULL, 0);                       /* the first pulse wakes the interface */
+        }
+        else
+        {
+            
+        }
+        
+        return a_sps30_iic_send(handle, SPS30_ADDRESS, reg, (uint8_t *)buf, len);              /* send command */
+#else
+        return 1;                                                                              /* interface is disabled */
+#endif
+    }
+}
+
+/**
+ * @brief      transfer a command of the description table
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  command command index
+ * @param[in]  param command param
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       the payload gets the uart frame data or the iic words without crc,
+ *             it may be NULL when the payload is not needed
+ */
+static uint8_t a_sps30_transfer_command(sps30_handle_t *handle, uint8_t command, uint32_t param, uint8_t *payload)
+{
+    const sps30_command_desc_t *desc = &gs_sps30_command_desc[command];
+    
+    if (a_sps30_send_command(handle, command, param) != 0)                                     /* send command */
+    {
+        return 1;                                                                              /* return error */
+    }
+    if (handle->iic_uart != 0)                                                                 /* uart */
+    {
+#if (SPS30_ENABLE_UART == 1)
+        uint8_t out_buf[7 + 17];
+        
+        if (a_sps30_uart_read_response(handle, desc->timing, (uint8_t *)out_buf,
+                                       desc->uart_len) != 0)                                   /* read the response */
+        {
+            handle->debug_print("sps30: write read failed.\n");                               /* write read failed */
+            
+            return 1;                                                                          /* return error */
+        }
+        if (a_sps30_uart_check_frame(handle, (uint8_t *)out_buf, desc->uart_len) != 0)         /* check the frame */
+        {
+            return 1;                                                                          /* return error */
+        }
+        if ((payload != NULL) && (desc->uart_len > 7))                                         /* check the payload */
+        {
+            memcpy(payload, &out_buf[5], desc->uart_len - 7);                                  /* copy the payload */
+        }
+#endif
+    }
+    else                                                                                       /* iic */
+    {
+#if (SPS30_ENABLE_IIC == 1)
+        uint8_t buf[24];
+        
+        a_sps30_delay_timing(handle, desc->timing);                                            /* wait the command timing */
+        if (desc->iic_len != 0)                                                                /* read command */
+        {
+            if (a_sps30_link_iic_read_cmd(handle, SPS30_ADDRESS, (uint8_t *)buf,
+                                          desc->iic_len) != 0)                                 /* read data */
+            {
+                return 1;                                                                      /* return error */
+            }
+            if (a_sps30_iic_get_payload((uint8_t *)buf, desc->iic_len / 3) != 0)               /* check crc */
+            {
+                a_sps30_stats_crc(handle);                                                    /* count the crc error */
+                handle->debug_print("sps30: crc is error.\n");                                /* crc is error */
+                
+                return 1;                                                                      /* return error */
+            }
+            if (payload != NULL)                                                               /* check the payload */
+            {
+                memcpy(payload, buf, desc->iic_len / 3 * 2);                                   /* copy the payload */
+            }
+        }
+#endif
+    }
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      run a fixed command and count the stats
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  command command index
+ * @param[in]  param command param
+ * @param[out] *payload pointer to a payload buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       the latency is the elapsed time of the linked now_us clock,
+ *             else the delay time spent by the driver
+ */
+static uint8_t a_sps30_run_command(sps30_handle_t *handle, uint8_t command, uint32_t param, uint8_t *payload)
+{
+#if (SPS30_ENABLE_STATS == 1)
+    uint8_t res;
+    uint32_t begin;
+    
+    begin = a_sps30_time_us(handle);                                                                  /* get the begin time */
+    res = a_sps30_transfer_command(handle, command, param, payload);                                  /* transfer the command */
+    a_sps30_stats_command(handle, gs_sps30_command_desc[command].timing, res,
+                          (a_sps30_time_us(handle) - begin) / 1000);                                  /* count the command */
+    
+    return res;                                                                                       /* return the result */
+#else
+    return a_sps30_transfer_command(handle, command, param, payload);                                 /* transfer the command */
+#endif
+}
+
+/**
+ * @brief      run one step of the pending async command
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  now_ms current time in ms
+ * @param[out] *result pointer to a result buffer
+ * @param[out] *raw pointer to an sps30 raw sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 command failed
+ *             - 5 command is pending
+ *             - 6 data is not ready
+ * @note       the read and the string commands return the payload in raw
+ */
+static uint8_t a_sps30_async_step(sps30_handle_t *handle, uint32_t now_ms, uint32_t *result, sps30_raw_sample_t *raw)
+{
+    uint8_t command;
+    uint8_t *payload;
+    uint8_t buf[60];
+    uint16_t len;
+    const sps30_command_desc_t *desc;
+    
+    command = handle->async_command;                                                           /* get command */
+    desc = &gs_sps30_command_desc[command];                                                      /* get description */
+    len = (handle->format == SPS30_FORMAT_IEEE754) ? 40 : 20;                                  /* set the payload length */
+    if (handle->iic_uart != 0)                                                                 /* uart */
+    {
+#if (SPS30_ENABLE_UART == 1)
+        uint8_t res;
+        uint8_t out_buf[7 + 40];
+        uint16_t out_len;
+        
+        out_len = (command == SPS30_ASYNC_COMMAND_READ) ? (7 + len) : desc->uart_len;          /* set the frame length */
+        if (handle->uart_receive_mode == SPS30_UART_RECEIVE_MODE_FRAME)                        /* frame mode */
+        {
+            res = a_sps30_uart_receive(handle, (uint16_t *)&len);                              /* receive the available data */
+            if (res == 2)                                                                      /* not complete */
+            {
+                if (a_sps30_async_expired(handle, now_ms) == 0)                                /* check the deadline */
+                {
+                    return 5;                                                                  /* return pending */
+                }
+                handle->debug_print("sps30: read timeout.\n");                                 /* read timeout */
+                
+                return 1;                                                                      /* return error */
+            }
+            if (res != 0)                                                                      /* check result */
+            {
+                handle->debug_print("sps30: buffer is full.\n");                               /* buffer is full */
+                
+                return 1;                                                                      /* return error */
+            }
+        }
+        else if (handle->uart_receive_mode == SPS30_UART_RECEIVE_MODE_FEED)                    /* feed mode */
+        {
+            if (handle->feed_done != 1)                                                        /* not complete */
+            {
+                if (handle->feed_done == 2)                                                    /* check the rejected frame */
+                {
+                    handle->feed_state = 0;                                                    /* stop the parser */
+                    handle->debug_print("sps30: frame is invalid.\n");                         /* frame is invalid */
+                    
+                    return 1;                                                                  /* return error */
+                }
+                if (a_sps30_async_expired(handle, now_ms) == 0)                                /* check the deadline */
+                {
+                    return 5;                                                                  /* return pending */
+                }
+                handle->feed_state = 0;                                                        /* stop the parser */
+                handle->debug_print("sps30: read timeout.\n");                                 /* read timeout */
+                
+                return 1;                                                                      /* return error */
+            }
+            len = 0;                                                                           /* not used */
+        }
+        else                                                                                   /* delay mode */
+        {
+            if (a_sps30_async_expired(handle, now_ms) == 0)                                    /* check the deadline */
+            {
+                return 5;                                                                      /* return pending */
+            }
+            len = a_sps30_link_uart_read(handle, handle->buf, handle->buf_size);               /* read data */
+        }
+        if (a_sps30_uart_get_rx_frame(handle, len, (uint8_t *)out_buf, out_len) != 0)          /* get rx frame */
+        {
+            handle->debug_print("sps30: write read failed.\n");                                /* write read failed */
+            
+            return 1;                                                                          /* return error */
+        }
+        if (a_sps30_uart_check_frame(handle, (uint8_t *)out_buf, out_len) != 0)                /* check the frame */
+        {
+            return 1;                                                                          /* return error */
+        }
+        memcpy(buf, &out_buf[5], out_len - 7);                                                 /* copy the payload */
+        payload = buf;                                                                         /* set the payload */
+#endif
+    }
+    else                                                                                       /* iic */
+    {
+#if (SPS30_ENABLE_IIC == 1)
+        if (a_sps30_async_expired(handle, now_ms) == 0)                                        /* check the deadline */
+        {
+            return 5;                                                                          /* return pending */
+        }
+        if ((command == SPS30_ASYNC_COMMAND_READ) && (handle->async_step == 0) &&
+            (handle->read_mode == SPS30_READ_MODE_CHECK_FLAG))                                 /* data ready flag */
+        {
+            if (a_sps30_link_iic_read_cmd(handle, SPS30_ADDRESS, (uint8_t *)buf, 3) != 0)      /* read data */
+            {
+                handle->debug_print("sps30: read data ready flag failed.\n");                  /* read data ready flag failed */
+                
+                return 1;                                                                      /* return error */
+            }
+            if (buf[2] != a_sps30_iic_crc((uint8_t *)buf, 2))                                  /* check crc */
+            {
+                a_sps30_stats_crc(handle);                                                     /* count the crc error */
+                handle->debug_print("sps30: crc check failed.\n");                             /* crc check failed */
+                
+                return 1;                                                                      /* return error */
+            }
+            if ((buf[1] & 0x01) == 0)                                                          /* check flag */
+            {
+                return 6;                                                                      /* data is not ready */
+            }
+            if (a_sps30_iic_send(handle, SPS30_ADDRESS, desc->iic_command, NULL, 0) != 0)      /* read measured values command */
+            {
+                handle->debug_print("sps30: read measured values failed.\n");                  /* read measured values failed */
+                
+                return 1;                                                                      /* return error */
+            }
+            handle->async_step = 1;                                                            /* next step */
+            handle->async_deadline = now_ms + a_sps30_timing_ms(handle, desc->timing);         /* set the deadline */
+            
+            return 5;                                                                          /* return pending */
+        }
+        len = (command == SPS30_ASYNC_COMMAND_READ) ? (len / 2 * 3) : desc->iic_len;           /* set the read length */
+        if (len != 0)                                                                          /* read command */
+        {
+            if (a_sps30_link_iic_read_cmd(handle, SPS30_ADDRESS, (uint8_t *)buf, len) != 0)    /* read data */
+            {
+                handle->debug_print("sps30: read failed.\n");                                  /* read failed */
+                
+                return 1;                                                                      /* return error */
+            }
+            if (a_sps30_iic_get_payload((uint8_t *)buf, len / 3) != 0)                         /* check crc */
+            {
+                a_sps30_stats_crc(handle);                                                     /* count the crc error */
+                handle->debug_print("sps30: crc is error.\n");                                 /* crc is error */
+                
+                return 1;                                                                      /* return error */
+            }
+        }
+        payload = buf;                                                                         /* set the payload */
+#endif
+    }
+    
+    switch (command)
+    {
+        case SPS30_ASYNC_COMMAND_READ :
+        {
+            raw->format = handle->format;                                                      /* save the format */
+            raw->len = (handle->format == SPS30_FORMAT_IEEE754) ? 40 : 20;                     /* save the payload length */
+            memcpy(raw->payload, payload, raw->len);                                           /* copy the payload */
+            
+            break;
+        }
+        case SPS30_ASYNC_COMMAND_READ_DATA_FLAG :
+        {
+            *result = payload[1] & 0x01;                                                       /* get the data ready flag */
+            
+            break;
+        }
+        case SPS30_ASYNC_COMMAND_GET_AUTO_CLEANING_INTERVAL :
+        case SPS30_ASYNC_COMMAND_GET_DEVICE_STATUS :
+        {
+            *result = ((uint32_t)payload[0] << 24) | ((uint32_t)payload[1] << 16) |
+                      ((uint32_t)payload[2] << 8) | ((uint32_t)payload[3] << 0);               /* get the value */
+            
+            break;
+        }
+        case SPS30_ASYNC_COMMAND_GET_VERSION :
+        {
+            *result = ((uint32_t)payload[0] << 8) | ((uint32_t)payload[1] << 0);               /* get major and minor */
+            
+            break;
+        }
+        case SPS30_ASYNC_COMMAND_GET_PRODUCT_TYPE :
+        case SPS30_ASYNC_COMMAND_GET_SERIAL_NUMBER :
+        {
+            raw->format = handle->format;                                                      /* save the format */
+            raw->len = (command == SPS30_ASYNC_COMMAND_GET_PRODUCT_TYPE) ? 8 : 16;             /* save the string length */
+            memcpy(raw->payload, payload, raw->len);                                           /* copy the string */
+            *result = 0;                                                                       /* no result */
+            
+            break;
+        }
+        default :
+        {
+            *result = 0;                                                                       /* no result */
+            
+            break;
+        }
+    }
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     set the chip interface
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] interface chip interface
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 interface is disabled
+ * @note      the interface must be enabled by SPS30_ENABLE_IIC or SPS30_ENABLE_UART
+ */
+uint8_t sps30_set_interface(sps30_handle_t *handle, sps30_interface_t interface) 
+{
+    if (handle == NULL)                           /* check handle */
+    {
+        return 2;                                 /* return error */
+    }
+#if (SPS30_ENABLE_IIC != 1)
+    if (interface == SPS30_INTERFACE_IIC)         /* check interface */
+    {
+        return 4;                                 /* return error */
+    }
+#endif
+#if (SPS30_ENABLE_UART != 1)
+    if (interface == SPS30_INTERFACE_UART)        /* check interface */
+    {
+        return 4;                                 /* return error */
+    }
+#endif
+    
+    handle->iic_uart = (uint8_t)interface;        /* set interface */
+    
+    return 0;                                     /* success return 0 */
+}
+
+/**
+ * @brief      get the chip interface
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[out] *interface pointer to a chip interface buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t sps30_get_interface(sps30_handle_t *handle, sps30_interface_t *interface) 
+{
+    if (handle == NULL)                                        /* check handle */
+    {
+        return 2;                                              /* return error */
+    }
+    
+    *interface = (sps30_interface_t)(handle->iic_uart);        /* get interface */
+    
+    return 0;                                                  /* success return 0 */
+}
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief     set the uart receive mode
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] mode uart receive mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 5 handle is busy
+ * @note      in the frame mode the command delay is used as the deadline
+ */
+uint8_t sps30_set_uart_receive_mode(sps30_handle_t *handle, sps30_uart_receive_mode_t mode)
+{
+    if (handle == NULL)                                     /* check handle */
+    {
+        return 2;                                           /* return error */
+    }
+    if (handle->async_state != 0)                           /* check state */
+    {
+        handle->debug_print("sps30: handle is busy.\n");    /* handle is busy */
+        
+        return 5;                                           /* return error */
+    }
+    
+    handle->uart_receive_mode = (uint8_t)mode;              /* set the receive mode */
+    
+    return 0;                                               /* success return 0 */
+}
+
+/**
+ * @brief      get the uart receive mode
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[out] *mode pointer to a uart receive mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t sps30_get_uart_receive_mode(sps30_handle_t *handle, sps30_uart_receive_mode_t *mode)
+{
+    if (handle == NULL)                                                      /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    
+    *mode = (sps30_uart_receive_mode_t)(handle->uart_receive_mode);          /* get the receive mode */
+    
+    return 0;                                                                /* success return 0 */
+}
+#endif
+
+/**
+ * @brief     set the read mode
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] mode read mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 5 handle is busy
+ * @note      the direct mode saves the data ready flag transaction on the iic bus,
+ *            a sync read within 1 s of the last one returns 5 when the linked now_us clock is in the build,
+ *            sps30_read_direct takes the time from the caller, else the caller must keep the 1 s cadence
+ */
+uint8_t sps30_set_read_mode(sps30_handle_t *handle, sps30_read_mode_t mode)
+{
+    if (handle == NULL)                                     /* check handle */
+    {
+        return 2;                                           /* return error */
+    }
+    if (handle->async_state != 0)                           /* check state */
+    {
+        handle->debug_print("sps30: handle is busy.\n");    /* handle is busy */
+        
+        return 5;                                           /* return error */
+    }
+    
+    handle->read_mode = (uint8_t)mode;                      /* set the read mode */
+    
+    return 0;                                               /* success return 0 */
+}
+
+/**
+ * @brief      get the read mode
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[out] *mode pointer to a read mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t sps30_get_read_mode(sps30_handle_t *handle, sps30_read_mode_t *mode)
+{
+    if (handle == NULL)                                    /* check handle */
+    {
+        return 2;                                          /* return error */
+    }
+    
+    *mode = (sps30_read_mode_t)(handle->read_mode);        /* get the read mode */
+    
+    return 0;                                              /* success return 0 */
+}
+
+/**
+ * @brief     set the command timing
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] timing command timing
+ * @param[in] us delay time in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timing is invalid
+ * @note      sps30_init loads the datasheet timing, so call it after sps30_init
+ */
+uint8_t sps30_set_timing(sps30_handle_t *handle, sps30_timing_t timing, uint32_t us)
+{
+    if (handle == NULL)                                        /* check handle */
+    {
+        return 2;                                              /* return error */
+    }
+    if (handle->inited != 1)                                   /* check handle initialization */
+    {
+        return 3;                                              /* return error */
+    }
+    if ((uint32_t)timing >= SPS30_TIMING_MAX)                  /* check timing */
+    {
+        handle->debug_print("sps30: timing is invalid.\n");    /* timing is invalid */
+        
+        return 4;                                              /* return error */
+    }
+    
+    handle->timing_us[timing] = us;                            /* set the timing */
+    
+    return 0;                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the command timing
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  timing command timing
+ * @param[out] *us pointer to a delay time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timing is invalid
+ * @note       none
+ */
+uint8_t sps30_get_timing(sps30_handle_t *handle, sps30_timing_t timing, uint32_t *us)
+{
+    if ((handle == NULL) || (us == NULL))                      /* check handle */
+    {
+        return 2;                                              /* return error */
+    }
+    if (handle->inited != 1)                                   /* check handle initialization */
+    {
+        return 3;                                              /* return error */
+    }
+    if ((uint32_t)timing >= SPS30_TIMING_MAX)                  /* check timing */
+    {
+        handle->debug_print("sps30: timing is invalid.\n");    /* timing is invalid */
+        
+        return 4;                                              /* return error */
+    }
+    
+    *us = handle->timing_us[timing];                           /* get the timing */
+    
+    return 0;                                                  /* success return 0 */
+}
+
+/**
+ * @brief     run one auto tune probe
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] timing command timing
+ * @return    status code
+ *            - 0 success
+ *            - 1 probe failed
+ * @note      every probe reads the chip three times and the failed reads are
+ *            reported by the debug print
+ */
+static uint8_t a_sps30_auto_tune_probe(sps30_handle_t *handle, sps30_timing_t timing)
+{
+    uint8_t i;
+    uint8_t res;
+    uint8_t major;
+    uint8_t minor;
+    uint32_t value;
+    char str[17];
+    sps30_data_ready_flag_t flag;
+    
+    for (i = 0; i < 3; i++)                                                        /* three times */
+    {
+        switch (timing)                                                            /* run the read */
+        {
+            case SPS30_TIMING_READ_DATA_READY_FLAG :
+            {
+                res = sps30_read_data_flag(handle, &flag);                         /* read data ready flag */
+                
+                break;
+            }
+            case SPS30_TIMING_AUTO_CLEANING_INTERVAL :
+            {
+                res = sps30_get_auto_cleaning_interval(handle, &value);            /* get auto cleaning interval */
+                
+                break;
+            }
+            case SPS30_TIMING_PRODUCT_TYPE :
+            {
+                res = sps30_get_product_type(handle, str);                         /* get product type */
+                
+                break;
+            }
+            case SPS30_TIMING_SERIAL_NUMBER :
+            {
+                res = sps30_get_serial_number(handle, str);                        /* get serial number */
+                
+                break;
+            }
+            case SPS30_TIMING_VERSION :
+            {
+                res = sps30_get_version(handle, &major, &minor);                   /* get version */
+                
+                break;
+            }
+            default :
+            {
+                res = sps30_get_device_status(handle, &value);                     /* get device status */
+                
+                break;
+            }
+        }
+        if (res != 0)                                                              /* check result */
+        {
+            a_sps30_link_delay_ms(handle, gs_sps30_timing_default[timing] / 1000); /* let the chip recover */
+            
+            return 1;                                                              /* return error */
+        }
+    }
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      find the smallest working command timing
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  timing command timing
+ * @param[in]  step_us search resolution in us
+ * @param[out] *us pointer to a delay time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 auto tune failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timing can't be tuned
+ *             - 5 handle is busy
+ * @note       only the read commands without side effects can be tuned,
+ *             every candidate must return a valid frame three times in a row,
+ *             the smallest working timing plus SPS30_AUTO_TUNE_MARGIN percent, at least step_us,
+ *             is saved in the timing table, it never exceeds the datasheet timing
+ */
+uint8_t sps30_auto_tune_timing(sps30_handle_t *handle, sps30_timing_t timing, uint32_t step_us, uint32_t *us)
+{
+    uint32_t lo;
+    uint32_t hi;
+    uint32_t mid;
+    uint32_t margin;
+    
+    if ((handle == NULL) || (us == NULL))                                                     /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    if (handle->async_state != 0)                                                             /* check state */
+    {
+        handle->debug_print("sps30: handle is busy.\n");                                      /* handle is busy */
+        
+        return 5;                                                                             /* return error */
+    }
+    if (((timing != SPS30_TIMING_READ_DATA_READY_FLAG) || (handle->iic_uart != 0)) &&
+        (timing != SPS30_TIMING_AUTO_CLEANING_INTERVAL) && (timing != SPS30_TIMING_PRODUCT_TYPE) &&
+        (timing != SPS30_TIMING_SERIAL_NUMBER) && (timing != SPS30_TIMING_VERSION) &&
+        (timing != SPS30_TIMING_DEVICE_STATUS))                                               /* check timing */
+    {
+        handle->debug_print("sps30: timing can't be tuned.\n");                               /* timing can't be tuned */
+        
+        return 4;                                                                             /* return error */
+    }
+    if (step_us == 0)                                                                         /* check step */
+    {
+        step_us = 1;                                                                          /* at least 1 us */
+    }
+    
+    hi = gs_sps30_timing_default[timing];                                                     /* start from the datasheet */
+    handle->timing_us[timing] = hi;                                                           /* set the timing */
+    if (a_sps30_auto_tune_probe(handle, timing) != 0)                                         /* check the datasheet timing */
+    {
+        handle->debug_print("sps30: auto tune failed.\n");                                    /* auto tune failed */
+        
+        return 1;                                                                             /* return error */
+    }
+    lo = 0;                                                                                   /* init 0 */
+    while ((hi - lo) > step_us)                                                               /* binary search */
+    {
+        mid = lo + (hi - lo) / 2;                                                             /* get the middle */
+        handle->timing_us[timing] = mid;                                                      /* try the middle */
+        if (a_sps30_auto_tune_probe(handle, timing) == 0)                                     /* check the middle */
+        {
+            hi = mid;                                                                         /* the middle works */
+        }
+        else
+        {
+            lo = mid;                                                                         /* the middle fails */
+        }
+    }
+    margin = hi * SPS30_AUTO_TUNE_MARGIN / 100;                                               /* get the guard band */
+    margin = (margin < step_us) ? step_us : margin;                                           /* at least one step */
+    hi = ((gs_sps30_timing_default[timing] - hi) < margin) ?
+          gs_sps30_timing_default[timing] : (hi + margin);                                    /* add the guard band */
+    handle->timing_us[timing] = hi;                                                           /* save the guarded timing */
+    *us = hi;                                                                                 /* set the result */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+#if (SPS30_ENABLE_STATS == 1)
+/**
+ * @brief      get the statistics
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[out] *stats pointer to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       sync command latency is the elapsed time of the linked now_us clock,
+ *             else the delay time spent by the driver,
+ *             async command latency is the now_ms span between begin and the last poll
+ */
+uint8_t sps30_get_stats(sps30_handle_t *handle, sps30_stats_t *stats)
+{
+    if ((handle == NULL) || (stats == NULL))                   /* check handle */
+    {
+        return 2;                                              /* return error */
+    }
+    if (handle->inited != 1)                                   /* check handle initialization */
+    {
+        return 3;                                              /* return error */
+    }
+    
+    memcpy(stats, &handle->stats, sizeof(sps30_stats_t));     /* copy the stats */
+    
+    return 0;                                                  /* success return 0 */
+}
+
+/**
+ * @brief     reset the statistics
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      sps30_init resets the statistics
+ */
+uint8_t sps30_reset_stats(sps30_handle_t *handle)
+{
+    if (handle == NULL)                                        /* check handle */
+    {
+        return 2;                                              /* return error */
+    }
+    if (handle->inited != 1)                                   /* check handle initialization */
+    {
+        return 3;                                              /* return error */
+    }
+    
+    memset(&handle->stats, 0, sizeof(sps30_stats_t));         /* clear the stats */
+    
+    return 0;                                                  /* success return 0 */
+}
+#endif
+
+/**
+ * @brief     start the measurement
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] format data format
+ * @return    status code
+ *            - 0 success
+ *            - 1 start measurement failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 handle is busy
+ * @note      none
+ */
+uint8_t sps30_start_measurement(sps30_handle_t *handle, sps30_format_t format)
+{
+    if (handle == NULL)                                                                                                   /* check handle */
+    {
+        return 2;                                                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                                                              /* check handle initialization */
+    {
+        return 3;                                                                                                         /* return error */
+    }
+    if (handle->async_state != 0)                                                                                         /* check state */
+    {
+        handle->debug_print("sps30: handle is busy.\n");                                                                  /* handle is busy */
+        
+        return 5;                                                                                                         /* return error */
+    }
+    
+    handle->format = format;                                                                                              /* save format */
+    if (a_sps30_run_command(handle, SPS30_ASYNC_COMMAND_START_MEASUREMENT, format, NULL) != 0)                            /* start measurement command */
+    {
+        handle->debug_print("sps30: start measurement failed.\n");                                                        /* start measurement failed */
+        
+        return 1;                                                                                                         /* return error */
+    }
+    
+    return 0;                                                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     stop the measurement
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 stop measurement failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 handle is busy
+ * @note      none
+ */
+uint8_t sps30_stop_measurement(sps30_handle_t *handle)
+{
+    if (handle == NULL)                                                                                        /* check handle */
+    {
+        return 2;                                                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                                                   /* check handle initialization */
+    {
+        return 3;                                                                                              /* return error */
+    }
+    if (handle->async_state != 0)                                                                              /* check state */
+    {
+        handle->debug_print("sps30: handle is busy.\n");                                                       /* handle is busy */
+        
+        return 5;                                                                                              /* return error */
+    }
+    
+    if (a_sps30_run_command(handle, SPS30_ASYNC_COMMAND_STOP_MEASUREMENT, 0, NULL) != 0)                       /* stop measurement command */
+    {
+        handle->debug_print("sps30: stop measurement failed.\n");                                              /* stop measurement failed */
+        
+        return 1;                                                                                              /* return error */
+    }
+    
+    return 0;                                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      read the data read flag
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[out] *flag pointer to a data ready flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read data read flag failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 5 handle is busy
+ * @note       none
+ */
+uint8_t sps30_read_data_flag(sps30_handle_t *handle, sps30_data_ready_flag_t *flag)
+{
+    uint8_t buf[2];
+    
+    if (handle == NULL)                                                                                                    /* check handle */
+    {
+        return 2;                                                                                                          /* return error */
+    }
+    if (handle->inited != 1)                                                                                               /* check handle initialization */
+    {
+        return 3;                                                                                                          /* return error */
+    }
+    if (handle->async_state != 0)                                                                                          /* check state */
+    {
+        handle->debug_print("sps30: handle is busy.\n");                                                                   /* handle is busy */
+        
+        return 5;                                                                                                          /* return error */
+    }
+    
+    if (handle->iic_uart != 0)                                                                                             /* uart */
+    {
+        handle->debug_print("sps30: uart has no command.\n");                                                              /* uart has no command */
+        
+        return 1;                                                                                                          /* return error */
+    }
+    
+    if (a_sps30_run_command(handle, SPS30_ASYNC_COMMAND_READ_DATA_FLAG, 0, (uint8_t *)buf) != 0)                           /* read data ready flag command */
+    {
+        handle->debug_print("sps30: read data ready flag failed.\n");                                                      /* read data ready flag failed */
+        
+        return 1;                                                                                                          /* return error */
+    }
+    *flag = (sps30_data_ready_flag_t)(buf[1] & 0x01);                                                                      /* get the data ready flag */
+    
+    return 0;                                                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     enter the sleep mode
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 sleep failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 handle is busy
+ * @note      none
+ */
+uint8_t sps30_sleep(sps30_handle_t *handle)
+{
+    if (handle == NULL)                                                                                        /* check handle */
+    {
+        return 2;                                                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                                                   /* check handle initialization */
+    {
+        return 3;                                                                                              /* return error */
+    }
+    if (handle->async_state != 0)                                                                              /* check state */
+    {
+        handle->debug_print("sps30: handle is busy.\n");                                                       /* handle is busy */
+        
+        return 5;                                                                                              /* return error */
+    }
+    
+    if (a_sps30_run_command(handle, SPS30_ASYNC_COMMAND_SLEEP, 0, NULL) != 0)                                  /* sleep command */
+    {
+        handle->debug_print("sps30: sleep failed.\n");                                                         /* sleep failed */
+        
+        return 1;                                                                                              /* return error */
+    }
+    
+    return 0;                                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     wake up the chip
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 wake up failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 handle is busy
+ * @note      none
+ */
+uint8_t sps30_wake_up(sps30_handle_t *handle)
+{
+    if (handle == NULL)                                                                                        /* check handle */
+    {
+        return 2;                                                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                                                   /* check handle initialization */
+    {
+        return 3;                                                                                              /* return error */
+    }
+    if (handle->async_state != 0)                                                                              /* check state */
+    {
+        handle->debug_print("sps30: handle is busy.\n");                                                       /* handle is busy */
+        
+        return 5;                                                                                              /* return error */
+    }
+    
+    if (a_sps30_run_command(handle, SPS30_ASYNC_COMMAND_WAKE_UP, 0, NULL) != 0)                                /* wake up command */
+    {
+        handle->debug_print("sps30: wake up failed.\n");                                                       /* wake up failed */
+        
+        return 1;                                                                                              /* return error */
+    }
+    
+    return 0;                                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     start the fan cleaning
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start fan cleaning failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 handle is busy
+ * @note      none
+ */
+uint8_t sps30_start_fan_cleaning(sps30_handle_t *handle)
+{
+    if (handle == NULL)                                                                                         /* check handle */
+    {
+        return 2;                                                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                                                    /* check handle initialization */
+    {
+        return 3;                                                                                               /* return error */
+    }
+    if (handle->async_state != 0)                                                                               /* check state */
+    {
+        handle->debug_print("sps30: handle is busy.\n");                                                        /* handle is busy */
+        
+        return 5;                                                                                               /* return error */
+    }
+    
+    if (a_sps30_run_command(handle, SPS30_ASYNC_COMMAND_START_FAN_CLEANING, 0, NULL) != 0)                      /* start fan cleaning command */
+    {
+        handle->debug_print("sps30: start the fan cleaning failed.\n");                                         /* start the fan cleaning failed */
+        
+        return 1;                                                                                               /* return error */
+    }
+    
+    return 0;                                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     set the auto cleaning interval
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] second interval
+ * @return    status code
+ *            - 0 success
+ *            - 1 set auto cleaning interval failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 second is invalid
+ *            - 5 handle is busy
+ * @note      10 <= second <= 604800
+ */
+uint8_t sps30_set_auto_cleaning_interval(sps30_handle_t *handle, uint32_t second)
+{
+    if (handle == NULL)                                                                                          /* check handle */
+    {
+        return 2;                                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                                /* return error */
+    }
+    if (handle->async_state != 0)                                                                                /* check state */
+    {
+        handle->debug_print("sps30: handle is busy.\n");                                                         /* handle is busy */
+        
+        return 5;                                                                                                /* return error */
+    }
+    if ((second < 10) || (second > 604800))                                                                      /* check second */
+    {
+        handle->debug_print("sps30: second is invalid.\n");                                                      /* second is invalid */
+        
+        return 4;                                                                                                /* return error */
+    }
+    
+    if (a_sps30_run_command(handle, SPS30_ASYNC_COMMAND_SET_AUTO_CLEANING_INTERVAL, second, NULL) != 0)          /* set auto cleaning interval command */
+    {
+        handle->debug_print("sps30: set auto cleaning interval failed.\n");                                      /* set auto cleaning interval failed */
+        
+        return 1;                                                                                                /* return error */
+    }
+    
+    return 0;                                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      get the auto cleaning interval
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[out] *second pointer to an interval buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get auto cleaning interval failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 5 handle is busy
+ * @note       none
+ */
+uint8_t sps30_get_auto_cleaning_interval(sps30_handle_t *handle, uint32_t *second)
+{
+    uint8_t buf[4];
+    
+    if (handle == NULL)                                                                                          /* check handle */
+    {
+        return 2;                                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                                /* return error */
+    }
+    if (handle->async_state != 0)                                                                                /* check state */
+    {
+        handle->debug_print("sps30: handle is busy.\n");                                                         /* handle is busy */
+        
+        return 5;                                                                                                /* return error */
     }
     
-    return e;                                                                                 /* return error code */
+    if (a_sps30_run_command(handle, SPS30_ASYNC_COMMAND_GET_AUTO_CLEANING_INTERVAL, 0, (uint8_t *)buf) != 0)     /* get auto cleaning interval command */
+    {
+        handle->debug_print("sps30: get auto cleaning interval failed.\n");                                      /* get auto cleaning interval failed */
+        
+        return 1;                                                                                                /* return error */
+    }
+    *second = ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) |
+              ((uint32_t)buf[2] << 8) | ((uint32_t)buf[3] << 0);                                                 /* get second */
+    
+    return 0;                                                                                                    /* success return 0 */
 }
 
 /**
- * @brief     set the chip interface
+ * @brief     disable the auto cleaning interval
  * @param[in] *handle pointer to an sps30 handle structure
- * @param[in] interface chip interface
  * @return    status code
  *            - 0 success
+ *            - 1 disable auto cleaning interval failed
  *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 handle is busy
  * @note      none
  */
-uint8_t sps30_set_interface(sps30_handle_t *handle, sps30_interface_t interface) 
+uint8_t sps30_disable_auto_cleaning_interval(sps30_handle_t *handle)
 {
-    if (handle == NULL)                           /* check handle */
+    if (handle == NULL)                                                                                          /* check handle */
     {
-        return 2;                                 /* return error */
+        return 2;                                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                                /* return error */
+    }
+    if (handle->async_state != 0)                                                                                /* check state */
+    {
+        handle->debug_print("sps30: handle is busy.\n");                                                         /* handle is busy */
+        
+        return 5;                                                                                                /* return error */
     }
     
-    handle->iic_uart = (uint8_t)interface;        /* set interface */
+    if (a_sps30_run_command(handle, SPS30_ASYNC_COMMAND_SET_AUTO_CLEANING_INTERVAL, 0, NULL) != 0)               /* set auto cleaning interval command */
+    {
+        handle->debug_print("sps30: set auto cleaning interval failed.\n");                                      /* set auto cleaning interval failed */
+        
+        return 1;                                                                                                /* return error */
+    }
     
-    return 0;                                     /* success return 0 */
+    return 0;                                                                                                    /* success return 0 */
 }
 
 /**
- * @brief      get the chip interface
+ * @brief      get the product type
  * @param[in]  *handle pointer to an sps30 handle structure
- * @param[out] *interface pointer to a chip interface buffer
+ * @param[out] *type pointer to a product type buffer
  * @return     status code
  *             - 0 success
+ *             - 1 get product type failed
  *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 5 handle is busy
  * @note       none
  */
-uint8_t sps30_get_interface(sps30_handle_t *handle, sps30_interface_t *interface) 
+uint8_t sps30_get_product_type(sps30_handle_t *handle, char type[9])
 {
-    if (handle == NULL)                                        /* check handle */
+    uint8_t buf[9];
+    
+    if (handle == NULL)                                                                                                   /* check handle */
     {
-        return 2;                                              /* return error */
+        return 2;                                                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                                                              /* check handle initialization */
+    {
+        return 3;                                                                                                         /* return error */
+    }
+    if (handle->async_state != 0)                                                                                         /* check state */
+    {
+        handle->debug_print("sps30: handle is busy.\n");                                                                  /* handle is busy */
+        
+        return 5;                                                                                                         /* return error */
     }
     
-    *interface = (sps30_interface_t)(handle->iic_uart);        /* get interface */
+    if (a_sps30_run_command(handle, SPS30_ASYNC_COMMAND_GET_PRODUCT_TYPE, 0, (uint8_t *)buf) != 0)                             /* read product type command */
+    {
+        handle->debug_print("sps30: read product type failed.\n");                                                        /* read product type failed */
+        
+        return 1;                                                                                                         /* return error */
+    }
+    memcpy((uint8_t *)type, (uint8_t *)buf, 8);                                                                           /* copy type */
+    type[8] = 0;                                                                                                          /* set NULL */
     
-    return 0;                                                  /* success return 0 */
+    return 0;                                                                                                             /* success return 0 */
 }
 
 /**
- * @brief     start the measurement
- * @param[in] *handle pointer to an sps30 handle structure
- * @param[in] format data format
- * @return    status code
- *            - 0 success
- *            - 1 start measurement failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      get the serial number
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[out] *sn pointer to a serial number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get serial number failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 5 handle is busy
+ * @note       none
  */
-uint8_t sps30_start_measurement(sps30_handle_t *handle, sps30_format_t format)
+uint8_t sps30_get_serial_number(sps30_handle_t *handle, char sn[17])
 {
-    uint8_t res;
+    uint8_t buf[17];
     
     if (handle == NULL)                                                                                                   /* check handle */
     {
@@ -532,1397 +2842,914 @@ uint8_t sps30_start_measurement(sps30_handle_t *handle, sps30_format_t format)
     {
         return 3;                                                                                                         /* return error */
     }
-
-    if (handle->iic_uart != 0)                                                                                            /* uart */
+    if (handle->async_state != 0)                                                                                         /* check state */
     {
-        uint8_t input_buf[6 + 2];
-        uint8_t out_buf[7];
+        handle->debug_print("sps30: handle is busy.\n");                                                                  /* handle is busy */
         
-        input_buf[0] = 0x7E;                                                                                              /* set start */
-        input_buf[1] = 0x00;                                                                                              /* set addr */
-        input_buf[2] = SPS30_UART_COMMAND_START_MEASUREMENT;                                                              /* set command */
-        input_buf[3] = 0x02;                                                                                              /* set length */
-        input_buf[4] = 0x01;                                                                                              /* set 0x01 */
-        input_buf[5] = format;                                                                                            /* set format */
-        handle->format = format;                                                                                          /* save format */
-        input_buf[6] = a_sps30_generate_crc(handle, (uint8_t *)&input_buf[1], 5);                                         /* set crc */
-        input_buf[7] = 0x7E;                                                                                              /* set stop */
-        memset(out_buf, 0, sizeof(uint8_t) * 7);                                                                          /* clear the buffer */
-        res = a_sps30_uart_write_read(handle, (uint8_t *)input_buf, 8, 20, (uint8_t *)out_buf, 7);                        /* write read frame */
-        if (res != 0)                                                                                                     /* check result */
-        {
-            handle->debug_print("sps30: write read failed.\n");                                                           /* write read failed */
-           
-            return 1;                                                                                                     /* return error */
-        }
-        if (out_buf[5] != a_sps30_generate_crc(handle, (uint8_t *)&out_buf[1], 4))                                        /* check crc */
-        {
-            handle->debug_print("sps30: crc check error.\n");                                                             /* crc check error */
-           
-            return 1;                                                                                                     /* return error */
-        }
-        if (a_sps30_uart_error(handle, out_buf[3]) != 0)                                                                  /* check status */
-        {
-            return 1;                                                                                                     /* return error */
-        }
+        return 5;                                                                                                         /* return error */
     }
-    else                                                                                                                  /* iic */
+    
+    if (a_sps30_run_command(handle, SPS30_ASYNC_COMMAND_GET_SERIAL_NUMBER, 0, (uint8_t *)buf) != 0)                            /* read serial number command */
     {
-        uint8_t buf[3];
+        handle->debug_print("sps30: read serial number failed.\n");                                                       /* read serial number failed */
         
-        buf[0] = format;                                                                                                  /* set format */
-        handle->format = format;                                                                                          /* save format */
-        buf[1] = 0x00;                                                                                                    /* set dummy */
-        buf[2] = a_sps30_generate_crc(handle, (uint8_t *)buf, 2);                                                         /* generate crc */
-        res = a_sps30_iic_write(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_START_MEASUREMENT, (uint8_t *)buf, 3, 20);       /* start measurement command */
-        if (res != 0)                                                                                                     /* check result */
-        {
-            handle->debug_print("sps30: start measurement failed.\n");                                                    /* start measurement failed */
-           
-            return 1;                                                                                                     /* return error */
-        }
+        return 1;                                                                                                         /* return error */
     }
+    memcpy((uint8_t *)sn, (uint8_t *)buf, 16);                                                                            /* copy serial number */
+    sn[16] = 0;                                                                                                           /* set NULL */
     
     return 0;                                                                                                             /* success return 0 */
 }
 
 /**
- * @brief     stop the measurement
- * @param[in] *handle pointer to an sps30 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 stop measurement failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      get the version
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[out] *major pointer to a major buffer
+ * @param[out] *minor pointer to a minor buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get version failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 5 handle is busy
+ * @note       none
  */
-uint8_t sps30_stop_measurement(sps30_handle_t *handle)
+uint8_t sps30_get_version(sps30_handle_t *handle, uint8_t *major, uint8_t *minor)
 {
-    uint8_t res;
+    uint8_t buf[7];
     
-    if (handle == NULL)                                                                                        /* check handle */
+    if (handle == NULL)                                                                                            /* check handle */
     {
-        return 2;                                                                                              /* return error */
+        return 2;                                                                                                  /* return error */
     }
-    if (handle->inited != 1)                                                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                                                       /* check handle initialization */
     {
-        return 3;                                                                                              /* return error */
+        return 3;                                                                                                  /* return error */
     }
-
-    if (handle->iic_uart != 0)                                                                                 /* uart */
+    if (handle->async_state != 0)                                                                                  /* check state */
     {
-        uint8_t input_buf[6 + 0];
-        uint8_t out_buf[7];
+        handle->debug_print("sps30: handle is busy.\n");                                                           /* handle is busy */
         
-        input_buf[0] = 0x7E;                                                                                   /* set start */
-        input_buf[1] = 0x00;                                                                                   /* set addr */
-        input_buf[2] = SPS30_UART_COMMAND_STOP_MEASUREMENT;                                                    /* set command */
-        input_buf[3] = 0x00;                                                                                   /* set length */
-        input_buf[4] = a_sps30_generate_crc(handle, (uint8_t *)&input_buf[1], 3);                              /* set crc */
-        input_buf[5] = 0x7E;                                                                                   /* set stop */
-        memset(out_buf, 0, sizeof(uint8_t) * 7);                                                               /* clear the buffer */
-        res = a_sps30_uart_write_read(handle, (uint8_t *)input_buf, 6, 20, (uint8_t *)out_buf, 7);             /* write read frame */
-        if (res != 0)                                                                                          /* check result */
-        {
-            handle->debug_print("sps30: write read failed.\n");                                                /* write read failed */
-           
-            return 1;                                                                                          /* return error */
-        }
-        if (out_buf[5] != a_sps30_generate_crc(handle, (uint8_t *)&out_buf[1], 4))                             /* check crc */
-        {
-            handle->debug_print("sps30: crc check error.\n");                                                  /* crc check error */
-           
-            return 1;                                                                                          /* return error */
-        }
-        if (a_sps30_uart_error(handle, out_buf[3]) != 0)                                                       /* check status */
-        {
-            return 1;                                                                                          /* return error */
-        }
+        return 5;                                                                                                  /* return error */
     }
-    else                                                                                                       /* iic */
+    
+    if (a_sps30_run_command(handle, SPS30_ASYNC_COMMAND_GET_VERSION, 0, (uint8_t *)buf) != 0)                      /* read version command */
     {
-        res = a_sps30_iic_write(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_STOP_MEASUREMENT, NULL, 0, 20);       /* stop measurement command */
-        if (res != 0)                                                                                          /* check result */
-        {
-            handle->debug_print("sps30: stop measurement failed.\n");                                          /* stop measurement failed */
-           
-            return 1;                                                                                          /* return error */
-        }
-    }
+        handle->debug_print("sps30: read version failed.\n");                                                      /* read version failed */
         
-    return 0;                                                                                                  /* success return 0 */
+        return 1;                                                                                                  /* return error */
+    }
+    *major = buf[0];                                                                                               /* set major */
+    *minor = buf[1];                                                                                               /* set minor */
+    
+    return 0;                                                                                                      /* success return 0 */
 }
 
 /**
- * @brief      read the data read flag
+ * @brief      get the device status
  * @param[in]  *handle pointer to an sps30 handle structure
- * @param[out] *flag pointer to a data ready flag buffer
+ * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 read data read flag failed
+ *             - 1 get device status failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 5 handle is busy
  * @note       none
  */
-uint8_t sps30_read_data_flag(sps30_handle_t *handle, sps30_data_ready_flag_t *flag)
+uint8_t sps30_get_device_status(sps30_handle_t *handle, uint32_t *status)
 {
-    uint8_t res;
+    uint8_t buf[5];
     
-    if (handle == NULL)                                                                                                    /* check handle */
+    if (handle == NULL)                                                                                          /* check handle */
     {
-        return 2;                                                                                                          /* return error */
+        return 2;                                                                                                /* return error */
     }
-    if (handle->inited != 1)                                                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                                                     /* check handle initialization */
     {
-        return 3;                                                                                                          /* return error */
+        return 3;                                                                                                /* return error */
     }
-
-    if (handle->iic_uart != 0)                                                                                             /* uart */
+    if (handle->async_state != 0)                                                                                /* check state */
     {
-        handle->debug_print("sps30: uart has no command.\n");                                                              /* uart has no command */
-         
-        return 1;                                                                                                          /* return error */
+        handle->debug_print("sps30: handle is busy.\n");                                                         /* handle is busy */
+        
+        return 5;                                                                                                /* return error */
     }
-    else                                                                                                                   /* iic */
+    
+    if (a_sps30_run_command(handle, SPS30_ASYNC_COMMAND_GET_DEVICE_STATUS, 0, (uint8_t *)buf) != 0)              /* get device status command */
     {
-        uint8_t buf[3];
+        handle->debug_print("sps30: get device status failed.\n");                                               /* get device status failed */
         
-        memset(buf, 0, sizeof(uint8_t) * 3);                                                                               /* clear the buffer */
-        res = a_sps30_iic_read(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_READ_DATA_READY_FLAG, (uint8_t *)buf, 3, 20);      /* read data ready flag command */
-        if (res != 0)                                                                                                      /* check result */
-        {
-            handle->debug_print("sps30: read data ready flag failed.\n");                                                  /* read data ready flag failed */
-           
-            return 1;                                                                                                      /* return error */
-        }
-        if (buf[2] != a_sps30_generate_crc(handle, (uint8_t *)buf, 2))                                                     /* check crc */
-        {
-            handle->debug_print("sps30: crc check failed.\n");                                                             /* crc check failed */
-           
-            return 1;                                                                                                      /* return error */
-        }
-        *flag = (sps30_data_ready_flag_t)(buf[1] & 0x01);                                                                  /* get the data ready flag */
+        return 1;                                                                                                /* return error */
     }
-        
-    return 0;                                                                                                              /* success return 0 */
+    *status = ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) |
+              ((uint32_t)buf[2] << 8) | ((uint32_t)buf[3] << 0);                                                 /* get status */
+    
+    return 0;                                                                                                    /* success return 0 */
 }
 
 /**
- * @brief     enter the sleep mode
+ * @brief     clear the device status
  * @param[in] *handle pointer to an sps30 handle structure
  * @return    status code
  *            - 0 success
- *            - 1 sleep failed
+ *            - 1 clear device status failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 handle is busy
  * @note      none
  */
-uint8_t sps30_sleep(sps30_handle_t *handle)
+uint8_t sps30_clear_device_status(sps30_handle_t *handle)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                                                        /* check handle */
+    if (handle == NULL)                                                                                              /* check handle */
     {
-        return 2;                                                                                              /* return error */
+        return 2;                                                                                                    /* return error */
     }
-    if (handle->inited != 1)                                                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                                                         /* check handle initialization */
     {
-        return 3;                                                                                              /* return error */
+        return 3;                                                                                                    /* return error */
     }
-
-    if (handle->iic_uart != 0)                                                                                 /* uart */
+    if (handle->async_state != 0)                                                                                    /* check state */
     {
-        uint8_t input_buf[6 + 0];
-        uint8_t out_buf[7];
+        handle->debug_print("sps30: handle is busy.\n");                                                             /* handle is busy */
         
-        input_buf[0] = 0x7E;                                                                                   /* set start */
-        input_buf[1] = 0x00;                                                                                   /* set addr */
-        input_buf[2] = SPS30_UART_COMMAND_SLEEP;                                                               /* set command */
-        input_buf[3] = 0x00;                                                                                   /* set length */
-        input_buf[4] = a_sps30_generate_crc(handle, (uint8_t *)&input_buf[1], 3);                              /* set crc */
-        input_buf[5] = 0x7E;                                                                                   /* set stop */
-        memset(out_buf, 0, sizeof(uint8_t) * 7);                                                               /* clear the buffer */
-        res = a_sps30_uart_write_read(handle, (uint8_t *)input_buf, 6, 5, (uint8_t *)out_buf, 7);              /* write read frame */
-        if (res != 0)                                                                                          /* check result */
-        {
-            handle->debug_print("sps30: write read failed.\n");                                                /* write read failed */
-           
-            return 1;                                                                                          /* return error */
-        }
-        if (out_buf[5] != a_sps30_generate_crc(handle, (uint8_t *)&out_buf[1], 4))                             /* check crc */
-        {
-            handle->debug_print("sps30: crc check error.\n");                                                  /* crc check error */
-           
-            return 1;                                                                                          /* return error */
-        }
-        if (a_sps30_uart_error(handle, out_buf[3]) != 0)                                                       /* check status */
-        {
-            return 1;                                                                                          /* return error */
-        }
+        return 5;                                                                                                    /* return error */
     }
-    else                                                                                                       /* iic */
+    
+    if (a_sps30_run_command(handle, SPS30_ASYNC_COMMAND_CLEAR_DEVICE_STATUS, 0, NULL) != 0)                          /* clear device status command */
     {
-        res = a_sps30_iic_write(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_SLEEP, NULL, 0, 5);                   /* sleep command */
-        if (res != 0)                                                                                          /* check result */
-        {
-            handle->debug_print("sps30: sleep failed.\n");                                                     /* sleep failed */
-           
-            return 1;                                                                                          /* return error */
-        }
-    }
+        handle->debug_print("sps30: clear device status failed.\n");                                                 /* clear device status failed */
         
-    return 0;                                                                                                  /* success return 0 */
+        return 1;                                                                                                    /* return error */
+    }
+    
+    return 0;                                                                                                        /* success return 0 */
 }
 
 /**
- * @brief     wake up the chip
+ * @brief     reset the chip
  * @param[in] *handle pointer to an sps30 handle structure
  * @return    status code
  *            - 0 success
- *            - 1 wake up failed
+ *            - 1 reset failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 handle is busy
  * @note      none
  */
-uint8_t sps30_wake_up(sps30_handle_t *handle)
+uint8_t sps30_reset(sps30_handle_t *handle)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                                                        /* check handle */
+    if (handle == NULL)                                                                              /* check handle */
     {
-        return 2;                                                                                              /* return error */
+        return 2;                                                                                    /* return error */
     }
-    if (handle->inited != 1)                                                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                                         /* check handle initialization */
     {
-        return 3;                                                                                              /* return error */
+        return 3;                                                                                    /* return error */
     }
-
-    if (handle->iic_uart != 0)                                                                                 /* uart */
+    if (handle->async_state != 0)                                                                    /* check state */
     {
-        uint8_t input_buf[6 + 0];
-        uint8_t out_buf[7];
-        uint8_t wake_up = 0xFF;
+        handle->debug_print("sps30: handle is busy.\n");                                             /* handle is busy */
         
-        input_buf[0] = 0x7E;                                                                                   /* set start */
-        input_buf[1] = 0x00;                                                                                   /* set addr */
-        input_buf[2] = SPS30_UART_COMMAND_WAKE_UP;                                                             /* set command */
-        input_buf[3] = 0x00;                                                                                   /* set length */
-        input_buf[4] = a_sps30_generate_crc(handle, (uint8_t *)&input_buf[1], 3);                              /* set crc */
-        input_buf[5] = 0x7E;                                                                                   /* set stop */
-        if (handle->uart_write((uint8_t *)&wake_up, 1) != 0)                                                   /* write data */
-        {
-            return 1;                                                                                          /* return error */
-        }
-        memset(out_buf, 0, sizeof(uint8_t) * 7);                                                               /* clear the buffer */
-        res = a_sps30_uart_write_read(handle, (uint8_t *)input_buf, 6, 100, (uint8_t *)out_buf, 7);            /* write read frame */
-        if (res != 0)                                                                                          /* check result */
-        {
-            handle->debug_print("sps30: write read failed.\n");                                                /* write read failed */
-           
-            return 1;                                                                                          /* return error */
-        }
-        if (out_buf[5] != a_sps30_generate_crc(handle, (uint8_t *)&out_buf[1], 4))                             /* check crc */
-        {
-            handle->debug_print("sps30: crc check error.\n");                                                  /* crc check error */
-           
-            return 1;                                                                                          /* return error */
-        }
-        if (a_sps30_uart_error(handle, out_buf[3]) != 0)                                                       /* check status */
-        {
-            return 1;                                                                                          /* return error */
-        }
+        return 5;                                                                                    /* return error */
     }
-    else                                                                                                       /* iic */
+    
+    if (a_sps30_run_command(handle, SPS30_ASYNC_COMMAND_RESET, 0, NULL) != 0)                        /* reset command */
     {
-        (void)a_sps30_iic_write(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_WAKE_UP, NULL, 0, 0);                 /* wake up command */
-        res = a_sps30_iic_write(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_WAKE_UP, NULL, 0, 100);               /* wake up command */
-        if (res != 0)                                                                                          /* check result */
-        {
-            handle->debug_print("sps30: wake up failed.\n");                                                   /* wake up failed */
-           
-            return 1;                                                                                          /* return error */
-        }
-    }
+        handle->debug_print("sps30: reset failed.\n");                                               /* reset failed */
         
-    return 0;                                                                                                  /* success return 0 */
+        return 1;                                                                                    /* return error */
+    }
+    
+    return 0;                                                                                        /* success return 0 */
 }
 
 /**
- * @brief     start the fan cleaning
- * @param[in] *handle pointer to an sps30 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 start fan cleaning failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      read the verified measured values payload
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  count number of fields to read
+ * @param[out] *payload pointer to a big endian payload buffer
+ * @param[out] *size pointer to a payload length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 5 data is not ready
+ * @note       the iic read stops after count fields, the uart frame always carries all fields
  */
-uint8_t sps30_start_fan_cleaning(sps30_handle_t *handle)
+static uint8_t a_sps30_transfer_payload(sps30_handle_t *handle, uint8_t count, uint8_t *payload, uint8_t *size)
 {
     uint8_t res;
+    uint16_t len;
     
-    if (handle == NULL)                                                                                         /* check handle */
-    {
-        return 2;                                                                                               /* return error */
-    }
-    if (handle->inited != 1)                                                                                    /* check handle initialization */
-    {
-        return 3;                                                                                               /* return error */
-    }
-
-    if (handle->iic_uart != 0)                                                                                  /* uart */
+    len = (handle->format == SPS30_FORMAT_IEEE754) ? 40 : 20;                                                                   /* set the payload length */
+    if (handle->iic_uart != 0)                                                                                                  /* uart */
     {
-        uint8_t input_buf[6 + 0];
-        uint8_t out_buf[7];
+#if (SPS30_ENABLE_UART == 1)
+        uint8_t out_buf[7 + 40];
         
-        input_buf[0] = 0x7E;                                                                                    /* set start */
-        input_buf[1] = 0x00;                                                                                    /* set addr */
-        input_buf[2] = SPS30_UART_COMMAND_START_FAN_CLEANING;                                                   /* set command */
-        input_buf[3] = 0x00;                                                                                    /* set length */
-        input_buf[4] = a_sps30_generate_crc(handle, (uint8_t *)&input_buf[1], 3);                               /* set crc */
-        input_buf[5] = 0x7E;                                                                                    /* set stop */
-        memset(out_buf, 0, sizeof(uint8_t) * 7);                                                                /* clear the buffer */
-        res = a_sps30_uart_write_read(handle, (uint8_t *)input_buf, 6, 20, (uint8_t *)out_buf, 7);              /* write read frame */
-        if (res != 0)                                                                                           /* check result */
+        res = a_sps30_uart_write_read_frame(handle, SPS30_UART_FRAME_READ_MEASURED_VALUES,
+                                            SPS30_TIMING_READ_MEASURED_VALUES, (uint8_t *)out_buf, 7 + len);                    /* write read frame */
+        if (res != 0)                                                                                                           /* check result */
         {
-            handle->debug_print("sps30: write read failed.\n");                                                 /* write read failed */
+            handle->debug_print("sps30: write read failed.\n");                                                                 /* write read failed */
            
-            return 1;                                                                                           /* return error */
+            return 1;                                                                                                           /* return error */
+        }
+        if (a_sps30_uart_check_frame(handle, (uint8_t *)out_buf, 7 + len) != 0)                                             /* check the frame */
+        {
+            return 1;                                                                                                           /* return error */
         }
-        if (out_buf[5] != a_sps30_generate_crc(handle, (uint8_t *)&out_buf[1], 4))                              /* check crc */
+        memcpy(payload, (uint8_t *)&out_buf[5], len);                                                                           /* copy the payload */
+#endif
+    }
+    else                                                                                                                        /* iic */
+    {
+#if (SPS30_ENABLE_IIC == 1)
+        uint8_t check[3];
+        uint8_t buf[60];
+        
+        if (handle->read_mode == SPS30_READ_MODE_CHECK_FLAG)                                                                    /* check the flag first */
         {
-            handle->debug_print("sps30: crc check error.\n");                                                   /* crc check error */
+            memset(check, 0, sizeof(uint8_t) * 3);                                                                              /* clear the buffer */
+            res = a_sps30_iic_read(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_READ_DATA_READY_FLAG, (uint8_t *)check, 3,
+                                   SPS30_TIMING_READ_DATA_READY_FLAG);                                                          /* read data ready flag command */
+            if (res != 0)                                                                                                       /* check result */
+            {
+                handle->debug_print("sps30: read data ready flag failed.\n");                                                   /* read data ready flag failed */
+           
+                return 1;                                                                                                       /* return error */
+            }
+            if (check[2] != a_sps30_iic_crc((uint8_t *)check, 2))                                                               /* check crc */
+            {
+                a_sps30_stats_crc(handle);                                                                                      /* count the crc error */
+                handle->debug_print("sps30: crc check failed.\n");                                                              /* crc check failed */
            
-            return 1;                                                                                           /* return error */
+                return 1;                                                                                                       /* return error */
+            }
+            if ((check[1] & 0x01) == 0)                                                                                         /* check flag */
+            {
+                return 5;                                                                                                       /* data is not ready */
+            }
         }
-        if (a_sps30_uart_error(handle, out_buf[3]) != 0)                                                        /* check status */
+        len = (handle->format == SPS30_FORMAT_IEEE754) ? (count * 4) : (count * 2);                                             /* stop after the last field */
+        memset(buf, 0, sizeof(uint8_t) * 60);                                                                                   /* clear the buffer */
+        res = a_sps30_iic_read(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_READ_MEASURED_VALUES, (uint8_t *)buf,
+                               (uint16_t)(len / 2 * 3), SPS30_TIMING_READ_MEASURED_VALUES);                                     /* read measured values command */
+        if (res != 0)                                                                                                           /* check result */
         {
-            return 1;                                                                                           /* return error */
+            handle->debug_print("sps30: read measured values failed.\n");                                                       /* read measured values failed */
+           
+            return 1;                                                                                                           /* return error */
         }
-    }
-    else                                                                                                        /* iic */
-    {
-        res = a_sps30_iic_write(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_START_FAN_CLEANING, NULL, 0, 20);      /* start the fan cleaning command */
-        if (res != 0)                                                                                           /* check result */
+        if (a_sps30_iic_get_payload((uint8_t *)buf, len / 2) != 0)                                                              /* check crc */
         {
-            handle->debug_print("sps30: start the fan cleaning failed.\n");                                     /* start the fan cleaning failed */
+            a_sps30_stats_crc(handle);                                                                                          /* count the crc error */
+            handle->debug_print("sps30: crc is error.\n");                                                                      /* crc is error */
            
-            return 1;                                                                                           /* return error */
+            return 1;                                                                                                           /* return error */
         }
+        memcpy(payload, (uint8_t *)buf, len);                                                                                   /* copy the payload */
+#else
+        (void)count;                                                                                                            /* only iic stops early */
+#endif
     }
-        
-    return 0;                                                                                                   /* success return 0 */
+    *size = (uint8_t)len;                                                                                                       /* save the payload length */
+    
+    return 0;                                                                                                                   /* success return 0 */
 }
 
 /**
- * @brief     set the auto cleaning interval
- * @param[in] *handle pointer to an sps30 handle structure
- * @param[in] second interval
- * @return    status code
- *            - 0 success
- *            - 1 set auto cleaning interval failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 second is invalid
- * @note      10 <= second <= 604800
+ * @brief      read the verified measured values payload and count the stats
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  *now_ms pointer to the caller time in ms, NULL for the linked clock
+ * @param[in]  count number of fields to read
+ * @param[out] *payload pointer to a big endian payload buffer
+ * @param[out] *size pointer to a payload length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 5 data is not ready
+ * @note       the latency is the elapsed time of the linked now_us clock,
+ *             else the delay time spent by the driver,
+ *             in the direct mode a read within 1 s of the last one is refused without any bus transaction,
+ *             the read is trusted when neither the caller time nor the linked clock is known
  */
-uint8_t sps30_set_auto_cleaning_interval(sps30_handle_t *handle, uint32_t second)
+static uint8_t a_sps30_read_payload(sps30_handle_t *handle, const uint32_t *now_ms,
+                                    uint8_t count, uint8_t *payload, uint8_t *size)
 {
     uint8_t res;
+    uint32_t ms;
+#if (SPS30_ENABLE_STATS == 1)
+    uint32_t begin;
+#endif
     
-    if (handle == NULL)                                                                                          /* check handle */
+    if ((now_ms == NULL) && (a_sps30_clock_us(handle, &ms) == 0))                                     /* check the linked clock */
     {
-        return 2;                                                                                                /* return error */
+        ms = ms / 1000;                                                                               /* convert to ms */
+        now_ms = &ms;                                                                                 /* use the clock time */
     }
-    if (handle->inited != 1)                                                                                     /* check handle initialization */
+    if ((now_ms != NULL) && (handle->read_mode == SPS30_READ_MODE_DIRECT) &&
+        (handle->read_valid != 0) && ((uint32_t)(*now_ms - handle->read_last_ms) < 1000))             /* check the cadence */
     {
-        return 3;                                                                                                /* return error */
+        return 5;                                                                                     /* data is not ready */
     }
-    if ((second < 10) || (second > 604800))                                                                      /* check second */
+#if (SPS30_ENABLE_STATS == 1)
+    begin = a_sps30_time_us(handle);                                                                  /* get the begin time */
+    res = a_sps30_transfer_payload(handle, count, payload, size);                                     /* transfer the payload */
+    a_sps30_stats_command(handle, SPS30_TIMING_READ_MEASURED_VALUES, res,
+                          (a_sps30_time_us(handle) - begin) / 1000);                                  /* count the read */
+#else
+    res = a_sps30_transfer_payload(handle, count, payload, size);                                     /* transfer the payload */
+#endif
+    if ((res == 0) && (now_ms != NULL))                                                               /* new sample */
     {
-        handle->debug_print("sps30: second is invalid.\n");                                                      /* second is invalid */
-           
-        return 4;                                                                                                /* return error */
+        handle->read_last_ms = *now_ms;                                                               /* save the read time */
+        handle->read_valid = 1;                                                                       /* flag the read time */
     }
     
-    if (handle->iic_uart != 0)                                                                                   /* uart */
-    {
-        uint8_t input_buf[6 + 5];
-        uint8_t out_buf[7];
-        
-        input_buf[0] = 0x7E;                                                                                     /* set start */
-        input_buf[1] = 0x00;                                                                                     /* set addr */
-        input_buf[2] = SPS30_UART_COMMAND_READ_WRITE_AUTO_CLEANING_INTERVAL;                                     /* set command */
-        input_buf[3] = 0x05;                                                                                     /* set length */
-        input_buf[4] = 0x00;                                                                                     /* set 0x00 */
-        input_buf[5] = (second >> 24) & 0xFF;                                                                    /* set 32 - 24 bits */
-        input_buf[6] = (second >> 16) & 0xFF;                                                                    /* set 24 - 16 bits */
-        input_buf[7] = (second >> 8) & 0xFF;                                                                     /* set 16 - 8 bits */
-        input_buf[8] = (second >> 0) & 0xFF;                                                                     /* set 8 - 0 bits */
-        input_buf[9] = a_sps30_generate_crc(handle, (uint8_t *)&input_buf[1], 8);                                /* set crc */
-        input_buf[10] = 0x7E;                                                                                    /* set stop */
-        memset(out_buf, 0, sizeof(uint8_t) * 7);                                                                 /* clear the buffer */
-        res = a_sps30_uart_write_read(handle, (uint8_t *)input_buf, 11, 20, (uint8_t *)out_buf, 7);              /* write read frame */
-        if (res != 0)                                                                                            /* check result */
-        {
-            handle->debug_print("sps30: write read failed.\n");                                                  /* write read failed */
-           
-            return 1;                                                                                            /* return error */
-        }
-        if (out_buf[5] != a_sps30_generate_crc(handle, (uint8_t *)&out_buf[1], 4))                               /* check crc */
-        {
-            handle->debug_print("sps30: crc check error.\n");                                                    /* crc check error */
-           
-            return 1;                                                                                            /* return error */
-        }
-        if (a_sps30_uart_error(handle, out_buf[3]) != 0)                                                         /* check status */
-        {
-            return 1;                                                                                            /* return error */
-        }
-    }
-    else                                                                                                         /* iic */
-    {
-        uint8_t buf[6];
-        
-        buf[0] = (second >> 24) & 0xFF;                                                                          /* set byte 4 */
-        buf[1] = (second >> 16) & 0xFF;                                                                          /* set byte 3 */
-        buf[2] = a_sps30_generate_crc(handle, (uint8_t *)&buf[0], 2);                                            /* set crc */
-        buf[3] = (second >> 8) & 0xFF;                                                                           /* set byte 2 */
-        buf[4] = (second >> 0) & 0xFF;                                                                           /* set byte 1 */
-        buf[5] = a_sps30_generate_crc(handle, (uint8_t *)&buf[3], 2);                                            /* set crc */
-        res = a_sps30_iic_write(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_READ_WRITE_AUTO_CLEANING_INTERVAL, 
-                               (uint8_t *)buf, 6, 20);                                                           /* set auto cleaning interval command */
-        if (res != 0)                                                                                            /* check result */
-        {
-            handle->debug_print("sps30: set auto cleaning interval failed.\n");                                  /* set auto cleaning interval failed */
-           
-            return 1;                                                                                            /* return error */
-        }
-    }
-        
-    return 0;                                                                                                    /* success return 0 */
+    return res;                                                                                       /* return the result */
 }
 
+#if (SPS30_ENABLE_FLOAT == 1)
 /**
- * @brief      get the auto cleaning interval
+ * @brief      read the result
  * @param[in]  *handle pointer to an sps30 handle structure
- * @param[out] *second pointer to an interval buffer
+ * @param[out] *pm pointer to an sps30 pm structure
  * @return     status code
  *             - 0 success
- *             - 1 get auto cleaning interval failed
+ *             - 1 read failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 4 mode is invalid
+ *             - 5 data is not ready or handle is busy
  * @note       none
  */
-uint8_t sps30_get_auto_cleaning_interval(sps30_handle_t *handle, uint32_t *second)
+uint8_t sps30_read(sps30_handle_t *handle, sps30_pm_t *pm)
+{
+    return sps30_read_fields(handle, SPS30_FIELD_ALL, pm);        /* read all fields */
+}
+
+/**
+ * @brief      read the selected fields of the result
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  mask or of the sps30_field_t fields
+ * @param[out] *pm pointer to an sps30 pm structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 mode is invalid
+ *             - 5 data is not ready or handle is busy
+ *             - 6 mask is invalid
+ * @note       the iic read stops after the last selected field, so the mass
+ *             concentrations alone take 40% of the full transfer,
+ *             the fields not selected are left unchanged in pm
+ */
+uint8_t sps30_read_fields(sps30_handle_t *handle, uint16_t mask, sps30_pm_t *pm)
 {
     uint8_t res;
+    uint8_t count;
+    uint8_t len;
+    uint8_t payload[40];
     
-    if (handle == NULL)                                                                                          /* check handle */
+    if ((handle == NULL) || (pm == NULL))                                                                                       /* check handle */
     {
-        return 2;                                                                                                /* return error */
+        return 2;                                                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                                                                    /* check handle initialization */
     {
-        return 3;                                                                                                /* return error */
+        return 3;                                                                                                               /* return error */
     }
-    
-    if (handle->iic_uart != 0)                                                                                   /* uart */
+    if (handle->async_state != 0)                                                                                               /* check state */
     {
-        uint8_t input_buf[6 + 1];
-        uint8_t out_buf[7 + 4];
+        handle->debug_print("sps30: handle is busy.\n");                                                                        /* handle is busy */
         
-        input_buf[0] = 0x7E;                                                                                     /* set start */
-        input_buf[1] = 0x00;                                                                                     /* set addr */
-        input_buf[2] = SPS30_UART_COMMAND_READ_WRITE_AUTO_CLEANING_INTERVAL;                                     /* set command */
-        input_buf[3] = 0x01;                                                                                     /* set length */
-        input_buf[4] = 0x00;                                                                                     /* set length */
-        input_buf[5] = a_sps30_generate_crc(handle, (uint8_t *)&input_buf[1], 4);                                /* set crc */
-        input_buf[6] = 0x7E;                                                                                     /* set stop */
-        memset(out_buf, 0, sizeof(uint8_t) * 11);                                                                /* clear the buffer */
-        res = a_sps30_uart_write_read(handle, (uint8_t *)input_buf, 7, 20, (uint8_t *)out_buf, 11);              /* write read frame */
-        if (res != 0)                                                                                            /* check result */
-        {
-            handle->debug_print("sps30: write read failed.\n");                                                  /* write read failed */
-           
-            return 1;                                                                                            /* return error */
-        }
-        if (out_buf[9] != a_sps30_generate_crc(handle, (uint8_t *)&out_buf[1], 8))                               /* check crc */
-        {
-            handle->debug_print("sps30: crc check error.\n");                                                    /* crc check error */
-           
-            return 1;                                                                                            /* return error */
-        }
-        if (a_sps30_uart_error(handle, out_buf[3]) != 0)                                                         /* check status */
-        {
-            return 1;                                                                                            /* return error */
-        }
-        *second = ((uint32_t)out_buf[5] << 24) | ((uint32_t)out_buf[6] << 16) | 
-                  ((uint32_t)out_buf[7] << 8) | ((uint32_t)out_buf[8] << 0);                                     /* get second */
+        return 5;                                                                                                               /* return error */
     }
-    else                                                                                                         /* iic */
+    if ((handle->format != SPS30_FORMAT_IEEE754) && (handle->format != SPS30_FORMAT_UINT16))                                    /* check format */
     {
-        uint8_t buf[6];
-        
-        memset(buf, 0, sizeof(uint8_t) * 6);                                                                     /* clear the buffer */
-        res = a_sps30_iic_read(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_READ_WRITE_AUTO_CLEANING_INTERVAL, 
-                              (uint8_t *)buf, 6, 20);                                                            /* get auto cleaning interval command */
-        if (res != 0)                                                                                            /* check result */
-        {
-            handle->debug_print("sps30: get auto cleaning interval failed.\n");                                  /* get auto cleaning interval failed */
-           
-            return 1;                                                                                            /* return error */
-        }
-        if (buf[2] != a_sps30_generate_crc(handle, (uint8_t *)&buf[0], 2))                                       /* check crc */
-        {
-            handle->debug_print("sps30: crc is error.\n");                                                       /* crc is error */
-           
-            return 1;                                                                                            /* return error */
-        }
-        if (buf[5] != a_sps30_generate_crc(handle, (uint8_t *)&buf[3], 2))                                       /* check crc */
-        {
-            handle->debug_print("sps30: crc is error.\n");                                                       /* crc is error */
-           
-            return 1;                                                                                            /* return error */
-        }
-        *second = ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) | 
-                  ((uint32_t)buf[3] << 8) | ((uint32_t)buf[4] << 0);                                             /* get second */
+        handle->debug_print("sps30: mode is invalid.\n");                                                                       /* mode is invalid */
+       
+        return 4;                                                                                                               /* return error */
     }
-        
-    return 0;                                                                                                    /* success return 0 */
+    if ((mask & SPS30_FIELD_ALL) == 0)                                                                                          /* check mask */
+    {
+        handle->debug_print("sps30: mask is invalid.\n");                                                                       /* mask is invalid */
+       
+        return 6;                                                                                                               /* return error */
+    }
+    
+    count = 10;                                                                                                                 /* init 10 */
+    while ((mask & (1 << (count - 1))) == 0)                                                                                    /* find the last field */
+    {
+        count--;                                                                                                                /* count-- */
+    }
+    res = a_sps30_read_payload(handle, NULL, count, (uint8_t *)payload, (uint8_t *)&len);                                       /* read the payload */
+    if (res != 0)                                                                                                               /* check result */
+    {
+        return res;                                                                                                             /* return the result */
+    }
+    a_sps30_decode_pm(handle->format, (uint8_t *)payload, mask, pm);                                                            /* decode the values */
+    
+    return 0;                                                                                                                   /* success return 0 */
 }
+#endif
 
 /**
- * @brief     disable the auto cleaning interval
- * @param[in] *handle pointer to an sps30 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 disable auto cleaning interval failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      read the result without decoding at a time
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  *now_ms pointer to the caller time in ms, NULL for the linked clock
+ * @param[out] *raw pointer to an sps30 raw sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 mode is invalid
+ *             - 5 data is not ready or handle is busy
+ * @note       none
  */
-uint8_t sps30_disable_auto_cleaning_interval(sps30_handle_t *handle)
+static uint8_t a_sps30_read_raw(sps30_handle_t *handle, const uint32_t *now_ms, sps30_raw_sample_t *raw)
 {
     uint8_t res;
-    uint32_t second;
+    uint8_t len;
     
-    if (handle == NULL)                                                                                          /* check handle */
+    if ((handle == NULL) || (raw == NULL))                                                                                      /* check handle */
     {
-        return 2;                                                                                                /* return error */
+        return 2;                                                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                                                                    /* check handle initialization */
     {
-        return 3;                                                                                                /* return error */
+        return 3;                                                                                                               /* return error */
     }
-    
-    if (handle->iic_uart != 0)                                                                                   /* uart */
+    if (handle->async_state != 0)                                                                                               /* check state */
     {
-        uint8_t input_buf[6 + 5];
-        uint8_t out_buf[7];
-        
-        second = 0;                                                                                              /* disable second */
-        input_buf[0] = 0x7E;                                                                                     /* set start */
-        input_buf[1] = 0x00;                                                                                     /* set addr */
-        input_buf[2] = SPS30_UART_COMMAND_READ_WRITE_AUTO_CLEANING_INTERVAL;                                     /* set command */
-        input_buf[3] = 0x05;                                                                                     /* set length */
-        input_buf[4] = 0x00;                                                                                     /* set length */
-        input_buf[5] = (second >> 24) & 0xFF;                                                                    /* set 32 - 24 bits */
-        input_buf[6] = (second >> 16) & 0xFF;                                                                    /* set 24 - 16 bits */
-        input_buf[7] = (second >> 8) & 0xFF;                                                                     /* set 16 - 8 bits */
-        input_buf[8] = (second >> 0) & 0xFF;                                                                     /* set 8 - 0 bits */
-        input_buf[9] = a_sps30_generate_crc(handle, (uint8_t *)&input_buf[1], 8);                                /* set crc */
-        input_buf[10] = 0x7E;                                                                                    /* set stop */
-        memset(out_buf, 0, sizeof(uint8_t) * 7);                                                                 /* clear the buffer */
-        res = a_sps30_uart_write_read(handle, (uint8_t *)input_buf, 11, 20, (uint8_t *)out_buf, 7);              /* write read frame */
-        if (res != 0)                                                                                            /* check result */
-        {
-            handle->debug_print("sps30: write read failed.\n");                                                  /* write read failed */
-           
-            return 1;                                                                                            /* return error */
-        }
-        if (out_buf[5] != a_sps30_generate_crc(handle, (uint8_t *)&out_buf[1], 4))                               /* check crc */
-        {
-            handle->debug_print("sps30: crc check error.\n");                                                    /* crc check error */
-           
-            return 1;                                                                                            /* return error */
-        }
-        if (a_sps30_uart_error(handle, out_buf[3]) != 0)                                                         /* check status */
-        {
-            return 1;                                                                                            /* return error */
-        }
+        handle->debug_print("sps30: handle is busy.\n");                                                                        /* handle is busy */
+        
+        return 5;                                                                                                               /* return error */
     }
-    else                                                                                                         /* iic */
+    if ((handle->format != SPS30_FORMAT_IEEE754) && (handle->format != SPS30_FORMAT_UINT16))                                    /* check format */
     {
-        uint8_t buf[6];
-        
-        second = 0;                                                                                              /* disable second */
-        buf[0] = (second >> 24) & 0xFF;                                                                          /* set byte 4 */
-        buf[1] = (second >> 16) & 0xFF;                                                                          /* set byte 3 */
-        buf[2] = a_sps30_generate_crc(handle, (uint8_t *)&buf[0], 2);                                            /* set crc */
-        buf[3] = (second >> 8) & 0xFF;                                                                           /* set byte 2 */
-        buf[4] = (second >> 0) & 0xFF;                                                                           /* set byte 1 */
-        buf[5] = a_sps30_generate_crc(handle, (uint8_t *)&buf[3], 2);                                            /* set crc */
-        res = a_sps30_iic_write(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_READ_WRITE_AUTO_CLEANING_INTERVAL, 
-                               (uint8_t *)buf, 6, 20);                                                           /* set auto cleaning interval command */
-        if (res != 0)                                                                                            /* check result */
-        {
-            handle->debug_print("sps30: set auto cleaning interval failed.\n");                                  /* set auto cleaning interval failed */
-           
-            return 1;                                                                                            /* return error */
-        }
+        handle->debug_print("sps30: mode is invalid.\n");                                                                       /* mode is invalid */
+       
+        return 4;                                                                                                               /* return error */
     }
-        
-    return 0;                                                                                                    /* success return 0 */
+    
+    res = a_sps30_read_payload(handle, now_ms, 10, (uint8_t *)raw->payload, (uint8_t *)&len);                                   /* read the payload */
+    if (res != 0)                                                                                                               /* check result */
+    {
+        return res;                                                                                                             /* return the result */
+    }
+    raw->format = (uint8_t)(handle->format);                                                                                    /* save the format */
+    raw->len = len;                                                                                                             /* save the payload length */
+    
+    return 0;                                                                                                                   /* success return 0 */
 }
 
 /**
- * @brief      get the product type
+ * @brief      read the result without decoding
  * @param[in]  *handle pointer to an sps30 handle structure
- * @param[out] *type pointer to a product type buffer
+ * @param[out] *raw pointer to an sps30 raw sample structure
  * @return     status code
  *             - 0 success
- *             - 1 get product type failed
+ *             - 1 read failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 4 mode is invalid
+ *             - 5 data is not ready or handle is busy
+ * @note       the payload is checked and stored as it is, decode it later with sps30_decode_raw
  */
-uint8_t sps30_get_product_type(sps30_handle_t *handle, char type[9])
+uint8_t sps30_read_raw(sps30_handle_t *handle, sps30_raw_sample_t *raw)
+{
+    return a_sps30_read_raw(handle, NULL, raw);        /* read with the linked clock */
+}
+
+/**
+ * @brief      read the result without decoding at the caller time
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  now_ms current time in ms
+ * @param[out] *raw pointer to an sps30 raw sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 mode is invalid
+ *             - 5 data is not ready or handle is busy
+ * @note       in the direct mode a read within 1 s of the last one is refused
+ *             without any bus transaction, like sps30_read_begin
+ */
+uint8_t sps30_read_direct(sps30_handle_t *handle, uint32_t now_ms, sps30_raw_sample_t *raw)
+{
+    return a_sps30_read_raw(handle, &now_ms, raw);     /* read at the caller time */
+}
+
+/**
+ * @brief      read the result as integers
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[out] *pm pointer to an sps30 pm u16 structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 mode is invalid
+ *             - 5 data is not ready or handle is busy
+ * @note       the measurement must be started with SPS30_FORMAT_UINT16
+ */
+uint8_t sps30_read_u16(sps30_handle_t *handle, sps30_pm_u16_t *pm)
 {
-    uint8_t res, i, j;
+    uint8_t res;
+    uint8_t len;
+    uint8_t payload[20];
     
-    if (handle == NULL)                                                                                                   /* check handle */
+    if ((handle == NULL) || (pm == NULL))                                                                                       /* check handle */
     {
-        return 2;                                                                                                         /* return error */
+        return 2;                                                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                                                                    /* check handle initialization */
     {
-        return 3;                                                                                                         /* return error */
+        return 3;                                                                                                               /* return error */
     }
-    
-    if (handle->iic_uart != 0)                                                                                            /* uart */
+    if (handle->async_state != 0)                                                                                               /* check state */
     {
-        uint8_t input_buf[6 + 1];
-        uint8_t out_buf[7 + 9];
+        handle->debug_print("sps30: handle is busy.\n");                                                                        /* handle is busy */
         
-        input_buf[0] = 0x7E;                                                                                              /* set start */
-        input_buf[1] = 0x00;                                                                                              /* set addr */
-        input_buf[2] = SPS30_UART_COMMAND_READ_PRODUCT_TYPE;                                                              /* set command */
-        input_buf[3] = 0x01;                                                                                              /* set length */
-        input_buf[4] = 0x00;                                                                                              /* set length */
-        input_buf[5] = a_sps30_generate_crc(handle, (uint8_t *)&input_buf[1], 4);                                         /* set crc */
-        input_buf[6] = 0x7E;                                                                                              /* set stop */
-        memset(out_buf, 0, sizeof(uint8_t) * 16);                                                                         /* clear the buffer */
-        res = a_sps30_uart_write_read(handle, (uint8_t *)input_buf, 7, 20, (uint8_t *)out_buf, 16);                       /* write read frame */
-        if (res != 0)                                                                                                     /* check result */
-        {
-            handle->debug_print("sps30: write read failed.\n");                                                           /* write read failed */
-           
-            return 1;                                                                                                     /* return error */
-        }
-        if (out_buf[14] != a_sps30_generate_crc(handle, (uint8_t *)&out_buf[1], 13))                                      /* check crc */
-        {
-            handle->debug_print("sps30: crc check error.\n");                                                             /* crc check error */
-           
-            return 1;                                                                                                     /* return error */
-        }
-        if (a_sps30_uart_error(handle, out_buf[3]) != 0)                                                                  /* check status */
-        {
-            return 1;                                                                                                     /* return error */
-        }
-        memcpy((uint8_t *)type, (uint8_t *)&out_buf[5], 9);                                                               /* copy data*/
+        return 5;                                                                                                               /* return error */
     }
-    else                                                                                                                  /* iic */
+    if (handle->format != SPS30_FORMAT_UINT16)                                                                                  /* check format */
     {
-        uint8_t buf[12];
-        
-        memset(buf, 0, sizeof(uint8_t) * 12);                                                                             /* clear the buffer */
-        res = a_sps30_iic_read(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_READ_PRODUCT_TYPE, (uint8_t *)buf, 12, 20);       /* read product type command */
-        if (res != 0)                                                                                                     /* check result */
-        {
-            handle->debug_print("sps30: read product type failed.\n");                                                    /* read product type failed */
-           
-            return 1;                                                                                                     /* return error */
-        }
-        for (i = 0; i < 4; i++)                                                                                           /* check crc */
-        {
-            if (buf[i * 3 + 2] != a_sps30_generate_crc(handle, (uint8_t *)&buf[i * 3], 2))                                /* check crc */
-            {
-                handle->debug_print("sps30: crc is error.\n");                                                            /* crc is error */
-               
-                return 1;                                                                                                 /* return error */
-            }
-        }
-        j = 0;                                                                                                            /* set zero */
-        for (i = 0; i < 4; i++)                                                                                           /* copy type */
-        {
-            type[j] = buf[i * 3 + 0];                                                                                     /* set type */
-            j++;                                                                                                          /* j++ */
-            type[j] = buf[i * 3 + 1];                                                                                     /* set type */
-            j++;                                                                                                          /* j++ */
-        }
-        type[j] = 0;                                                                                                      /* set type */
+        handle->debug_print("sps30: mode is invalid.\n");                                                                       /* mode is invalid */
+       
+        return 4;                                                                                                               /* return error */
+    }
+    
+    res = a_sps30_read_payload(handle, NULL, 10, (uint8_t *)payload, (uint8_t *)&len);                                          /* read the payload */
+    if (res != 0)                                                                                                               /* check result */
+    {
+        return res;                                                                                                             /* return the result */
     }
-        
-    return 0;                                                                                                             /* success return 0 */
+    a_sps30_decode_pm_u16((uint8_t *)payload, pm);                                                                              /* decode the values */
+    
+    return 0;                                                                                                                   /* success return 0 */
 }
 
 /**
- * @brief      get the serial number
- * @param[in]  *handle pointer to an sps30 handle structure
- * @param[out] *sn pointer to a serial number buffer
- * @return     status code
- *             - 0 success
- *             - 1 get serial number failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     begin a command without blocking
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] command async command
+ * @param[in] param command param
+ * @param[in] now_ms current time in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 begin failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 command or param is invalid
+ *            - 5 handle is busy
+ * @note      now_ms can be any free running ms counter and may wrap around
  */
-uint8_t sps30_get_serial_number(sps30_handle_t *handle, char sn[17])
+uint8_t sps30_async_begin(sps30_handle_t *handle, sps30_async_command_t command, uint32_t param, uint32_t now_ms)
 {
-    uint8_t res, i, j;
+    uint8_t timing;
     
-    if (handle == NULL)                                                                                                   /* check handle */
+    if (handle == NULL)                                                                                 /* check handle */
     {
-        return 2;                                                                                                         /* return error */
+        return 2;                                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                                            /* check handle initialization */
     {
-        return 3;                                                                                                         /* return error */
+        return 3;                                                                                       /* return error */
     }
-    
-    if (handle->iic_uart != 0)                                                                                            /* uart */
+    if (command > SPS30_ASYNC_COMMAND_GET_SERIAL_NUMBER)                                                /* check command */
     {
-        uint8_t input_buf[6 + 1];
-        uint8_t out_buf[7 + 17];
+        handle->debug_print("sps30: command is invalid.\n");                                            /* command is invalid */
         
-        input_buf[0] = 0x7E;                                                                                              /* set start */
-        input_buf[1] = 0x00;                                                                                              /* set addr */
-        input_buf[2] = SPS30_UART_COMMAND_READ_PRODUCT_TYPE;                                                              /* set command */
-        input_buf[3] = 0x01;                                                                                              /* set length */
-        input_buf[4] = 0x03;                                                                                              /* set command */
-        input_buf[5] = a_sps30_generate_crc(handle, (uint8_t *)&input_buf[1], 4);                                         /* set crc */
-        input_buf[6] = 0x7E;                                                                                              /* set stop */
-        memset(out_buf, 0, sizeof(uint8_t) * 24);                                                                         /* clear the buffer */
-        res = a_sps30_uart_write_read(handle, (uint8_t *)input_buf, 7, 20, (uint8_t *)out_buf, 24);                       /* write read frame */
-        if (res != 0)                                                                                                     /* check result */
-        {
-            handle->debug_print("sps30: write read failed.\n");                                                           /* write read failed */
-           
-            return 1;                                                                                                     /* return error */
-        }
-        if (out_buf[22] != a_sps30_generate_crc(handle, (uint8_t *)&out_buf[1], 21))                                      /* check crc */
-        {
-            handle->debug_print("sps30: crc check error.\n");                                                             /* crc check error */
-           
-            return 1;                                                                                                     /* return error */
-        }
-        if (a_sps30_uart_error(handle, out_buf[3]) != 0)                                                                  /* check status */
+        return 4;                                                                                       /* return error */
+    }
+    if (handle->async_state != 0)                                                                       /* check state */
+    {
+        handle->debug_print("sps30: handle is busy.\n");                                                /* handle is busy */
+        
+        return 5;                                                                                       /* return error */
+    }
+    
+    if (command == SPS30_ASYNC_COMMAND_READ)                                                            /* read */
+    {
+        if ((handle->format != SPS30_FORMAT_IEEE754) && (handle->format != SPS30_FORMAT_UINT16))        /* check format */
         {
-            return 1;                                                                                                     /* return error */
+            handle->debug_print("sps30: mode is invalid.\n");                                           /* mode is invalid */
+            
+            return 4;                                                                                   /* return error */
         }
-        memcpy((uint8_t *)sn, (uint8_t *)&out_buf[5], 17);                                                                /* copy data*/
     }
-    else                                                                                                                  /* iic */
+    else if (command == SPS30_ASYNC_COMMAND_READ_DATA_FLAG)                                             /* read data flag */
     {
-        uint8_t buf[24];
-        
-        memset(buf, 0, sizeof(uint8_t) * 24);                                                                             /* clear the buffer */
-        res = a_sps30_iic_read(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_READ_SERIAL_NUMBER, (uint8_t *)buf, 24, 20);      /* read serial number command */
-        if (res != 0)                                                                                                     /* check result */
+        if (handle->iic_uart != 0)                                                                      /* uart */
         {
-            handle->debug_print("sps30: read serial number failed.\n");                                                   /* read serial number failed */
-           
-            return 1;                                                                                                     /* return error */
+            handle->debug_print("sps30: uart has no command.\n");                                       /* uart has no command */
+            
+            return 1;                                                                                   /* return error */
         }
-        for (i = 0; i < 8; i++)                                                                                           /* check crc */
+    }
+    else if (command == SPS30_ASYNC_COMMAND_START_MEASUREMENT)                                          /* start measurement */
+    {
+        if ((param != SPS30_FORMAT_IEEE754) && (param != SPS30_FORMAT_UINT16))                          /* check format */
         {
-            if (buf[i * 3 + 2] != a_sps30_generate_crc(handle, (uint8_t *)&buf[i * 3], 2))                                /* check crc */
-            {
-                handle->debug_print("sps30: crc is error.\n");                                                            /* crc is error */
-               
-                return 1;                                                                                                 /* return error */
-            }
+            handle->debug_print("sps30: format is invalid.\n");                                         /* format is invalid */
+            
+            return 4;                                                                                   /* return error */
         }
-        j = 0;                                                                                                            /* set zero */
-        for (i = 0; i < 8; i++)                                                                                           /* copy serial number */
+        handle->format = (uint8_t)param;                                                                /* save format */
+    }
+    else if (command == SPS30_ASYNC_COMMAND_SET_AUTO_CLEANING_INTERVAL)                                 /* set auto cleaning interval */
+    {
+        if ((param < 10) || (param > 604800))                                                           /* check second */
         {
-            sn[j] = buf[i * 3 + 0];                                                                                       /* set serial number */
-            j++;                                                                                                          /* j++ */
-            sn[j] = buf[i * 3 + 1];                                                                                       /* set serial number */
-            j++;                                                                                                          /* j++ */
+            handle->debug_print("sps30: second is invalid.\n");                                         /* second is invalid */
+            
+            return 4;                                                                                   /* return error */
         }
-        sn[j] = 0;                                                                                                        /* set NULL */
     }
+    else
+    {
+        
+    }
+    handle->async_command = (uint8_t)command;                                                           /* save command */
+#if (SPS30_ENABLE_STATS == 1)
+    handle->stats_begin_ms = now_ms;                                                                    /* save the begin time */
+#endif
+    if (a_sps30_send_command(handle, (uint8_t)command, param) != 0)                                     /* send command */
+    {
+        handle->debug_print("sps30: send command failed.\n");                                           /* send command failed */
+        a_sps30_stats_async(handle, now_ms, 1);                                                         /* count the failed command */
+        
+        return 1;                                                                                       /* return error */
+    }
+    handle->async_step = 0;                                                                             /* init step */
+    timing = gs_sps30_command_desc[command].timing;                                                       /* get the timing */
+    if ((command == SPS30_ASYNC_COMMAND_READ) && (handle->iic_uart == 0) &&
+        (handle->read_mode == SPS30_READ_MODE_CHECK_FLAG))                                              /* iic read checks the flag first */
+    {
+        timing = SPS30_TIMING_READ_DATA_READY_FLAG;                                                     /* data ready flag timing */
+    }
+    handle->async_deadline = now_ms + a_sps30_timing_ms(handle, timing);                                /* set the deadline */
+    handle->async_state = 1;                                                                            /* set pending */
     
-    return 0;                                                                                                             /* success return 0 */
+    return 0;                                                                                           /* success return 0 */
 }
 
 /**
- * @brief      get the version
+ * @brief      poll the pending command
  * @param[in]  *handle pointer to an sps30 handle structure
- * @param[out] *major pointer to a major buffer
- * @param[out] *minor pointer to a minor buffer
+ * @param[in]  now_ms current time in ms
+ * @param[out] *result pointer to a result buffer
  * @return     status code
  *             - 0 success
- *             - 1 get version failed
+ *             - 1 command failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 4 no command is pending
+ *             - 5 command is pending
+ * @note       the read command must be polled by sps30_read_poll,
+ *             the product type and serial number by sps30_async_poll_string
  */
-uint8_t sps30_get_version(sps30_handle_t *handle, uint8_t *major, uint8_t *minor)
+uint8_t sps30_async_poll(sps30_handle_t *handle, uint32_t now_ms, uint32_t *result)
 {
     uint8_t res;
-    uint8_t buf[3];
     
-    if (handle == NULL)                                                                                            /* check handle */
+    if ((handle == NULL) || (result == NULL))                                                 /* check handle */
     {
-        return 2;                                                                                                  /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                                                       /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                                                  /* return error */
+        return 3;                                                                             /* return error */
     }
-    
-    if (handle->iic_uart != 0)                                                                                     /* uart */
+    if ((handle->async_state == 0) || (handle->async_command == SPS30_ASYNC_COMMAND_READ) ||
+        (handle->async_command == SPS30_ASYNC_COMMAND_GET_PRODUCT_TYPE) ||
+        (handle->async_command == SPS30_ASYNC_COMMAND_GET_SERIAL_NUMBER))                     /* check state */
     {
-        uint8_t input_buf[6];
-        uint8_t out_buf[7 + 7];
+        handle->debug_print("sps30: no command is pending.\n");                               /* no command is pending */
         
-        input_buf[0] = 0x7E;                                                                                       /* set start */
-        input_buf[1] = 0x00;                                                                                       /* set addr */
-        input_buf[2] = SPS30_UART_COMMAND_READ_VERSION;                                                            /* set command */
-        input_buf[3] = 0x00;                                                                                       /* set length */
-        input_buf[4] = a_sps30_generate_crc(handle, (uint8_t *)&input_buf[1], 3);                                  /* set crc */
-        input_buf[5] = 0x7E;                                                                                       /* set stop */
-        memset(out_buf, 0, sizeof(uint8_t) * 14);                                                                  /* clear the buffer */
-        res = a_sps30_uart_write_read(handle, (uint8_t *)input_buf, 6, 20, (uint8_t *)out_buf, 14);                /* write read frame */
-        if (res != 0)                                                                                              /* check result */
-        {
-            handle->debug_print("sps30: write read failed.\n");                                                    /* write read failed */
-           
-            return 1;                                                                                              /* return error */
-        }
-        if (out_buf[12] != a_sps30_generate_crc(handle, (uint8_t *)&out_buf[1], 11))                               /* check crc */
-        {
-            handle->debug_print("sps30: crc check error.\n");                                                      /* crc check error */
-           
-            return 1;                                                                                              /* return error */
-        }
-        if (a_sps30_uart_error(handle, out_buf[3]) != 0)                                                           /* check status */
-        {
-            return 1;                                                                                              /* return error */
-        }
-        *major = out_buf[5];                                                                                       /* set major */
-        *minor = out_buf[6];                                                                                       /* set minor */
+        return 4;                                                                             /* return error */
     }
-    else                                                                                                           /* iic */
+    
+    res = a_sps30_async_step(handle, now_ms, result, NULL);                                   /* run one step */
+    if (res != 5)                                                                             /* finished */
     {
-        memset(buf, 0, sizeof(uint8_t) * 3);                                                                       /* clear the buffer */
-        res = a_sps30_iic_read(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_READ_VERSION, (uint8_t *)buf, 3, 20);      /* read version command */
-        if (res != 0)                                                                                              /* check result */
-        {
-            handle->debug_print("sps30: read version failed.\n");                                                  /* read version failed */
-           
-            return 1;                                                                                              /* return error */
-        }
-        if (buf[2] != a_sps30_generate_crc(handle, (uint8_t *)&buf[0], 2))                                         /* check crc */
-        {
-            handle->debug_print("sps30: crc is error.\n");                                                         /* crc is error */
-           
-            return 1;                                                                                              /* return error */
-        }
-        *major = buf[0];                                                                                           /* set major */
-        *minor = buf[1];                                                                                           /* set minor */
+        a_sps30_stats_async(handle, now_ms, res);                                             /* count the command */
+        handle->async_state = 0;                                                              /* set idle */
     }
-        
-    return 0;                                                                                                      /* success return 0 */
+    
+    return res;                                                                               /* return the result */
 }
 
 /**
- * @brief      get the device status
+ * @brief      poll the pending product type or serial number command
  * @param[in]  *handle pointer to an sps30 handle structure
- * @param[out] *status pointer to a status buffer
+ * @param[in]  now_ms current time in ms
+ * @param[out] *str pointer to a string buffer
  * @return     status code
  *             - 0 success
- *             - 1 get device status failed
+ *             - 1 command failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 4 no command is pending
+ *             - 5 command is pending
+ * @note       str must hold 17 chars, the product type has 8 chars and the serial number 16 chars
  */
-uint8_t sps30_get_device_status(sps30_handle_t *handle, uint32_t *status)
+uint8_t sps30_async_poll_string(sps30_handle_t *handle, uint32_t now_ms, char str[17])
 {
     uint8_t res;
+    uint32_t result;
+    sps30_raw_sample_t raw;
     
-    if (handle == NULL)                                                                                          /* check handle */
+    if ((handle == NULL) || (str == NULL))                                                    /* check handle */
     {
-        return 2;                                                                                                /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                                                /* return error */
+        return 3;                                                                             /* return error */
     }
-    
-    if (handle->iic_uart != 0)                                                                                   /* uart */
+    if ((handle->async_state == 0) ||
+        ((handle->async_command != SPS30_ASYNC_COMMAND_GET_PRODUCT_TYPE) &&
+         (handle->async_command != SPS30_ASYNC_COMMAND_GET_SERIAL_NUMBER)))                   /* check state */
     {
-        uint8_t input_buf[6 + 1];
-        uint8_t out_buf[7 + 5];
+        handle->debug_print("sps30: no command is pending.\n");                               /* no command is pending */
         
-        input_buf[0] = 0x7E;                                                                                     /* set start */
-        input_buf[1] = 0x00;                                                                                     /* set addr */
-        input_buf[2] = SPS30_UART_COMMAND_READ_DEVICE_STATUS_REG;                                                /* set command */
-        input_buf[3] = 0x01;                                                                                     /* set length */
-        input_buf[4] = 0x00;                                                                                     /* set 0x00 */
-        input_buf[5] = a_sps30_generate_crc(handle, (uint8_t *)&input_buf[1], 4);                                /* set crc */
-        input_buf[6] = 0x7E;                                                                                     /* set stop */
-        memset(out_buf, 0, sizeof(uint8_t) * 12);                                                                /* clear the buffer */
-        res = a_sps30_uart_write_read(handle, (uint8_t *)input_buf, 7, 20, (uint8_t *)out_buf, 12);              /* write read frame */
-        if (res != 0)                                                                                            /* check result */
-        {
-            handle->debug_print("sps30: write read failed.\n");                                                  /* write read failed */
-           
-            return 1;                                                                                            /* return error */
-        }
-        if (out_buf[10] != a_sps30_generate_crc(handle, (uint8_t *)&out_buf[1], 9))                              /* check crc */
-        {
-            handle->debug_print("sps30: crc check error.\n");                                                    /* crc check error */
-           
-            return 1;                                                                                            /* return error */
-        }
-        if (a_sps30_uart_error(handle, out_buf[3]) != 0)                                                         /* check status */
-        {
-            return 1;                                                                                            /* return error */
-        }
-        *status = ((uint32_t)out_buf[5] << 24) | ((uint32_t)out_buf[6] << 16) | 
-                  ((uint32_t)out_buf[7] << 8) | ((uint32_t)out_buf[8] << 0);                                     /* get status */
+        return 4;                                                                             /* return error */
     }
-    else                                                                                                         /* iic */
+    
+    res = a_sps30_async_step(handle, now_ms, (uint32_t *)&result, &raw);                      /* run one step */
+    if (res != 5)                                                                             /* finished */
     {
-        uint8_t buf[6];
-        
-        memset(buf, 0, sizeof(uint8_t) * 6);                                                                     /* clear the buffer */
-        res = a_sps30_iic_read(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_READ_DEVICE_STATUS_REG, 
-                              (uint8_t *)buf, 6, 20);                                                            /* get device status command */
-        if (res != 0)                                                                                            /* check result */
-        {
-            handle->debug_print("sps30: get device status failed.\n");                                           /* get device status failed */
-           
-            return 1;                                                                                            /* return error */
-        }
-        if (buf[2] != a_sps30_generate_crc(handle, (uint8_t *)&buf[0], 2))                                       /* check crc */
-        {
-            handle->debug_print("sps30: crc is error.\n");                                                       /* crc is error */
-           
-            return 1;                                                                                            /* return error */
-        }
-        if (buf[5] != a_sps30_generate_crc(handle, (uint8_t *)&buf[3], 2))                                       /* check crc */
-        {
-            handle->debug_print("sps30: crc is error.\n");                                                       /* crc is error */
-           
-            return 1;                                                                                            /* return error */
-        }
-        *status = ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) | 
-                  ((uint32_t)buf[3] << 8) | ((uint32_t)buf[4] << 0);                                             /* get status */
+        a_sps30_stats_async(handle, now_ms, res);                                             /* count the command */
+        handle->async_state = 0;                                                              /* set idle */
     }
-        
-    return 0;                                                                                                    /* success return 0 */
+    if (res == 0)                                                                             /* copy the string */
+    {
+        memcpy((uint8_t *)str, raw.payload, raw.len);                                         /* copy the string */
+        str[raw.len] = 0;                                                                     /* set NULL */
+    }
+    
+    return res;                                                                               /* return the result */
 }
 
 /**
- * @brief     clear the device status
+ * @brief     begin reading the result without blocking
  * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] now_ms current time in ms
  * @return    status code
  *            - 0 success
- *            - 1 clear device status failed
+ *            - 1 begin failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 mode is invalid
+ *            - 5 handle is busy
+ *            - 6 data is not ready
+ * @note      in the direct mode a read within 1 s of the last one is refused
+ *            without any bus transaction
  */
-uint8_t sps30_clear_device_status(sps30_handle_t *handle)
+uint8_t sps30_read_begin(sps30_handle_t *handle, uint32_t now_ms)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                                                              /* check handle */
-    {
-        return 2;                                                                                                    /* return error */
-    }
-    if (handle->inited != 1)                                                                                         /* check handle initialization */
-    {
-        return 3;                                                                                                    /* return error */
-    }
-
-    if (handle->iic_uart != 0)                                                                                       /* uart */
-    {
-        uint8_t input_buf[6 + 1];
-        uint8_t out_buf[7 + 5];
-        
-        input_buf[0] = 0x7E;                                                                                         /* set start */
-        input_buf[1] = 0x00;                                                                                         /* set addr */
-        input_buf[2] = SPS30_UART_COMMAND_READ_DEVICE_STATUS_REG;                                                    /* set command */
-        input_buf[3] = 0x01;                                                                                         /* set length */
-        input_buf[4] = 0x01;                                                                                         /* set 0x01 */
-        input_buf[5] = a_sps30_generate_crc(handle, (uint8_t *)&input_buf[1], 4);                                    /* set crc */
-        input_buf[6] = 0x7E;                                                                                         /* set stop */
-        memset(out_buf, 0, sizeof(uint8_t) * 12);                                                                    /* clear the buffer */
-        res = a_sps30_uart_write_read(handle, (uint8_t *)input_buf, 7, 20, (uint8_t *)out_buf, 12);                  /* write read frame */
-        if (res != 0)                                                                                                /* check result */
-        {
-            handle->debug_print("sps30: write read failed.\n");                                                      /* write read failed */
-           
-            return 1;                                                                                                /* return error */
-        }
-        if (out_buf[10] != a_sps30_generate_crc(handle, (uint8_t *)&out_buf[1], 9))                                  /* check crc */
-        {
-            handle->debug_print("sps30: crc check error.\n");                                                        /* crc check error */
-           
-            return 1;                                                                                                /* return error */
-        }
-        if (a_sps30_uart_error(handle, out_buf[3]) != 0)                                                             /* check status */
-        {
-            return 1;                                                                                                /* return error */
-        }
-    }
-    else                                                                                                             /* iic */
+    if ((handle != NULL) && (handle->inited == 1) && (handle->async_state == 0) &&
+        (handle->read_mode == SPS30_READ_MODE_DIRECT) && (handle->read_valid != 0) &&
+        ((uint32_t)(now_ms - handle->read_last_ms) < 1000))                       /* check the cadence */
     {
-        res = a_sps30_iic_write(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_CLEAR_DEVICE_STATUS_REG, NULL, 0, 20);      /* clear device status command */
-        if (res != 0)                                                                                                /* check result */
-        {
-            handle->debug_print("sps30: clear device status failed.\n");                                             /* clear device status failed */
-           
-            return 1;                                                                                                /* return error */
-        }
+        return 6;                                                                 /* data is not ready */
     }
-        
-    return 0;                                                                                                        /* success return 0 */
+    
+    return sps30_async_begin(handle, SPS30_ASYNC_COMMAND_READ, 0, now_ms);        /* begin the read command */
 }
 
 /**
- * @brief     reset the chip
- * @param[in] *handle pointer to an sps30 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 reset failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      run one step of the pending read
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  now_ms current time in ms
+ * @param[out] *raw pointer to an sps30 raw sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 4 no read is pending
+ *             - 5 read is pending
+ *             - 6 data is not ready
+ * @note       none
  */
-uint8_t sps30_reset(sps30_handle_t *handle)
+static uint8_t a_sps30_read_poll(sps30_handle_t *handle, uint32_t now_ms, sps30_raw_sample_t *raw)
 {
     uint8_t res;
+    uint32_t result;
     
-    if (handle == NULL)                                                                              /* check handle */
-    {
-        return 2;                                                                                    /* return error */
-    }
-    if (handle->inited != 1)                                                                         /* check handle initialization */
+    if ((handle->async_state == 0) || (handle->async_command != SPS30_ASYNC_COMMAND_READ))    /* check state */
     {
-        return 3;                                                                                    /* return error */
+        handle->debug_print("sps30: no read is pending.\n");                                  /* no read is pending */
+        
+        return 4;                                                                             /* return error */
     }
-
-    if (handle->iic_uart != 0)                                                                       /* uart */
+    
+    res = a_sps30_async_step(handle, now_ms, (uint32_t *)&result, raw);                       /* run one step */
+    if (res != 5)                                                                             /* finished */
     {
-        uint8_t input_buf[6];
-        uint8_t out_buf[7];
-        
-        input_buf[0] = 0x7E;                                                                         /* set start */
-        input_buf[1] = 0x00;                                                                         /* set addr */
-        input_buf[2] = SPS30_UART_COMMAND_RESET;                                                     /* set command */
-        input_buf[3] = 0x00;                                                                         /* set length */
-        input_buf[4] = a_sps30_generate_crc(handle, (uint8_t *)&input_buf[1], 3);                    /* set crc */
-        input_buf[5] = 0x7E;                                                                         /* set stop */
-        memset(out_buf, 0, sizeof(uint8_t) * 7);                                                     /* clear the buffer */
-        res = a_sps30_uart_write_read(handle, (uint8_t *)input_buf, 6, 100, (uint8_t *)out_buf, 7);  /* write read frame */
-        if (res != 0)                                                                                /* check result */
-        {
-            handle->debug_print("sps30: write read failed.\n");                                      /* write read failed */
-           
-            return 1;                                                                                /* return error */
-        }
-        if (out_buf[5] != a_sps30_generate_crc(handle, (uint8_t *)&out_buf[1], 4))                   /* check crc */
-        {
-            handle->debug_print("sps30: crc check error.\n");                                        /* crc check error */
-           
-            return 1;                                                                                /* return error */
-        }
-        if (a_sps30_uart_error(handle, out_buf[3]) != 0)                                             /* check status */
-        {
-            return 1;                                                                                /* return error */
-        }
+        a_sps30_stats_async(handle, now_ms, res);                                             /* count the command */
+        handle->async_state = 0;                                                              /* set idle */
     }
-    else                                                                                             /* iic */
+    if (res == 0)                                                                             /* new sample */
     {
-        res = a_sps30_iic_write(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_RESET, NULL, 0, 100);       /* reset command */
-        if (res != 0)                                                                                /* check result */
-        {
-            handle->debug_print("sps30: reset failed.\n");                                           /* reset failed */
-           
-            return 1;                                                                                /* return error */
-        }
+        handle->read_last_ms = now_ms;                                                        /* save the read time */
+        handle->read_valid = 1;                                                               /* flag the read time */
     }
-        
-    return 0;                                                                                        /* success return 0 */
+    
+    return res;                                                                               /* return the result */
 }
 
+#if (SPS30_ENABLE_FLOAT == 1)
 /**
- * @brief      read the result
+ * @brief      poll the pending read
  * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  now_ms current time in ms
  * @param[out] *pm pointer to an sps30 pm structure
  * @return     status code
  *             - 0 success
  *             - 1 read failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 mode is invalid
+ *             - 4 no read is pending
+ *             - 5 read is pending
+ *             - 6 data is not ready
  * @note       none
  */
-uint8_t sps30_read(sps30_handle_t *handle, sps30_pm_t *pm)
+uint8_t sps30_read_poll(sps30_handle_t *handle, uint32_t now_ms, sps30_pm_t *pm)
 {
-    union float_u
-    {
-        float f;
-        uint32_t i;
-    };
-    uint8_t res, i;
-    union float_u f;
+    uint8_t res;
+    sps30_raw_sample_t raw;
     
-    if ((handle == NULL) || (pm == NULL))                                                                                       /* check handle */
+    if ((handle == NULL) || (pm == NULL))                                                     /* check handle */
     {
-        return 2;                                                                                                               /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                                                                    /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                                                               /* return error */
+        return 3;                                                                             /* return error */
     }
     
-    if (handle->iic_uart != 0)                                                                                                  /* uart */
+    res = a_sps30_read_poll(handle, now_ms, &raw);                                            /* run one step */
+    if (res != 0)                                                                             /* check result */
     {
-        if (handle->format == SPS30_FORMAT_IEEE754)                                                                             /* float */
-        {
-            uint8_t input_buf[6];
-            uint8_t out_buf[7 + 40];
-            
-            input_buf[0] = 0x7E;                                                                                                /* set start */
-            input_buf[1] = 0x00;                                                                                                /* set addr */
-            input_buf[2] = SPS30_UART_COMMAND_READ_MEASURED_VALUES;                                                             /* set command */
-            input_buf[3] = 0x00;                                                                                                /* set length */
-            input_buf[4] = a_sps30_generate_crc(handle, (uint8_t *)&input_buf[1], 3);                                           /* set crc */
-            input_buf[5] = 0x7E;                                                                                                /* set stop */
-            memset(out_buf, 0, sizeof(uint8_t) * 47);                                                                           /* clear the buffer */
-            res = a_sps30_uart_write_read(handle, (uint8_t *)input_buf, 6, 20, (uint8_t *)out_buf, 47);                         /* write read frame */
-            if (res != 0)                                                                                                       /* check result */
-            {
-                handle->debug_print("sps30: write read failed.\n");                                                             /* write read failed */
-               
-                return 1;                                                                                                       /* return error */
-            }
-            if (out_buf[45] != a_sps30_generate_crc(handle, (uint8_t *)&out_buf[1], 44))                                        /* check crc */
-            {
-                handle->debug_print("sps30: crc check error.\n");                                                               /* crc check error */
-               
-                return 1;                                                                                                       /* return error */
-            }
-            if (a_sps30_uart_error(handle, out_buf[3]) != 0)                                                                    /* check status */
-            {
-                return 1;                                                                                                       /* return error */
-            }
-            f.i = (uint32_t)(out_buf[5 + 0]) << 24 | (uint32_t)(out_buf[5 + 1]) << 16 |
-                  (uint32_t)(out_buf[5 + 2]) << 8 | (uint32_t)(out_buf[5 + 3]) << 0;                                            /* copy data */
-            pm->pm1p0_ug_m3 = f.f;                                                                                              /* copy pm1.0 ug/m3 */
-            f.i = (uint32_t)(out_buf[5 + 4]) << 24 | (uint32_t)(out_buf[5 + 5]) << 16 |
-                  (uint32_t)(out_buf[5 + 6]) << 8 | (uint32_t)(out_buf[5 + 7]) << 0;                                            /* copy data */
-            pm->pm2p5_ug_m3 = f.f;                                                                                              /* copy pm2.5 ug/m3 */
-            f.i = (uint32_t)(out_buf[5 + 8]) << 24 | (uint32_t)(out_buf[5 + 9]) << 16 |
-                  (uint32_t)(out_buf[5 + 10]) << 8 | (uint32_t)(out_buf[5 + 11]) << 0;                                          /* copy data */
-            pm->pm4p0_ug_m3 = f.f;                                                                                              /* copy pm4.0 ug/m3 */
-            f.i = (uint32_t)(out_buf[5 + 12]) << 24 | (uint32_t)(out_buf[5 + 13]) << 16 |
-                  (uint32_t)(out_buf[5 + 14]) << 8 | (uint32_t)(out_buf[5 + 15]) << 0;                                          /* copy data */
-            pm->pm10_ug_m3 = f.f;                                                                                               /* copy pm10.0 ug/m3 */
-            f.i = (uint32_t)(out_buf[5 + 16]) << 24 | (uint32_t)(out_buf[5 + 17]) << 16 |
-                  (uint32_t)(out_buf[5 + 18]) << 8 | (uint32_t)(out_buf[5 + 19]) << 0;                                          /* copy data */
-            pm->pm0p5_cm3 = f.f;                                                                                                /* copy pm0.5 cm3 */
-            f.i = (uint32_t)(out_buf[5 + 20]) << 24 | (uint32_t)(out_buf[5 + 21]) << 16 |
-                  (uint32_t)(out_buf[5 + 22]) << 8 | (uint32_t)(out_buf[5 + 23]) << 0;                                          /* copy data */
-            pm->pm1p0_cm3 = f.f;                                                                                                /* copy pm1.0 cm3 */
-            f.i = (uint32_t)(out_buf[5 + 24]) << 24 | (uint32_t)(out_buf[5 + 25]) << 16 |
-                  (uint32_t)(out_buf[5 + 26]) << 8 | (uint32_t)(out_buf[5 + 27]) << 0;                                          /* copy data */
-            pm->pm2p5_cm3 = f.f;                                                                                                /* copy pm2.5 cm3 */
-            f.i = (uint32_t)(out_buf[5 + 28]) << 24 | (uint32_t)(out_buf[5 + 29]) << 16 |
-                  (uint32_t)(out_buf[5 + 30]) << 8 | (uint32_t)(out_buf[5 + 31]) << 0;                                          /* copy data */
-            pm->pm4p0_cm3 = f.f;                                                                                                /* copy pm4.0 cm3 */
-            f.i = (uint32_t)(out_buf[5 + 32]) << 24 | (uint32_t)(out_buf[5 + 33]) << 16 |
-                  (uint32_t)(out_buf[5 + 34]) << 8 | (uint32_t)(out_buf[5 + 35]) << 0;                                          /* copy data */
-            pm->pm10_cm3 = f.f;                                                                                                 /* copy pm10.0 cm3 */
-            f.i = (uint32_t)(out_buf[5 + 36]) << 24 | (uint32_t)(out_buf[5 + 37]) << 16 |
-                  (uint32_t)(out_buf[5 + 38]) << 8 | (uint32_t)(out_buf[5 + 39]) << 0;                                          /* copy data */
-            pm->typical_particle_um = f.f;                                                                                      /* copy typical particle um */
-        }
-        else if (handle->format == SPS30_FORMAT_UINT16)                                                                         /* uint16 */
-        {
-            uint8_t input_buf[6];
-            uint8_t out_buf[7 + 20];
-            
-            input_buf[0] = 0x7E;                                                                                                /* set start */
-            input_buf[1] = 0x00;                                                                                                /* set addr */
-            input_buf[2] = SPS30_UART_COMMAND_READ_MEASURED_VALUES;                                                             /* set command */
-            input_buf[3] = 0x00;                                                                                                /* set length */
-            input_buf[4] = a_sps30_generate_crc(handle, (uint8_t *)&input_buf[1], 3);                                           /* set crc */
-            input_buf[5] = 0x7E;                                                                                                /* set stop */
-            memset(out_buf, 0, sizeof(uint8_t) * 27);                                                                           /* clear the buffer */
-            res = a_sps30_uart_write_read(handle, (uint8_t *)input_buf, 6, 20, (uint8_t *)out_buf, 27);                         /* write read frame */
-            if (res != 0)                                                                                                       /* check result */
-            {
-                handle->debug_print("sps30: write read failed.\n");                                                             /* write read failed */
-               
-                return 1;                                                                                                       /* return error */
-            }
-            if (out_buf[25] != a_sps30_generate_crc(handle, (uint8_t *)&out_buf[1], 24))                                        /* check crc */
-            {
-                handle->debug_print("sps30: crc check error.\n");                                                               /* crc check error */
-               
-                return 1;                                                                                                       /* return error */
-            }
-            if (a_sps30_uart_error(handle, out_buf[3]) != 0)                                                                    /* check status */
-            {
-                return 1;                                                                                                       /* return error */
-            }
-            pm->pm1p0_ug_m3 = (float)(((uint16_t)(out_buf[5 + 0]) << 8) | ((uint16_t)(out_buf[5 + 1]) << 0));                   /* copy pm1.0 ug/m3 */
-            pm->pm2p5_ug_m3 = (float)(((uint16_t)(out_buf[5 + 2]) << 8) | ((uint16_t)(out_buf[5 + 3]) << 0));                   /* copy pm2.5 ug/m3 */
-            pm->pm4p0_ug_m3 = (float)(((uint16_t)(out_buf[5 + 4]) << 8) | ((uint16_t)(out_buf[5 + 5]) << 0));                   /* copy pm4.0 ug/m3 */
-            pm->pm10_ug_m3 = (float)(((uint16_t)(out_buf[5 + 6]) << 8) | ((uint16_t)(out_buf[5 + 7]) << 0));                    /* copy pm10 ug/m3 */
-            pm->pm0p5_cm3 = (float)(((uint16_t)(out_buf[5 + 8]) << 8) | ((uint16_t)(out_buf[5 + 9]) << 0));                     /* copy pm0.5 cm3 */
-            pm->pm1p0_cm3 = (float)(((uint16_t)(out_buf[5 + 10]) << 8) | ((uint16_t)(out_buf[5 + 11]) << 0));                   /* copy pm1.0 cm3 */
-            pm->pm2p5_cm3 = (float)(((uint16_t)(out_buf[5 + 12]) << 8) | ((uint16_t)(out_buf[5 + 13]) << 0));                   /* copy pm2.5 cm3 */
-            pm->pm4p0_cm3 = (float)(((uint16_t)(out_buf[5 + 14]) << 8) | ((uint16_t)(out_buf[5 + 15]) << 0));                   /* copy pm4.0 cm3 */
-            pm->pm10_cm3 = (float)(((uint16_t)(out_buf[5 + 16]) << 8) | ((uint16_t)(out_buf[5 + 17]) << 0));                    /* copy pm10 cm3 */
-            pm->typical_particle_um = (float)(((uint16_t)(out_buf[5 + 18]) << 8) | ((uint16_t)(out_buf[5 + 19]) << 0));         /* copy typical particle */
-            pm->typical_particle_um /= 1000.0f;                                                                                 /* div 1000 */
-        }
-        else
-        {
-            handle->debug_print("sps30: mode is invalid.\n");                                                                   /* mode is invalid */
-           
-            return 4;                                                                                                           /* return error */
-        }
+        return res;                                                                           /* return the result */
+    }
+    a_sps30_decode_pm(raw.format, (uint8_t *)raw.payload, SPS30_FIELD_ALL, pm);               /* decode the values */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+#endif
+
+/**
+ * @brief      poll the pending read as integers
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  now_ms current time in ms
+ * @param[out] *pm pointer to an sps30 pm u16 structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 no read is pending
+ *             - 5 read is pending
+ *             - 6 data is not ready
+ *             - 7 mode is invalid
+ * @note       the measurement must be started with SPS30_FORMAT_UINT16
+ */
+uint8_t sps30_read_poll_u16(sps30_handle_t *handle, uint32_t now_ms, sps30_pm_u16_t *pm)
+{
+    uint8_t res;
+    sps30_raw_sample_t raw;
+    
+    if ((handle == NULL) || (pm == NULL))                                                     /* check handle */
+    {
+        return 2;                                                                             /* return error */
     }
-    else                                                                                                                        /* iic */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        uint8_t check[3];
-        
-        memset(check, 0, sizeof(uint8_t) * 3);                                                                                  /* clear the buffer */
-        res = a_sps30_iic_read(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_READ_DATA_READY_FLAG, (uint8_t *)check, 3, 20);         /* read data ready flag command */
-        if (res != 0)                                                                                                           /* check result */
-        {
-            handle->debug_print("sps30: read data ready flag failed.\n");                                                       /* read data ready flag failed */
-           
-            return 1;                                                                                                           /* return error */
-        }
-        if (check[2] != a_sps30_generate_crc(handle, (uint8_t *)check, 2))                                                      /* check crc */
-        {
-            handle->debug_print("sps30: crc check failed.\n");                                                                  /* crc check failed */
-           
-            return 1;                                                                                                           /* return error */
-        }
-        if ((check[1] & 0x01) == 0)                                                                                             /* check flag */
-        {
-            handle->debug_print("sps30: data not ready.\n");                                                                    /* data not ready */
-           
-            return 1;                                                                                                           /* return error */
-        }
-        
-        if (handle->format == SPS30_FORMAT_IEEE754)                                                                             /* float */
-        {
-            uint8_t buf[60];
-            
-            memset(buf, 0, sizeof(uint8_t) * 60);                                                                               /* clear the buffer */
-            res = a_sps30_iic_read(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_READ_MEASURED_VALUES, (uint8_t *)buf, 60, 20);      /* read measured values command */
-            if (res != 0)                                                                                                       /* check result */
-            {
-                handle->debug_print("sps30: read measured values failed.\n");                                                   /* read measured values failed */
-               
-                return 1;                                                                                                       /* return error */
-            }
-            for (i = 0; i < 20; i++)                                                                                            /* check crc */
-            {
-                if (buf[i * 3 + 2] != a_sps30_generate_crc(handle, (uint8_t *)&buf[i * 3], 2))                                  /* check crc */
-                {
-                    handle->debug_print("sps30: crc is error.\n");                                                              /* crc is error */
-                   
-                    return 1;                                                                                                   /* return error */
-                }
-            }
-            f.i = (uint32_t)(buf[0]) << 24 | (uint32_t)(buf[1]) << 16 |
-                  (uint32_t)(buf[3]) << 8 | (uint32_t)(buf[4]) << 0;                                                            /* copy data */
-            pm->pm1p0_ug_m3 = f.f;                                                                                              /* copy pm1.0 ug/m3 */
-            f.i = (uint32_t)(buf[6]) << 24 | (uint32_t)(buf[7]) << 16 |
-                  (uint32_t)(buf[9]) << 8 | (uint32_t)(buf[10]) << 0;                                                           /* copy data */
-            pm->pm2p5_ug_m3 = f.f;                                                                                              /* copy pm2.5 ug/m3 */
-            f.i = (uint32_t)(buf[12]) << 24 | (uint32_t)(buf[13]) << 16 |
-                  (uint32_t)(buf[15]) << 8 | (uint32_t)(buf[16]) << 0;                                                          /* copy data */
-            pm->pm4p0_ug_m3 = f.f;                                                                                              /* copy pm4.0 ug/m3 */
-            f.i = (uint32_t)(buf[18]) << 24 | (uint32_t)(buf[19]) << 16 |
-                  (uint32_t)(buf[21]) << 8 | (uint32_t)(buf[22]) << 0;                                                          /* copy data */
-            pm->pm10_ug_m3 = f.f;                                                                                               /* copy pm10.0 ug/m3 */
-            f.i = (uint32_t)(buf[24]) << 24 | (uint32_t)(buf[25]) << 16 |
-                  (uint32_t)(buf[27]) << 8 | (uint32_t)(buf[28]) << 0;                                                          /* copy data */
-            pm->pm0p5_cm3 = f.f;                                                                                                /* copy pm0.5 cm3 */
-            f.i = (uint32_t)(buf[30]) << 24 | (uint32_t)(buf[31]) << 16 |
-                  (uint32_t)(buf[33]) << 8 | (uint32_t)(buf[34]) << 0;                                                          /* copy data */
-            pm->pm1p0_cm3 = f.f;                                                                                                /* copy pm1.0 cm3 */
-            f.i = (uint32_t)(buf[36]) << 24 | (uint32_t)(buf[37]) << 16 |
-                  (uint32_t)(buf[39]) << 8 | (uint32_t)(buf[40]) << 0;                                                          /* copy data */
-            pm->pm2p5_cm3 = f.f;                                                                                                /* copy pm2.5 cm3 */
-            f.i = (uint32_t)(buf[42]) << 24 | (uint32_t)(buf[43]) << 16 |
-                  (uint32_t)(buf[45]) << 8 | (uint32_t)(buf[46]) << 0;                                                          /* copy data */
-            pm->pm4p0_cm3 = f.f;                                                                                                /* copy pm4.0 cm3 */
-            f.i = (uint32_t)(buf[48]) << 24 | (uint32_t)(buf[49]) << 16 |
-                  (uint32_t)(buf[51]) << 8 | (uint32_t)(buf[52]) << 0;                                                          /* copy data */
-            pm->pm10_cm3 = f.f;                                                                                                 /* copy pm10.0 cm3 */
-            f.i = (uint32_t)(buf[54]) << 24 | (uint32_t)(buf[55]) << 16 |
-                  (uint32_t)(buf[57]) << 8 | (uint32_t)(buf[58]) << 0;                                                          /* copy data */
-            pm->typical_particle_um = f.f;                                                                                      /* copy typical particle um */
-        }
-        else if (handle->format == SPS30_FORMAT_UINT16)                                                                         /* uint16 */
-        {
-            uint8_t buf[30];
-            
-            memset(buf, 0, sizeof(uint8_t) * 30);                                                                               /* clear the buffer */
-            res = a_sps30_iic_read(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_READ_MEASURED_VALUES, (uint8_t *)buf, 30, 20);      /* read measured values command */
-            if (res != 0)                                                                                                       /* check result */
-            {
-                handle->debug_print("sps30: read measured values failed.\n");                                                   /* read measured values failed */
-               
-                return 1;                                                                                                       /* return error */
-            }
-            for (i = 0; i < 10; i++)                                                                                            /* check crc */
-            {
-                if (buf[i * 3 + 2] != a_sps30_generate_crc(handle, (uint8_t *)&buf[i * 3], 2))                                  /* check crc */
-                {
-                    handle->debug_print("sps30: crc is error.\n");                                                              /* crc is error */
-                   
-                    return 1;                                                                                                   /* return error */
-                }
-            }
-            pm->pm1p0_ug_m3 = (float)(((uint16_t)(buf[0]) << 8) | ((uint16_t)(buf[1]) << 0));                                   /* copy pm1.0 ug/m3 */
-            pm->pm2p5_ug_m3 = (float)(((uint16_t)(buf[3]) << 8) | ((uint16_t)(buf[4]) << 0));                                   /* copy pm2.5 ug/m3 */
-            pm->pm4p0_ug_m3 = (float)(((uint16_t)(buf[6]) << 8) | ((uint16_t)(buf[7]) << 0));                                   /* copy pm4.0 ug/m3 */
-            pm->pm10_ug_m3 = (float)(((uint16_t)(buf[9]) << 8) | ((uint16_t)(buf[10]) << 0));                                   /* copy pm10 ug/m3 */
-            pm->pm0p5_cm3 = (float)(((uint16_t)(buf[12]) << 8) | ((uint16_t)(buf[13]) << 0));                                   /* copy pm0.5 cm3 */
-            pm->pm1p0_cm3 = (float)(((uint16_t)(buf[15]) << 8) | ((uint16_t)(buf[16]) << 0));                                   /* copy pm1.0 cm3 */
-            pm->pm2p5_cm3 = (float)(((uint16_t)(buf[18]) << 8) | ((uint16_t)(buf[19]) << 0));                                   /* copy pm2.5 cm3 */
-            pm->pm4p0_cm3 = (float)(((uint16_t)(buf[21]) << 8) | ((uint16_t)(buf[22]) << 0));                                   /* copy pm4.0 cm3 */
-            pm->pm10_cm3 = (float)(((uint16_t)(buf[24]) << 8) | ((uint16_t)(buf[25]) << 0));                                    /* copy pm10 cm3 */
-            pm->typical_particle_um = (float)(((uint16_t)(buf[27]) << 8) | ((uint16_t)(buf[28]) << 0));                         /* copy typical particle */
-            pm->typical_particle_um /= 1000.0f;                                                                                 /* div 1000 */
-        }
-        else
-        {
-            handle->debug_print("sps30: mode is invalid.\n");                                                                   /* mode is invalid */
-           
-            return 4;                                                                                                           /* return error */
-        }
+        return 3;                                                                             /* return error */
+    }
+    if (handle->format != SPS30_FORMAT_UINT16)                                                /* check format */
+    {
+        handle->debug_print("sps30: mode is invalid.\n");                                     /* mode is invalid */
+       
+        return 7;                                                                             /* return error */
     }
     
-    return 0;                                                                                                                   /* success return 0 */
+    res = a_sps30_read_poll(handle, now_ms, &raw);                                            /* run one step */
+    if (res != 0)                                                                             /* check result */
+    {
+        return res;                                                                           /* return the result */
+    }
+    a_sps30_decode_pm_u16((uint8_t *)raw.payload, pm);                                        /* decode the values */
+    
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
@@ -1938,8 +3765,6 @@ uint8_t sps30_read(sps30_handle_t *handle, sps30_pm_t *pm)
  */
 uint8_t sps30_init(sps30_handle_t *handle)
 {
-    uint8_t res;
-    
     if (handle == NULL)                                                                              /* check handle */
     {
         return 2;                                                                                    /* return error */
@@ -1948,124 +3773,152 @@ uint8_t sps30_init(sps30_handle_t *handle)
     {
         return 3;                                                                                    /* return error */
     }
-    if (handle->iic_init == NULL)                                                                    /* check iic_init */
+#if (SPS30_STATIC_PORT != 1)
+#if (SPS30_ENABLE_IIC == 1)
+    if ((handle->iic_init == NULL) && (handle->iic_init_ctx == NULL))                                /* check iic_init */
     {
         handle->debug_print("sps30: iic_init is null.\n");                                           /* iic_init is null */
     
         return 3;                                                                                    /* return error */
     }
-    if (handle->iic_deinit == NULL)                                                                  /* check iic_deinit */
+    if ((handle->iic_deinit == NULL) && (handle->iic_deinit_ctx == NULL))                            /* check iic_deinit */
     {
         handle->debug_print("sps30: iic_deinit is null.\n");                                         /* iic_deinit is null */
     
         return 3;                                                                                    /* return error */
     }
-    if (handle->iic_write_cmd == NULL)                                                               /* check iic_write_cmd */
+    if ((handle->iic_write_cmd == NULL) && (handle->iic_write_cmd_ctx == NULL))                      /* check iic_write_cmd */
     {
         handle->debug_print("sps30: iic_write_cmd is null.\n");                                      /* iic_write_cmd is null */
     
         return 3;                                                                                    /* return error */
     }
-    if (handle->iic_read_cmd == NULL)                                                                /* check iic_read_cmd */
+    if ((handle->iic_read_cmd == NULL) && (handle->iic_read_cmd_ctx == NULL))                        /* check iic_read_cmd */
     {
         handle->debug_print("sps30: iic_read_cmd is null.\n");                                       /* iic_read_cmd is null */
     
         return 3;                                                                                    /* return error */
     }
-    if (handle->uart_init == NULL)                                                                   /* check uart_init */
+#endif
+#if (SPS30_ENABLE_UART == 1)
+    if ((handle->uart_init == NULL) && (handle->uart_init_ctx == NULL))                              /* check uart_init */
     {
         handle->debug_print("sps30: uart_init is null.\n");                                          /* uart_init is null */
     
         return 3;                                                                                    /* return error */
     }
-    if (handle->uart_deinit == NULL)                                                                 /* check uart_deinit */
+    if ((handle->uart_deinit == NULL) && (handle->uart_deinit_ctx == NULL))                          /* check uart_deinit */
     {
         handle->debug_print("sps30: uart_deinit is null.\n");                                        /* uart_deinit is null */
     
         return 3;                                                                                    /* return error */
     }
-    if (handle->uart_read == NULL)                                                                   /* check uart_read */
+    if ((handle->uart_read == NULL) && (handle->uart_read_ctx == NULL))                              /* check uart_read */
     {
         handle->debug_print("sps30: uart_read is null.\n");                                          /* uart_read is null */
     
         return 3;                                                                                    /* return error */
     }
-    if (handle->uart_write == NULL)                                                                  /* check uart_write */
+    if ((handle->uart_write == NULL) && (handle->uart_write_ctx == NULL))                            /* check uart_write */
     {
         handle->debug_print("sps30: uart_write is null.\n");                                         /* uart_write is null */
     
         return 3;                                                                                    /* return error */
     }
-    if (handle->uart_flush == NULL)                                                                  /* check uart_flush */
+    if ((handle->uart_flush == NULL) && (handle->uart_flush_ctx == NULL))                            /* check uart_flush */
     {
         handle->debug_print("sps30: uart_flush is null.\n");                                         /* uart_flush is null */
     
         return 3;                                                                                    /* return error */
     }
-    if (handle->delay_ms == NULL)                                                                    /* check delay_ms */
+#endif
+    if ((handle->delay_ms == NULL) && (handle->delay_ms_ctx == NULL))                                /* check delay_ms */
     {
         handle->debug_print("sps30: delay_ms is null.\n");                                           /* delay_ms is null */
     
         return 3;                                                                                    /* return error */
     }
+#endif
+#if (SPS30_ENABLE_IIC != 1)
+    if (handle->iic_uart == 0)                                                                       /* check interface */
+    {
+        handle->debug_print("sps30: iic interface is disabled.\n");                                  /* iic interface is disabled */
+    
+        return 1;                                                                                    /* return error */
+    }
+#endif
+#if (SPS30_ENABLE_UART != 1)
+    if (handle->iic_uart != 0)                                                                       /* check interface */
+    {
+        handle->debug_print("sps30: uart interface is disabled.\n");                                 /* uart interface is disabled */
+    
+        return 1;                                                                                    /* return error */
+    }
+#endif
+    
+#if (SPS30_ENABLE_UART == 1) && (SPS30_INNER_BUFFER_SIZE != 0)
+    if (handle->buf == NULL)                                                                         /* no linked buffer */
+    {
+        handle->buf = handle->inner_buf;                                                             /* use the inner buffer */
+        handle->buf_size = SPS30_INNER_BUFFER_SIZE;                                                  /* set the buffer size */
+    }
+#endif
+#if (SPS30_ENABLE_UART == 1)
+    if ((handle->iic_uart != 0) &&
+        ((handle->buf == NULL) || (handle->buf_size < SPS30_BUFFER_MIN_SIZE)))                       /* check buf */
+    {
+        handle->debug_print("sps30: buf is invalid.\n");                                             /* buf is invalid */
     
+        return 3;                                                                                    /* return error */
+    }
+    handle->feed_state = 0;                                                                          /* stop the feed parser */
+    handle->feed_done = 0;                                                                           /* clear the fed frame */
+#endif
+    handle->read_valid = 0;                                                                          /* no read yet */
+    memcpy(handle->timing_us, gs_sps30_timing_default, sizeof(gs_sps30_timing_default));            /* load the datasheet timing */
+#if (SPS30_ENABLE_STATS == 1)
+    memset(&handle->stats, 0, sizeof(sps30_stats_t));                                                /* reset the stats */
+#endif
+#if (SPS30_ENABLE_TRACE == 1) || (SPS30_ENABLE_STATS == 1)
+    handle->delay_time_us = 0;                                                                       /* reset the delay time */
+#endif
     if (handle->iic_uart != 0)
     {
-        uint8_t input_buf[6];
-        uint8_t out_buf[7];
-        
-        if (handle->uart_init() != 0)                                                                /* uart init */
+#if (SPS30_ENABLE_UART == 1)
+        if (a_sps30_link_uart_init(handle) != 0)                                                     /* uart init */
         {
             handle->debug_print("sps30: uart init failed.\n");                                       /* uart init failed */
         
             return 1;                                                                                /* return error */
         }
-        input_buf[0] = 0x7E;                                                                         /* set start */
-        input_buf[1] = 0x00;                                                                         /* set addr */
-        input_buf[2] = SPS30_UART_COMMAND_RESET;                                                     /* set command */
-        input_buf[3] = 0x00;                                                                         /* set length */
-        input_buf[4] = a_sps30_generate_crc(handle, (uint8_t *)&input_buf[1], 3);                    /* set crc */
-        input_buf[5] = 0x7E;                                                                         /* set stop */
-        memset(out_buf, 0, sizeof(uint8_t) * 7);                                                     /* clear the buffer */
-        res = a_sps30_uart_write_read(handle, (uint8_t *)input_buf, 6, 100, (uint8_t *)out_buf, 7);  /* write read frame */
-        if (res != 0)                                                                                /* check result */
-        {
-            handle->debug_print("sps30: write read failed.\n");                                      /* write read failed */
-            (void)handle->uart_deinit();                                                             /* uart deinit */
-            
-            return 4;                                                                                /* return error */
-        }
-        if (out_buf[5] != a_sps30_generate_crc(handle, (uint8_t *)&out_buf[1], 4))                   /* check crc */
-        {
-            handle->debug_print("sps30: crc check error.\n");                                        /* crc check error */
-            (void)handle->uart_deinit();                                                             /* uart deinit */
-            
-            return 4;                                                                                /* return error */
-        }
-        if (a_sps30_uart_error(handle, out_buf[3]) != 0)                                             /* check status */
+        if (a_sps30_run_command(handle, SPS30_ASYNC_COMMAND_RESET, 0, NULL) != 0)                    /* reset command */
         {
-            (void)handle->uart_deinit();                                                             /* uart deinit */
+            handle->debug_print("sps30: reset failed.\n");                                           /* reset failed */
+            (void)a_sps30_link_uart_deinit(handle);                                                  /* uart deinit */
             
             return 4;                                                                                /* return error */
         }
+#endif
     }
     else
     {
-        if (handle->iic_init() != 0)                                                                 /* iic init */
+#if (SPS30_ENABLE_IIC == 1)
+        if (a_sps30_link_iic_init(handle) != 0)                                                      /* iic init */
         {
             handle->debug_print("sps30: iic init failed.\n");                                        /* iic init failed */
             
             return 1;                                                                                /* return error */
         }
-        res = a_sps30_iic_write(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_RESET, NULL, 0, 100);       /* reset command */
-        if (res != 0)                                                                                /* check result */
+        if (a_sps30_run_command(handle, SPS30_ASYNC_COMMAND_RESET, 0, NULL) != 0)                    /* reset command */
         {
             handle->debug_print("sps30: reset failed.\n");                                           /* reset failed */
-            (void)handle->iic_deinit();                                                              /* iic deinit */
+            (void)a_sps30_link_iic_deinit(handle);                                                   /* iic deinit */
             
             return 4;                                                                                /* return error */
         }
+#endif
     }
+    handle->async_state = 0;                                                                         /* no pending command */
     handle->inited = 1;                                                                              /* flag finish initialization */
   
     return 0;                                                                                        /* success return 0 */
@@ -2084,8 +3937,6 @@ uint8_t sps30_init(sps30_handle_t *handle)
  */
 uint8_t sps30_deinit(sps30_handle_t *handle)
 {
-    uint8_t res;
-    
     if (handle == NULL)                                                                              /* check handle */
     {
         return 2;                                                                                    /* return error */
@@ -2095,58 +3946,33 @@ uint8_t sps30_deinit(sps30_handle_t *handle)
         return 3;                                                                                    /* return error */
     }    
     
-    if (handle->iic_uart != 0)
+    if (a_sps30_run_command(handle, SPS30_ASYNC_COMMAND_RESET, 0, NULL) != 0)                        /* reset command */
     {
-        uint8_t input_buf[6];
-        uint8_t out_buf[7];
+        handle->debug_print("sps30: reset failed.\n");                                               /* reset failed */
         
-        input_buf[0] = 0x7E;                                                                         /* set start */
-        input_buf[1] = 0x00;                                                                         /* set addr */
-        input_buf[2] = SPS30_UART_COMMAND_RESET;                                                     /* set command */
-        input_buf[3] = 0x00;                                                                         /* set length */
-        input_buf[4] = a_sps30_generate_crc(handle, (uint8_t *)&input_buf[1], 3);                    /* set crc */
-        input_buf[5] = 0x7E;                                                                         /* set stop */
-        memset(out_buf, 0, sizeof(uint8_t) * 7);                                                     /* clear the buffer */
-        res = a_sps30_uart_write_read(handle, (uint8_t *)input_buf, 6, 100, (uint8_t *)out_buf, 7);  /* write read frame */
-        if (res != 0)                                                                                /* check result */
-        {
-            handle->debug_print("sps30: write read failed.\n");                                      /* write read failed */
-           
-            return 4;                                                                                /* return error */
-        }
-        if (out_buf[5] != a_sps30_generate_crc(handle, (uint8_t *)&out_buf[1], 4))                   /* check crc */
-        {
-            handle->debug_print("sps30: crc check error.\n");                                        /* crc check error */
-           
-            return 4;                                                                                /* return error */
-        }
-        if (a_sps30_uart_error(handle, out_buf[3]) != 0)                                             /* check status */
-        {
-            return 4;                                                                                /* return error */
-        }
-        if (handle->uart_deinit() != 0)                                                              /* uart deinit */
+        return 4;                                                                                    /* return error */
+    }
+    if (handle->iic_uart != 0)
+    {
+#if (SPS30_ENABLE_UART == 1)
+        if (a_sps30_link_uart_deinit(handle) != 0)                                                   /* uart deinit */
         {
             handle->debug_print("sps30: uart deinit failed.\n");                                     /* uart deinit failed */
         
             return 1;                                                                                /* return error */
         }
+#endif
     }
     else
     {
-        res = a_sps30_iic_write(handle, SPS30_ADDRESS, SPS30_IIC_COMMAND_RESET, NULL, 0, 100);       /* reset command */
-        if (res != 0)                                                                                /* check result */
-        {
-            handle->debug_print("sps30: reset failed.\n");                                           /* reset failed */
-           
-            return 4;                                                                                /* return error */
-        }
-        res = handle->iic_deinit();                                                                  /* iic deinit */
-        if (res != 0)                                                                                /* check result */
+#if (SPS30_ENABLE_IIC == 1)
+        if (a_sps30_link_iic_deinit(handle) != 0)                                                    /* iic deinit */
         {
             handle->debug_print("sps30: iic deinit failed.\n");                                      /* iic deinit */
            
             return 1;                                                                                /* return error */
         }
+#endif
     }
     
     handle->inited = 0;                                                                              /* flag close initialization */
@@ -2154,6 +3980,7 @@ uint8_t sps30_deinit(sps30_handle_t *handle)
     return 0;                                                                                        /* success return 0 */
 }
 
+#if (SPS30_ENABLE_UART == 1)
 /**
  * @brief      set and get the chip register with uart interface
  * @param[in]  *handle pointer to an sps30 handle structure
@@ -2164,7 +3991,8 @@ uint8_t sps30_deinit(sps30_handle_t *handle)
  * @return     status code
  *             - 0 success
  *             - 1 write read failed
- * @note       none
+ *             - 5 handle is busy
+ * @note       both stuffed frames must fit the uart buffer, SPS30_INNER_BUFFER_SIZE bytes unless one is linked
  */
 uint8_t sps30_set_get_reg_uart(sps30_handle_t *handle, uint8_t *input, uint16_t in_len, uint8_t *output, uint16_t out_len)
 {
@@ -2176,10 +4004,17 @@ uint8_t sps30_set_get_reg_uart(sps30_handle_t *handle, uint8_t *input, uint16_t
     {
         return 3;                                                                         /* return error */
     }
+    if (handle->async_state != 0)                                                         /* check state */
+    {
+        handle->debug_print("sps30: handle is busy.\n");                                  /* handle is busy */
+        
+        return 5;                                                                         /* return error */
+    }
 
     if (handle->iic_uart != 0)
     {
-        return a_sps30_uart_write_read(handle, input, in_len, 20, output, out_len);       /* write and read with the uart interface */
+        return a_sps30_uart_write_read(handle, input, in_len, SPS30_TIMING_REGISTER,
+                                       output, out_len);                                  /* write and read with the uart interface */
     }
     else
     {
@@ -2188,7 +4023,9 @@ uint8_t sps30_set_get_reg_uart(sps30_handle_t *handle, uint8_t *input, uint16_t
         return 1;                                                                         /* return error */
     }
 }
+#endif
 
+#if (SPS30_ENABLE_IIC == 1)
 /**
  * @brief     set the chip register with iic interface
  * @param[in] *handle pointer to an sps30 handle structure
@@ -2200,6 +4037,7 @@ uint8_t sps30_set_get_reg_uart(sps30_handle_t *handle, uint8_t *input, uint16_t
  *            - 1 write failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 handle is busy
  * @note      none
  */
 uint8_t sps30_set_reg_iic(sps30_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len)
@@ -2212,6 +4050,12 @@ uint8_t sps30_set_reg_iic(sps30_handle_t *handle, uint16_t reg, uint8_t *buf, ui
     {
         return 3;                                                                 /* return error */
     }
+    if (handle->async_state != 0)                                                 /* check state */
+    {
+        handle->debug_print("sps30: handle is busy.\n");                          /* handle is busy */
+        
+        return 5;                                                                 /* return error */
+    }
 
     if (handle->iic_uart != 0)
     {
@@ -2221,7 +4065,8 @@ uint8_t sps30_set_reg_iic(sps30_handle_t *handle, uint16_t reg, uint8_t *buf, ui
     }
     else
     {
-        return a_sps30_iic_write(handle, SPS30_ADDRESS, reg, buf, len, 20);       /* write the data */
+        return a_sps30_iic_write(handle, SPS30_ADDRESS, reg, buf, len,
+                                 SPS30_TIMING_REGISTER);                          /* write the data */
     }
 }
 
@@ -2236,6 +4081,7 @@ uint8_t sps30_set_reg_iic(sps30_handle_t *handle, uint16_t reg, uint8_t *buf, ui
  *             - 1 read failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 5 handle is busy
  * @note       none
  */
 uint8_t sps30_get_reg_iic(sps30_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len)
@@ -2248,6 +4094,12 @@ uint8_t sps30_get_reg_iic(sps30_handle_t *handle, uint16_t reg, uint8_t *buf, ui
     {
         return 3;                                                                /* return error */
     }
+    if (handle->async_state != 0)                                                /* check state */
+    {
+        handle->debug_print("sps30: handle is busy.\n");                         /* handle is busy */
+        
+        return 5;                                                                /* return error */
+    }
 
     if (handle->iic_uart != 0)
     {
@@ -2257,8 +4109,350 @@ uint8_t sps30_get_reg_iic(sps30_handle_t *handle, uint16_t reg, uint8_t *buf, ui
     }
     else
     {
-        return a_sps30_iic_read(handle, SPS30_ADDRESS, reg, buf, len, 20);       /* read the data */
+        return a_sps30_iic_read(handle, SPS30_ADDRESS, reg, buf, len,
+                                SPS30_TIMING_REGISTER);                          /* read the data */
+    }
+}
+#endif
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief     feed the received uart bytes to the frame parser
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] *buf pointer to a received data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 frame is invalid
+ *            - 2 handle is NULL
+ *            - 4 frame is complete
+ * @note      it can be called from the uart irq or the dma idle line callback,
+ *            bytes are dropped until the driver has written a command frame,
+ *            so it also serves the reset frame sent by sps30_init,
+ *            4 means a checksum verified frame is ready for the pending command,
+ *            after a rejected frame the rest of the bytes are still parsed,
+ *            the end delimiter of the rejected frame may start the next one
+ */
+uint8_t sps30_shdlc_feed(sps30_handle_t *handle, uint8_t *buf, uint16_t len)
+{
+    uint8_t c;
+    uint8_t res;
+    uint16_t i;
+    
+    if ((handle == NULL) || (buf == NULL))                                            /* check handle */
+    {
+        return 2;                                                                     /* return error */
+    }
+    
+#if (SPS30_ENABLE_STATS == 1)
+    handle->stats.rx_bytes += len;                                                    /* count the fed bytes */
+#endif
+    res = 0;                                                                          /* init 0 */
+    for (i = 0; i < len; i++)                                                         /* parse all bytes */
+    {
+        c = buf[i];                                                                   /* get the byte */
+        if (handle->feed_state == 0)                                                  /* parser is stopped */
+        {
+            return res;                                                               /* drop the bytes */
+        }
+        if (c == 0x7E)                                                                /* delimiter */
+        {
+            if ((handle->feed_state == 1) || (handle->feed_point <= 1))               /* start delimiter */
+            {
+                handle->buf[0] = 0x7E;                                                /* set the start */
+                handle->feed_point = 1;                                               /* set point 1 */
+                handle->feed_sum = 0;                                                 /* clear the sum */
+                handle->feed_state = 2;                                               /* in the frame */
+                
+                continue;                                                             /* next byte */
+            }
+            if ((handle->feed_state != 2) || (handle->feed_point < 6) ||
+                (handle->feed_sum != 0xFF) ||
+                (handle->buf[4] != (handle->feed_point - 6)))                         /* check the frame */
+            {
+                handle->feed_done = 2;                                                /* flag the rejected frame */
+                handle->buf[0] = 0x7E;                                                /* set the start */
+                handle->feed_point = 1;                                               /* set point 1 */
+                handle->feed_sum = 0;                                                 /* clear the sum */
+                handle->feed_state = 2;                                               /* in the next frame */
+                res = 1;                                                              /* frame is invalid */
+                
+                continue;                                                             /* next byte */
+            }
+            handle->buf[handle->feed_point] = 0x7E;                                   /* set the end */
+            handle->feed_len = handle->feed_point + 1;                                /* set the frame length */
+            handle->feed_state = 0;                                                   /* stop the parser */
+            handle->feed_done = 1;                                                    /* flag the frame */
+            
+            return 4;                                                                 /* frame is complete */
+        }
+        if (handle->feed_state == 1)                                                  /* no start delimiter yet */
+        {
+            continue;                                                                 /* drop the byte */
+        }
+        if (c == 0x7D)                                                                /* escape */
+        {
+            handle->feed_state = 3;                                                   /* escape the next byte */
+            
+            continue;                                                                 /* next byte */
+        }
+        if (handle->feed_state == 3)                                                  /* escaped byte */
+        {
+            c ^= 0x20;                                                                /* restore the byte */
+            handle->feed_state = 2;                                                   /* in the frame */
+        }
+        if (handle->feed_point >= (handle->buf_size - 1))                             /* check the length */
+        {
+            handle->feed_done = 2;                                                    /* flag the rejected frame */
+            handle->feed_state = 1;                                                   /* hunt the next frame */
+            res = 1;                                                                  /* frame is invalid */
+            
+            continue;                                                                 /* next byte */
+        }
+        handle->buf[handle->feed_point] = c;                                          /* save the byte */
+        handle->feed_point++;                                                         /* point++ */
+        handle->feed_sum = (uint8_t)(handle->feed_sum + c);                           /* add the checksum */
+    }
+    
+    return res;                                                                       /* return the result */
+}
+#endif
+
+#if (SPS30_ENABLE_IIC == 1)
+/**
+ * @brief     calculate the iic crc
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    crc
+ * @note      the crc covers one 2 bytes word in the iic frames
+ */
+uint8_t sps30_iic_crc(uint8_t *data, uint16_t len)
+{
+    return a_sps30_iic_crc(data, len);             /* calculate the crc */
+}
+#endif
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief     calculate the uart checksum
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    checksum
+ * @note      the checksum covers the frame from the address to the last data byte
+ */
+uint8_t sps30_uart_checksum(uint8_t *data, uint16_t len)
+{
+    return a_sps30_uart_checksum(data, len);       /* calculate the checksum */
+}
+
+/**
+ * @brief      stuff a uart frame
+ * @param[in]  *input pointer to a frame buffer
+ * @param[in]  in_len frame length
+ * @param[out] *output pointer to an output buffer
+ * @param[in]  out_size output buffer size
+ * @param[out] *out_len pointer to an output length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 stuff failed
+ *             - 2 buffer is NULL
+ * @note       input is a whole frame from the start to the end delimiter
+ */
+uint8_t sps30_uart_stuff(uint8_t *input, uint16_t in_len, uint8_t *output, uint16_t out_size, uint16_t *out_len)
+{
+    if ((input == NULL) || (output == NULL) || (out_len == NULL))                     /* check buffer */
+    {
+        return 2;                                                                     /* return error */
+    }
+    
+    return a_sps30_uart_stuff(input, in_len, output, out_size, out_len);              /* stuff the frame */
+}
+
+/**
+ * @brief      unstuff a uart frame
+ * @param[in]  *input pointer to a stuffed frame buffer
+ * @param[in]  in_len stuffed frame length
+ * @param[out] *output pointer to an output buffer
+ * @param[in]  out_size output buffer size
+ * @param[out] *out_len pointer to an output length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 unstuff failed
+ *             - 2 buffer is NULL
+ * @note       input is a whole frame from the start to the end delimiter
+ */
+uint8_t sps30_uart_unstuff(uint8_t *input, uint16_t in_len, uint8_t *output, uint16_t out_size, uint16_t *out_len)
+{
+    if ((input == NULL) || (output == NULL) || (out_len == NULL))                     /* check buffer */
+    {
+        return 2;                                                                     /* return error */
+    }
+    
+    return a_sps30_uart_unstuff(input, in_len, output, out_size, out_len);            /* unstuff the frame */
+}
+#endif
+
+#if (SPS30_ENABLE_FLOAT == 1) && (SPS30_ENABLE_IIC == 1)
+/**
+ * @brief      decode a batch of iic measured values frames
+ * @param[in]  *raw pointer to the raw frames buffer
+ * @param[in]  n number of frames
+ * @param[in]  format data format
+ * @param[out] *soa pointer to an sps30 pm soa structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 some frames have a crc error
+ *             - 2 buffer is NULL
+ *             - 4 format is invalid
+ * @note       every raw frame is the whole measured values read with the crc bytes,
+ *             60 bytes with ieee754 and 30 bytes with uint16, back to back,
+ *             the columns of a frame with a crc error are set to 0,
+ *             a NULL column is skipped
+ */
+uint8_t sps30_decode_batch(uint8_t *raw, uint16_t n, sps30_format_t format, sps30_pm_soa_t *soa)
+{
+    union float_u
+    {
+        float f;
+        uint32_t i;
+    };
+    union float_u f;
+    float *column[10];
+    uint8_t *frame;
+    uint8_t res;
+    uint8_t ok;
+    uint8_t i;
+    uint16_t k;
+    uint16_t words;
+    
+    if ((raw == NULL) || (soa == NULL))                                                              /* check buffer */
+    {
+        return 2;                                                                                    /* return error */
+    }
+    if ((format != SPS30_FORMAT_IEEE754) && (format != SPS30_FORMAT_UINT16))                         /* check format */
+    {
+        return 4;                                                                                    /* return error */
+    }
+    
+    words = (format == SPS30_FORMAT_IEEE754) ? 20 : 10;                                              /* set the words */
+    column[0] = soa->pm1p0_ug_m3;                                                                    /* pm1.0 ug/m3 */
+    column[1] = soa->pm2p5_ug_m3;                                                                    /* pm2.5 ug/m3 */
+    column[2] = soa->pm4p0_ug_m3;                                                                    /* pm4.0 ug/m3 */
+    column[3] = soa->pm10_ug_m3;                                                                     /* pm10 ug/m3 */
+    column[4] = soa->pm0p5_cm3;                                                                      /* pm0.5 cm3 */
+    column[5] = soa->pm1p0_cm3;                                                                      /* pm1.0 cm3 */
+    column[6] = soa->pm2p5_cm3;                                                                      /* pm2.5 cm3 */
+    column[7] = soa->pm4p0_cm3;                                                                      /* pm4.0 cm3 */
+    column[8] = soa->pm10_cm3;                                                                       /* pm10 cm3 */
+    column[9] = soa->typical_particle_um;                                                            /* typical particle um */
+    res = 0;                                                                                         /* init 0 */
+    for (k = 0; k < n; k++)                                                                          /* decode all frames */
+    {
+        frame = &raw[(uint32_t)k * words * 3];                                                       /* get the frame */
+        ok = 1;                                                                                      /* init 1 */
+        for (i = 0; i < words; i++)                                                                  /* check all words */
+        {
+            if (gs_sps30_crc8_table[gs_sps30_crc8_table[0xFF ^ frame[i * 3 + 0]] ^
+                                    frame[i * 3 + 1]] != frame[i * 3 + 2])                           /* check crc */
+            {
+                ok = 0;                                                                              /* crc error */
+                
+                break;                                                                               /* break */
+            }
+        }
+        if (soa->valid != NULL)                                                                      /* check the valid column */
+        {
+            soa->valid[k] = ok;                                                                      /* set the flag */
+        }
+        for (i = 0; i < 10; i++)                                                                     /* decode 10 values */
+        {
+            if (column[i] == NULL)                                                                   /* skip the column */
+            {
+                continue;                                                                            /* next column */
+            }
+            if (ok == 0)                                                                             /* crc error */
+            {
+                column[i][k] = 0.0f;                                                                 /* clear the value */
+            }
+            else if (format == SPS30_FORMAT_IEEE754)                                                 /* float */
+            {
+                f.i = (uint32_t)(frame[i * 6 + 0]) << 24 | (uint32_t)(frame[i * 6 + 1]) << 16 |
+                      (uint32_t)(frame[i * 6 + 3]) << 8 | (uint32_t)(frame[i * 6 + 4]) << 0;        /* skip the crc bytes */
+                column[i][k] = f.f;                                                                  /* set the value */
+            }
+            else                                                                                     /* uint16 */
+            {
+                column[i][k] = (float)(((uint16_t)(frame[i * 3 + 0]) << 8) |
+                                       ((uint16_t)(frame[i * 3 + 1]) << 0));                         /* set the value */
+            }
+        }
+        if ((ok != 0) && (format == SPS30_FORMAT_UINT16) && (column[9] != NULL))                     /* typical particle size */
+        {
+            column[9][k] /= 1000.0f;                                                                 /* div 1000 */
+        }
+        if (ok == 0)                                                                                 /* crc error */
+        {
+            res = 1;                                                                                 /* flag the error */
+        }
+    }
+    
+    return res;                                                                                      /* return the result */
+}
+#endif
+
+#if (SPS30_ENABLE_FLOAT == 1)
+/**
+ * @brief      decode a raw sample
+ * @param[in]  *raw pointer to an sps30 raw sample structure
+ * @param[out] *pm pointer to an sps30 pm structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ *             - 4 format is invalid
+ * @note       it needs no handle, so it can run on the host
+ */
+uint8_t sps30_decode_raw(sps30_raw_sample_t *raw, sps30_pm_t *pm)
+{
+    if ((raw == NULL) || (pm == NULL))                                                               /* check buffer */
+    {
+        return 2;                                                                                    /* return error */
+    }
+    if (((raw->format != SPS30_FORMAT_IEEE754) || (raw->len != 40)) &&                               /* check format */
+        ((raw->format != SPS30_FORMAT_UINT16) || (raw->len != 20)))
+    {
+        return 4;                                                                                    /* return error */
+    }
+    
+    a_sps30_decode_pm(raw->format, (uint8_t *)raw->payload, SPS30_FIELD_ALL, pm);                    /* decode the values */
+    
+    return 0;                                                                                        /* success return 0 */
+}
+#endif
+
+/**
+ * @brief      decode a raw sample as integers
+ * @param[in]  *raw pointer to an sps30 raw sample structure
+ * @param[out] *pm pointer to an sps30 pm u16 structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ *             - 4 format is invalid
+ * @note       only the SPS30_FORMAT_UINT16 samples can be decoded
+ */
+uint8_t sps30_decode_raw_u16(sps30_raw_sample_t *raw, sps30_pm_u16_t *pm)
+{
+    if ((raw == NULL) || (pm == NULL))                                                               /* check buffer */
+    {
+        return 2;                                                                                    /* return error */
+    }
+    if ((raw->format != SPS30_FORMAT_UINT16) || (raw->len != 20))                                    /* check format */
+    {
+        return 4;                                                                                    /* return error */
     }
+    
+    a_sps30_decode_pm_u16((uint8_t *)raw->payload, pm);                                              /* decode the values */
+    
+    return 0;                                                                                        /* success return 0 */
 }
 
 /**
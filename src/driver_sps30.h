@@ -45,6 +45,85 @@
 extern "C"{
 #endif
 
+/**
+ * @brief enable the float api, set 0 to build an integer only driver
+ */
+#ifndef SPS30_ENABLE_FLOAT
+    #define SPS30_ENABLE_FLOAT    1
+#endif
+
+/**
+ * @brief enable the iic interface, set 0 to build a uart only driver
+ */
+#ifndef SPS30_ENABLE_IIC
+    #define SPS30_ENABLE_IIC      1
+#endif
+
+/**
+ * @brief enable the uart interface, set 0 to build an iic only driver
+ */
+#ifndef SPS30_ENABLE_UART
+    #define SPS30_ENABLE_UART     1
+#endif
+
+/**
+ * @brief call the sps30_port functions directly, set 1 to bind the bus and delay functions at link time,
+ *        interface/driver_sps30_port_template.c lists the functions to provide
+ */
+#ifndef SPS30_STATIC_PORT
+    #define SPS30_STATIC_PORT     0
+#endif
+
+/**
+ * @brief call sps30_port_now_us for the trace, stats and direct read time, set 1 when the static port has a monotonic clock
+ */
+#ifndef SPS30_STATIC_PORT_CLOCK
+    #define SPS30_STATIC_PORT_CLOCK    0
+#endif
+
+/**
+ * @brief inner uart buffer size, set 0 to use only the buffer linked by DRIVER_SPS30_LINK_BUFFER,
+ *        the default fits the largest driver frame, raw sps30_set_get_reg_uart frames that stuff
+ *        to more bytes need a larger size or a linked buffer
+ */
+#ifndef SPS30_INNER_BUFFER_SIZE
+    #define SPS30_INNER_BUFFER_SIZE    SPS30_BUFFER_MIN_SIZE
+#endif
+
+/**
+ * @brief enable the per handle statistics, set 1 to count transactions, errors and latency
+ */
+#ifndef SPS30_ENABLE_STATS
+    #define SPS30_ENABLE_STATS    0
+#endif
+
+/**
+ * @brief enable the bus trace hook, set 1 to pass every bus transaction to the linked trace function
+ */
+#ifndef SPS30_ENABLE_TRACE
+    #define SPS30_ENABLE_TRACE    0
+#endif
+
+/**
+ * @brief auto tune guard band in percent, added to the smallest working timing and at least one search step
+ */
+#ifndef SPS30_AUTO_TUNE_MARGIN
+    #define SPS30_AUTO_TUNE_MARGIN    25
+#endif
+
+/**
+ * @brief minimum uart buffer size, the measured values frame with every byte stuffed
+ */
+#define SPS30_BUFFER_MIN_SIZE    92
+
+#if (SPS30_ENABLE_IIC != 1) && (SPS30_ENABLE_UART != 1)
+    #error "sps30: at least one interface must be enabled."
+#endif
+
+#if (SPS30_INNER_BUFFER_SIZE != 0) && (SPS30_INNER_BUFFER_SIZE < SPS30_BUFFER_MIN_SIZE)
+    #error "sps30: inner buffer size is too small."
+#endif
+
 /**
  * @defgroup sps30_driver sps30 driver function
  * @brief    sps30 driver modules
@@ -93,28 +172,229 @@ typedef enum
     SPS30_STATUS_FAN_ERROR       = (1 << 4),        /**< fan is switched on but the measured fan speed is 0 rpm */
 } sps30_status_t;
 
+/**
+ * @brief sps30 uart receive mode enumeration definition
+ */
+typedef enum
+{
+    SPS30_UART_RECEIVE_MODE_DELAY = 0x00,        /**< wait the whole command delay and read once */
+    SPS30_UART_RECEIVE_MODE_FRAME = 0x01,        /**< read until the frame end delimiter or the deadline */
+    SPS30_UART_RECEIVE_MODE_FEED  = 0x02,        /**< wait for a frame pushed by sps30_shdlc_feed */
+} sps30_uart_receive_mode_t;
+
+/**
+ * @brief sps30 read mode enumeration definition
+ */
+typedef enum
+{
+    SPS30_READ_MODE_CHECK_FLAG = 0x00,        /**< check the data ready flag before reading, iic only */
+    SPS30_READ_MODE_DIRECT     = 0x01,        /**< read the measured values directly at the caller cadence */
+} sps30_read_mode_t;
+
+/**
+ * @brief sps30 field enumeration definition
+ */
+typedef enum
+{
+    SPS30_FIELD_PM1P0_UG_M3         = 0x0001,        /**< mass concentration pm1.0 */
+    SPS30_FIELD_PM2P5_UG_M3         = 0x0002,        /**< mass concentration pm2.5 */
+    SPS30_FIELD_PM4P0_UG_M3         = 0x0004,        /**< mass concentration pm4.0 */
+    SPS30_FIELD_PM10_UG_M3          = 0x0008,        /**< mass concentration pm10 */
+    SPS30_FIELD_PM0P5_CM3           = 0x0010,        /**< number concentration pm0.5 */
+    SPS30_FIELD_PM1P0_CM3           = 0x0020,        /**< number concentration pm1.0 */
+    SPS30_FIELD_PM2P5_CM3           = 0x0040,        /**< number concentration pm2.5 */
+    SPS30_FIELD_PM4P0_CM3           = 0x0080,        /**< number concentration pm4.0 */
+    SPS30_FIELD_PM10_CM3            = 0x0100,        /**< number concentration pm10 */
+    SPS30_FIELD_TYPICAL_PARTICLE_UM = 0x0200,        /**< typical particle size */
+    SPS30_FIELD_MASS                = 0x000F,        /**< all mass concentrations */
+    SPS30_FIELD_NUMBER              = 0x01F0,        /**< all number concentrations */
+    SPS30_FIELD_ALL                 = 0x03FF,        /**< all fields */
+} sps30_field_t;
+
+/**
+ * @brief sps30 timing enumeration definition
+ */
+typedef enum
+{
+    SPS30_TIMING_START_MEASUREMENT       = 0x00,        /**< start measurement, 20 ms */
+    SPS30_TIMING_STOP_MEASUREMENT        = 0x01,        /**< stop measurement, 20 ms */
+    SPS30_TIMING_READ_DATA_READY_FLAG    = 0x02,        /**< read data ready flag, 20 ms */
+    SPS30_TIMING_READ_MEASURED_VALUES    = 0x03,        /**< read measured values, 20 ms */
+    SPS30_TIMING_SLEEP                   = 0x04,        /**< sleep, 5 ms */
+    SPS30_TIMING_WAKE_UP                 = 0x05,        /**< wake up, 100 ms */
+    SPS30_TIMING_START_FAN_CLEANING      = 0x06,        /**< start fan cleaning, 20 ms */
+    SPS30_TIMING_AUTO_CLEANING_INTERVAL  = 0x07,        /**< read and write auto cleaning interval, 20 ms */
+    SPS30_TIMING_PRODUCT_TYPE            = 0x08,        /**< read product type, 20 ms */
+    SPS30_TIMING_SERIAL_NUMBER           = 0x09,        /**< read serial number, 20 ms */
+    SPS30_TIMING_VERSION                 = 0x0A,        /**< read version, 20 ms */
+    SPS30_TIMING_DEVICE_STATUS           = 0x0B,        /**< read device status, 20 ms */
+    SPS30_TIMING_CLEAR_DEVICE_STATUS     = 0x0C,        /**< clear device status, 20 ms */
+    SPS30_TIMING_RESET                   = 0x0D,        /**< reset, 100 ms */
+    SPS30_TIMING_REGISTER                = 0x0E,        /**< raw register access, 20 ms */
+    SPS30_TIMING_MAX,                                   /**< number of timings, keep it last */
+} sps30_timing_t;
+
+/**
+ * @brief sps30 async command enumeration definition
+ */
+typedef enum
+{
+    SPS30_ASYNC_COMMAND_READ                       = 0x00,        /**< read the measured values */
+    SPS30_ASYNC_COMMAND_READ_DATA_FLAG             = 0x01,        /**< read the data ready flag, iic only */
+    SPS30_ASYNC_COMMAND_START_MEASUREMENT          = 0x02,        /**< start the measurement, param is the format */
+    SPS30_ASYNC_COMMAND_STOP_MEASUREMENT           = 0x03,        /**< stop the measurement */
+    SPS30_ASYNC_COMMAND_SLEEP                      = 0x04,        /**< enter the sleep mode */
+    SPS30_ASYNC_COMMAND_WAKE_UP                    = 0x05,        /**< wake up the chip */
+    SPS30_ASYNC_COMMAND_START_FAN_CLEANING         = 0x06,        /**< start the fan cleaning */
+    SPS30_ASYNC_COMMAND_SET_AUTO_CLEANING_INTERVAL = 0x07,        /**< set the auto cleaning interval, param is the second */
+    SPS30_ASYNC_COMMAND_GET_AUTO_CLEANING_INTERVAL = 0x08,        /**< get the auto cleaning interval, result is the second */
+    SPS30_ASYNC_COMMAND_GET_VERSION                = 0x09,        /**< get the version, result is major << 8 | minor */
+    SPS30_ASYNC_COMMAND_GET_DEVICE_STATUS          = 0x0A,        /**< get the device status, result is the status */
+    SPS30_ASYNC_COMMAND_CLEAR_DEVICE_STATUS        = 0x0B,        /**< clear the device status */
+    SPS30_ASYNC_COMMAND_RESET                      = 0x0C,        /**< reset the chip */
+    SPS30_ASYNC_COMMAND_GET_PRODUCT_TYPE           = 0x0D,        /**< get the product type, polled by sps30_async_poll_string */
+    SPS30_ASYNC_COMMAND_GET_SERIAL_NUMBER          = 0x0E,        /**< get the serial number, polled by sps30_async_poll_string */
+} sps30_async_command_t;
+
+#if (SPS30_ENABLE_STATS == 1)
+/**
+ * @brief sps30 stats command number, one counter for each sps30_timing_t
+ */
+#define SPS30_STATS_COMMAND_NUM    SPS30_TIMING_MAX
+
+/**
+ * @brief sps30 stats latency bucket number
+ * @note  bucket 0 is below 1 ms, bucket n counts [2^(n - 1), 2^n) ms and the last bucket counts the rest
+ */
+#define SPS30_STATS_BUCKET_NUM     12
+
+/**
+ * @brief sps30 stats structure definition
+ * @note  the sync latency is the elapsed time of the linked now_us clock,
+ *        it falls back to the delay time spent by the driver when no clock is linked,
+ *        which is the same for every call of a command, the async latency is the now_ms span
+ */
+typedef struct sps30_stats_s
+{
+    uint32_t transaction;                                    /**< successful bus transactions */
+    uint32_t bus_error;                                      /**< failed bus transactions */
+    uint32_t tx_bytes;                                       /**< bytes written to the bus */
+    uint32_t rx_bytes;                                       /**< bytes read from the bus or fed to the parser */
+    uint32_t crc_error;                                      /**< iic crc and uart checksum errors */
+    uint32_t state_error;                                    /**< uart frames with a non zero state byte */
+    uint32_t delay_ms;                                       /**< time spent in the delay functions in ms */
+    uint32_t delay_us;                                       /**< sub ms remainder of the delay time in us */
+    uint32_t command[SPS30_STATS_COMMAND_NUM];               /**< issued commands indexed by sps30_timing_t */
+    uint32_t command_error[SPS30_STATS_COMMAND_NUM];         /**< failed commands indexed by sps30_timing_t */
+    uint32_t command_latency[SPS30_STATS_BUCKET_NUM];        /**< command latency histogram */
+    uint32_t read_latency[SPS30_STATS_BUCKET_NUM];           /**< measured values read latency histogram */
+} sps30_stats_t;
+#endif
+
+/**
+ * @brief sps30 trace enumeration definition
+ */
+typedef enum
+{
+    SPS30_TRACE_IIC_WRITE  = 0x00,        /**< iic_write_cmd */
+    SPS30_TRACE_IIC_READ   = 0x01,        /**< iic_read_cmd */
+    SPS30_TRACE_UART_WRITE = 0x02,        /**< uart_write */
+    SPS30_TRACE_UART_READ  = 0x03,        /**< uart_read */
+} sps30_trace_t;
+
 /**
  * @brief sps30 handle structure definition
+ * @note  the default build keeps both the plain and the ctx function sets and the 92 byte inner uart buffer,
+ *        so sizeof is 280 bytes on a 32 bit target and 384 bytes on a 64 bit target, it shrinks with
+ *        - SPS30_INNER_BUFFER_SIZE 0 and a buffer linked by DRIVER_SPS30_LINK_BUFFER, 188 and 288 bytes
+ *        - SPS30_ENABLE_UART 0 for an iic only driver, 132 and 192 bytes
+ *        - SPS30_ENABLE_IIC 0 with SPS30_INNER_BUFFER_SIZE 0 for a uart only driver, 156 and 224 bytes
+ *        - SPS30_STATIC_PORT 1 without any function pointer, 84 and 96 bytes with SPS30_ENABLE_UART 0,
+ *        SPS30_ENABLE_STATS and SPS30_ENABLE_TRACE add their counters and hooks
  */
 typedef struct sps30_handle_s
 {
+    uint8_t inited;                                                           /**< inited flag */
+    uint8_t iic_uart;                                                         /**< iic uart */
+    uint8_t format;                                                           /**< format */
+    uint8_t read_mode;                                                        /**< read mode */
+    uint8_t async_state;                                                      /**< async state */
+    uint8_t async_command;                                                    /**< async command */
+    uint8_t async_step;                                                       /**< async step */
+    uint8_t read_valid;                                                       /**< last read time valid flag */
+#if (SPS30_STATIC_PORT != 1)
+#if (SPS30_ENABLE_IIC == 1)
     uint8_t (*iic_init)(void);                                                /**< point to an iic_init function address */
     uint8_t (*iic_deinit)(void);                                              /**< point to an iic_deinit function address */
     uint8_t (*iic_write_cmd)(uint8_t addr, uint8_t *buf, uint16_t len);       /**< point to an iic_write_cmd function address */
     uint8_t (*iic_read_cmd)(uint8_t addr, uint8_t *buf, uint16_t len);        /**< point to an iic_read_cmd function address */
+#endif
+#if (SPS30_ENABLE_UART == 1)
     uint8_t (*uart_init)(void);                                               /**< point to a uart_init function address */
     uint8_t (*uart_deinit)(void);                                             /**< point to a uart_deinit function address */
     uint16_t (*uart_read)(uint8_t *buf, uint16_t len);                        /**< point to a uart_read function address */
     uint8_t (*uart_flush)(void);                                              /**< point to a uart_flush function address */
     uint8_t (*uart_write)(uint8_t *buf, uint16_t len);                        /**< point to a uart_write function address */
+#endif
     void (*delay_ms)(uint32_t ms);                                            /**< point to a delay_ms function address */
+    void (*delay_us)(uint32_t us);                                            /**< point to a delay_us function address */
+#endif
     void (*debug_print)(const char *const fmt, ...);                          /**< point to a debug_print function address */
-    uint8_t inited;                                                           /**< inited flag */
-    uint8_t iic_uart;                                                         /**< iic uart */
-    uint8_t format;                                                           /**< format */
-    uint8_t buf[256];                                                         /**< inner buffer */
+#if (SPS30_STATIC_PORT != 1)
+#if (SPS30_ENABLE_IIC == 1)
+    uint8_t (*iic_init_ctx)(void *user);                                      /**< point to an iic_init_ctx function address */
+    uint8_t (*iic_deinit_ctx)(void *user);                                    /**< point to an iic_deinit_ctx function address */
+    uint8_t (*iic_write_cmd_ctx)(void *user, uint8_t addr,
+                                 uint8_t *buf, uint16_t len);                 /**< point to an iic_write_cmd_ctx function address */
+    uint8_t (*iic_read_cmd_ctx)(void *user, uint8_t addr,
+                                uint8_t *buf, uint16_t len);                  /**< point to an iic_read_cmd_ctx function address */
+#endif
+#if (SPS30_ENABLE_UART == 1)
+    uint8_t (*uart_init_ctx)(void *user);                                     /**< point to a uart_init_ctx function address */
+    uint8_t (*uart_deinit_ctx)(void *user);                                   /**< point to a uart_deinit_ctx function address */
+    uint16_t (*uart_read_ctx)(void *user, uint8_t *buf, uint16_t len);        /**< point to a uart_read_ctx function address */
+    uint8_t (*uart_flush_ctx)(void *user);                                    /**< point to a uart_flush_ctx function address */
+    uint8_t (*uart_write_ctx)(void *user, uint8_t *buf, uint16_t len);        /**< point to a uart_write_ctx function address */
+#endif
+    void (*delay_ms_ctx)(void *user, uint32_t ms);                            /**< point to a delay_ms_ctx function address */
+    void (*delay_us_ctx)(void *user, uint32_t us);                            /**< point to a delay_us_ctx function address */
+#endif
+    void *user;                                                               /**< user context passed to the ctx functions */
+#if (SPS30_ENABLE_TRACE == 1) && (SPS30_STATIC_PORT != 1)
+    void (*trace)(void *user, uint8_t type, uint8_t *buf,
+                  uint16_t len, uint8_t res, uint32_t time_us);               /**< point to a trace function address */
+#endif
+#if (SPS30_ENABLE_TRACE == 1) || (SPS30_ENABLE_STATS == 1)
+#if (SPS30_STATIC_PORT != 1)
+    uint32_t (*now_us)(void);                                                 /**< point to a now_us function address */
+    uint32_t (*now_us_ctx)(void *user);                                       /**< point to a now_us_ctx function address */
+#endif
+    uint32_t delay_time_us;                                                   /**< delay time spent by the driver in us */
+#endif
+#if (SPS30_ENABLE_UART == 1)
+    uint8_t *buf;                                                             /**< uart buffer */
+    uint8_t uart_receive_mode;                                                /**< uart receive mode */
+    uint8_t feed_state;                                                       /**< uart feed parser state */
+    uint8_t feed_sum;                                                         /**< uart feed parser checksum */
+    volatile uint8_t feed_done;                                               /**< uart fed frame flag, 1 done, 2 rejected */
+    uint16_t rx_point;                                                        /**< uart receive point */
+    uint16_t feed_point;                                                      /**< uart feed parser point */
+    uint16_t feed_len;                                                        /**< uart fed frame length */
+    uint16_t buf_size;                                                        /**< uart buffer size */
+#endif
+    uint32_t async_deadline;                                                  /**< async deadline in ms */
+    uint32_t read_last_ms;                                                    /**< last read time in ms */
+    uint32_t timing_us[SPS30_TIMING_MAX];                                     /**< command timing table in us */
+#if (SPS30_ENABLE_STATS == 1)
+    uint32_t stats_begin_ms;                                                  /**< async command begin time in ms */
+    sps30_stats_t stats;                                                      /**< statistics */
+#endif
+#if (SPS30_ENABLE_UART == 1) && (SPS30_INNER_BUFFER_SIZE != 0)
+    uint8_t inner_buf[SPS30_INNER_BUFFER_SIZE];                               /**< inner uart buffer */
+#endif
 } sps30_handle_t;
 
+#if (SPS30_ENABLE_FLOAT == 1)
 /**
  * @brief sps30 pm structure definition
  */
@@ -132,6 +412,52 @@ typedef struct sps30_pm_s
     float typical_particle_um;        /**< typical particle size[um] */
 } sps30_pm_t;
 
+/**
+ * @brief sps30 pm soa structure definition
+ */
+typedef struct sps30_pm_soa_s
+{
+    float *pm1p0_ug_m3;               /**< mass concentration pm1.0 column [μg/m3] */
+    float *pm2p5_ug_m3;               /**< mass concentration pm2.5 column [μg/m3] */
+    float *pm4p0_ug_m3;               /**< mass concentration pm4.0 column [μg/m3] */
+    float *pm10_ug_m3;                /**< mass concentration pm10 column [μg/m3] */
+    float *pm0p5_cm3;                 /**< number concentration pm0.5 column [#/cm3] */
+    float *pm1p0_cm3;                 /**< number concentration pm1.0 column [#/cm3] */
+    float *pm2p5_cm3;                 /**< number concentration pm2.5 column [#/cm3] */
+    float *pm4p0_cm3;                 /**< number concentration pm4.0 column [#/cm3] */
+    float *pm10_cm3;                  /**< number concentration pm10 column [#/cm3] */
+    float *typical_particle_um;       /**< typical particle size column [um] */
+    uint8_t *valid;                   /**< crc valid flag column, can be NULL */
+} sps30_pm_soa_t;
+#endif
+
+/**
+ * @brief sps30 pm u16 structure definition
+ */
+typedef struct sps30_pm_u16_s
+{
+    uint16_t pm1p0_ug_m3;             /**< mass concentration pm1.0 [μg/m3] */
+    uint16_t pm2p5_ug_m3;             /**< mass concentration pm2.5 [μg/m3] */
+    uint16_t pm4p0_ug_m3;             /**< mass concentration pm4.0 [μg/m3] */
+    uint16_t pm10_ug_m3;              /**< mass concentration pm10 [μg/m3] */
+    uint16_t pm0p5_cm3;               /**< number concentration pm0.5 [#/cm3] */
+    uint16_t pm1p0_cm3;               /**< number concentration pm1.0 [#/cm3] */
+    uint16_t pm2p5_cm3;               /**< number concentration pm2.5 [#/cm3] */
+    uint16_t pm4p0_cm3;               /**< number concentration pm4.0 [#/cm3] */
+    uint16_t pm10_cm3;                /**< number concentration pm10 [#/cm3] */
+    uint16_t typical_particle_nm;     /**< typical particle size [nm] */
+} sps30_pm_u16_t;
+
+/**
+ * @brief sps30 raw sample structure definition
+ */
+typedef struct sps30_raw_sample_s
+{
+    uint8_t format;                   /**< data format */
+    uint8_t len;                      /**< payload length */
+    uint8_t payload[40];              /**< big endian payload without the crc bytes */
+} sps30_raw_sample_t;
+
 /**
  * @brief sps30 information structure definition
  */
@@ -167,6 +493,7 @@ typedef struct sps30_info_s
  */
 #define DRIVER_SPS30_LINK_INIT(HANDLE, STRUCTURE)              memset(HANDLE, 0, sizeof(STRUCTURE))
 
+#if (SPS30_ENABLE_UART == 1) && (SPS30_STATIC_PORT != 1)
 /**
  * @brief     link uart_init function
  * @param[in] HANDLE pointer to an sps30 handle structure
@@ -206,7 +533,19 @@ typedef struct sps30_info_s
  * @note      none
  */
 #define DRIVER_SPS30_LINK_UART_FLUSH(HANDLE, FUC)             (HANDLE)->uart_flush = FUC
+#else
+/**
+ * @brief the uart link macros only evaluate their arguments when the uart interface is disabled
+ *        or bound to the sps30_port functions by SPS30_STATIC_PORT
+ */
+#define DRIVER_SPS30_LINK_UART_INIT(HANDLE, FUC)              ((void)(HANDLE), (void)(FUC))
+#define DRIVER_SPS30_LINK_UART_DEINIT(HANDLE, FUC)            ((void)(HANDLE), (void)(FUC))
+#define DRIVER_SPS30_LINK_UART_READ(HANDLE, FUC)              ((void)(HANDLE), (void)(FUC))
+#define DRIVER_SPS30_LINK_UART_WRITE(HANDLE, FUC)             ((void)(HANDLE), (void)(FUC))
+#define DRIVER_SPS30_LINK_UART_FLUSH(HANDLE, FUC)             ((void)(HANDLE), (void)(FUC))
+#endif
 
+#if (SPS30_ENABLE_IIC == 1) && (SPS30_STATIC_PORT != 1)
 /**
  * @brief     link iic_init function
  * @param[in] HANDLE pointer to an sps30 handle structure
@@ -229,35 +568,402 @@ typedef struct sps30_info_s
  * @param[in] FUC pointer to an iic_write_cmd function address
  * @note      none
  */
-#define DRIVER_SPS30_LINK_IIC_WRITE_COMMAND(HANDLE, FUC)      (HANDLE)->iic_write_cmd = FUC
+#define DRIVER_SPS30_LINK_IIC_WRITE_COMMAND(HANDLE, FUC)      (HANDLE)->iic_write_cmd = FUC
+
+/**
+ * @brief     link iic_read_cmd function
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] FUC pointer to an iic_read_cmd function address
+ * @note      none
+ */
+#define DRIVER_SPS30_LINK_IIC_READ_COMMAND(HANDLE, FUC)       (HANDLE)->iic_read_cmd = FUC
+#else
+/**
+ * @brief the iic link macros only evaluate their arguments when the iic interface is disabled
+ *        or bound to the sps30_port functions by SPS30_STATIC_PORT
+ */
+#define DRIVER_SPS30_LINK_IIC_INIT(HANDLE, FUC)               ((void)(HANDLE), (void)(FUC))
+#define DRIVER_SPS30_LINK_IIC_DEINIT(HANDLE, FUC)             ((void)(HANDLE), (void)(FUC))
+#define DRIVER_SPS30_LINK_IIC_WRITE_COMMAND(HANDLE, FUC)      ((void)(HANDLE), (void)(FUC))
+#define DRIVER_SPS30_LINK_IIC_READ_COMMAND(HANDLE, FUC)       ((void)(HANDLE), (void)(FUC))
+#endif
+
+#if (SPS30_STATIC_PORT != 1)
+/**
+ * @brief     link delay_ms function
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] FUC pointer to a delay_ms function address
+ * @note      none
+ */
+#define DRIVER_SPS30_LINK_DELAY_MS(HANDLE, FUC)               (HANDLE)->delay_ms = FUC
+
+/**
+ * @brief     link delay_us function
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] FUC pointer to a delay_us function address
+ * @note      optional, the command timing waits use it instead of delay_ms when it is linked
+ */
+#define DRIVER_SPS30_LINK_DELAY_US(HANDLE, FUC)               (HANDLE)->delay_us = FUC
+#else
+/**
+ * @brief the static port waits with sps30_port_delay_ms and sps30_port_delay_us
+ */
+#define DRIVER_SPS30_LINK_DELAY_MS(HANDLE, FUC)               ((void)(HANDLE), (void)(FUC))
+#define DRIVER_SPS30_LINK_DELAY_US(HANDLE, FUC)               ((void)(HANDLE), (void)(FUC))
+#endif
+
+/**
+ * @brief     link debug_print function
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] FUC pointer to a debug_print function address
+ * @note      none
+ */
+#define DRIVER_SPS30_LINK_DEBUG_PRINT(HANDLE, FUC)            (HANDLE)->debug_print = FUC
+
+/**
+ * @brief     link the user context
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] USER pointer to a user context
+ * @note      the pointer is passed as the first argument of every *_ctx function
+ */
+#define DRIVER_SPS30_LINK_USER_DATA(HANDLE, USER)             (HANDLE)->user = (void *)(USER)
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief     link the uart buffer
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] BUF pointer to a buffer
+ * @param[in] SIZE buffer size, at least SPS30_BUFFER_MIN_SIZE
+ * @note      handles may share one buffer when they never run commands at the same time,
+ *            the inner buffer is used when no buffer is linked
+ */
+#define DRIVER_SPS30_LINK_BUFFER(HANDLE, BUF, SIZE)           ((HANDLE)->buf = (uint8_t *)(BUF), \
+                                                               (HANDLE)->buf_size = (uint16_t)(SIZE))
+#else
+/**
+ * @brief no buffer is linked without the uart interface
+ */
+#define DRIVER_SPS30_LINK_BUFFER(HANDLE, BUF, SIZE)           ((void)(HANDLE), (void)(BUF), (void)(SIZE))
+#endif
+
+#if (SPS30_ENABLE_UART == 1) && (SPS30_STATIC_PORT != 1)
+/**
+ * @brief     link uart_init_ctx function
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] FUC pointer to a uart_init_ctx function address
+ * @note      takes precedence over the function linked without the ctx suffix
+ */
+#define DRIVER_SPS30_LINK_UART_INIT_CTX(HANDLE, FUC)          (HANDLE)->uart_init_ctx = FUC
+
+/**
+ * @brief     link uart_deinit_ctx function
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] FUC pointer to a uart_deinit_ctx function address
+ * @note      takes precedence over the function linked without the ctx suffix
+ */
+#define DRIVER_SPS30_LINK_UART_DEINIT_CTX(HANDLE, FUC)        (HANDLE)->uart_deinit_ctx = FUC
+
+/**
+ * @brief     link uart_read_ctx function
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] FUC pointer to a uart_read_ctx function address
+ * @note      takes precedence over the function linked without the ctx suffix
+ */
+#define DRIVER_SPS30_LINK_UART_READ_CTX(HANDLE, FUC)          (HANDLE)->uart_read_ctx = FUC
+
+/**
+ * @brief     link uart_write_ctx function
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] FUC pointer to a uart_write_ctx function address
+ * @note      takes precedence over the function linked without the ctx suffix
+ */
+#define DRIVER_SPS30_LINK_UART_WRITE_CTX(HANDLE, FUC)         (HANDLE)->uart_write_ctx = FUC
+
+/**
+ * @brief     link uart_flush_ctx function
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] FUC pointer to a uart_flush_ctx function address
+ * @note      takes precedence over the function linked without the ctx suffix
+ */
+#define DRIVER_SPS30_LINK_UART_FLUSH_CTX(HANDLE, FUC)         (HANDLE)->uart_flush_ctx = FUC
+#else
+/**
+ * @brief the uart ctx functions are not linked without the uart interface or with the static port
+ */
+#define DRIVER_SPS30_LINK_UART_INIT_CTX(HANDLE, FUC)          ((void)(HANDLE), (void)(FUC))
+#define DRIVER_SPS30_LINK_UART_DEINIT_CTX(HANDLE, FUC)        ((void)(HANDLE), (void)(FUC))
+#define DRIVER_SPS30_LINK_UART_READ_CTX(HANDLE, FUC)          ((void)(HANDLE), (void)(FUC))
+#define DRIVER_SPS30_LINK_UART_WRITE_CTX(HANDLE, FUC)         ((void)(HANDLE), (void)(FUC))
+#define DRIVER_SPS30_LINK_UART_FLUSH_CTX(HANDLE, FUC)         ((void)(HANDLE), (void)(FUC))
+#endif
+
+#if (SPS30_ENABLE_IIC == 1) && (SPS30_STATIC_PORT != 1)
+/**
+ * @brief     link iic_init_ctx function
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] FUC pointer to an iic_init_ctx function address
+ * @note      takes precedence over the function linked without the ctx suffix
+ */
+#define DRIVER_SPS30_LINK_IIC_INIT_CTX(HANDLE, FUC)           (HANDLE)->iic_init_ctx = FUC
+
+/**
+ * @brief     link iic_deinit_ctx function
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] FUC pointer to an iic_deinit_ctx function address
+ * @note      takes precedence over the function linked without the ctx suffix
+ */
+#define DRIVER_SPS30_LINK_IIC_DEINIT_CTX(HANDLE, FUC)         (HANDLE)->iic_deinit_ctx = FUC
+
+/**
+ * @brief     link iic_write_cmd_ctx function
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] FUC pointer to an iic_write_cmd_ctx function address
+ * @note      takes precedence over the function linked without the ctx suffix
+ */
+#define DRIVER_SPS30_LINK_IIC_WRITE_COMMAND_CTX(HANDLE, FUC)  (HANDLE)->iic_write_cmd_ctx = FUC
+
+/**
+ * @brief     link iic_read_cmd_ctx function
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] FUC pointer to an iic_read_cmd_ctx function address
+ * @note      takes precedence over the function linked without the ctx suffix
+ */
+#define DRIVER_SPS30_LINK_IIC_READ_COMMAND_CTX(HANDLE, FUC)   (HANDLE)->iic_read_cmd_ctx = FUC
+#else
+/**
+ * @brief the iic ctx functions are not linked without the iic interface or with the static port
+ */
+#define DRIVER_SPS30_LINK_IIC_INIT_CTX(HANDLE, FUC)           ((void)(HANDLE), (void)(FUC))
+#define DRIVER_SPS30_LINK_IIC_DEINIT_CTX(HANDLE, FUC)         ((void)(HANDLE), (void)(FUC))
+#define DRIVER_SPS30_LINK_IIC_WRITE_COMMAND_CTX(HANDLE, FUC)  ((void)(HANDLE), (void)(FUC))
+#define DRIVER_SPS30_LINK_IIC_READ_COMMAND_CTX(HANDLE, FUC)   ((void)(HANDLE), (void)(FUC))
+#endif
+
+#if (SPS30_STATIC_PORT != 1)
+/**
+ * @brief     link delay_ms_ctx function
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] FUC pointer to a delay_ms_ctx function address
+ * @note      takes precedence over the function linked without the ctx suffix
+ */
+#define DRIVER_SPS30_LINK_DELAY_MS_CTX(HANDLE, FUC)           (HANDLE)->delay_ms_ctx = FUC
+
+/**
+ * @brief     link delay_us_ctx function
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] FUC pointer to a delay_us_ctx function address
+ * @note      takes precedence over the function linked without the ctx suffix
+ */
+#define DRIVER_SPS30_LINK_DELAY_US_CTX(HANDLE, FUC)           (HANDLE)->delay_us_ctx = FUC
+#else
+/**
+ * @brief the delay ctx functions have no field in a static port handle
+ */
+#define DRIVER_SPS30_LINK_DELAY_MS_CTX(HANDLE, FUC)           ((void)(HANDLE), (void)(FUC))
+#define DRIVER_SPS30_LINK_DELAY_US_CTX(HANDLE, FUC)           ((void)(HANDLE), (void)(FUC))
+#endif
+
+#if (SPS30_ENABLE_TRACE == 1) && (SPS30_STATIC_PORT != 1)
+/**
+ * @brief     link trace function
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] FUC pointer to a trace function address
+ * @note      optional, it gets the user context, the sps30_trace_t type, the bytes, the result
+ *            and the trace clock of every bus transaction
+ */
+#define DRIVER_SPS30_LINK_TRACE(HANDLE, FUC)                  (HANDLE)->trace = FUC
+#elif (SPS30_ENABLE_TRACE == 1)
+/**
+ * @brief the static port passes every transaction to sps30_port_trace
+ */
+#define DRIVER_SPS30_LINK_TRACE(HANDLE, FUC)                  ((void)(HANDLE), (void)(FUC))
+#endif
+
+#if ((SPS30_ENABLE_TRACE == 1) || (SPS30_ENABLE_STATS == 1)) && (SPS30_STATIC_PORT != 1)
+/**
+ * @brief     link now_us function
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] FUC pointer to a now_us function address
+ * @note      optional, a monotonic clock in us for the trace time and the stats latency,
+ *            the delay time spent by the driver since sps30_init is used when no clock is linked
+ */
+#define DRIVER_SPS30_LINK_NOW_US(HANDLE, FUC)                 (HANDLE)->now_us = FUC
+
+/**
+ * @brief     link now_us_ctx function
+ * @param[in] HANDLE pointer to an sps30 handle structure
+ * @param[in] FUC pointer to a now_us_ctx function address
+ * @note      takes precedence over the function linked without the ctx suffix
+ */
+#define DRIVER_SPS30_LINK_NOW_US_CTX(HANDLE, FUC)             (HANDLE)->now_us_ctx = FUC
+#elif (SPS30_ENABLE_TRACE == 1) || (SPS30_ENABLE_STATS == 1)
+/**
+ * @brief the static port clock is sps30_port_now_us with SPS30_STATIC_PORT_CLOCK 1
+ */
+#define DRIVER_SPS30_LINK_NOW_US(HANDLE, FUC)                 ((void)(HANDLE), (void)(FUC))
+#define DRIVER_SPS30_LINK_NOW_US_CTX(HANDLE, FUC)             ((void)(HANDLE), (void)(FUC))
+#endif
+
+/**
+ * @}
+ */
+
+#if (SPS30_STATIC_PORT == 1)
+/**
+ * @defgroup sps30_port_driver sps30 port driver function
+ * @brief    sps30 port driver modules, provided by the application when SPS30_STATIC_PORT is 1
+ * @ingroup  sps30_driver
+ * @{
+ */
+
+#if (SPS30_ENABLE_IIC == 1)
+/**
+ * @brief     port iic init
+ * @param[in] *user pointer to the user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      none
+ */
+uint8_t sps30_port_iic_init(void *user);
+
+/**
+ * @brief     port iic deinit
+ * @param[in] *user pointer to the user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
+ */
+uint8_t sps30_port_iic_deinit(void *user);
+
+/**
+ * @brief     port iic write command
+ * @param[in] *user pointer to the user context
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t sps30_port_iic_write_cmd(void *user, uint8_t addr, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      port iic read command
+ * @param[in]  *user pointer to the user context
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t sps30_port_iic_read_cmd(void *user, uint8_t addr, uint8_t *buf, uint16_t len);
+#endif
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief     port uart init
+ * @param[in] *user pointer to the user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart init failed
+ * @note      none
+ */
+uint8_t sps30_port_uart_init(void *user);
+
+/**
+ * @brief     port uart deinit
+ * @param[in] *user pointer to the user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart deinit failed
+ * @note      none
+ */
+uint8_t sps30_port_uart_deinit(void *user);
+
+/**
+ * @brief      port uart read
+ * @param[in]  *user pointer to the user context
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     length of the read data
+ * @note       none
+ */
+uint16_t sps30_port_uart_read(void *user, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     port uart flush
+ * @param[in] *user pointer to the user context
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart flush failed
+ * @note      none
+ */
+uint8_t sps30_port_uart_flush(void *user);
+
+/**
+ * @brief     port uart write
+ * @param[in] *user pointer to the user context
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t sps30_port_uart_write(void *user, uint8_t *buf, uint16_t len);
+#endif
+
+/**
+ * @brief     port delay ms
+ * @param[in] *user pointer to the user context
+ * @param[in] ms time
+ * @note      none
+ */
+void sps30_port_delay_ms(void *user, uint32_t ms);
 
 /**
- * @brief     link iic_read_cmd function
- * @param[in] HANDLE pointer to an sps30 handle structure
- * @param[in] FUC pointer to an iic_read_cmd function address
- * @note      none
+ * @brief     port delay us
+ * @param[in] *user pointer to the user context
+ * @param[in] us time
+ * @note      the command timing runs the whole ms with sps30_port_delay_ms and the remainder with it
  */
-#define DRIVER_SPS30_LINK_IIC_READ_COMMAND(HANDLE, FUC)       (HANDLE)->iic_read_cmd = FUC
+void sps30_port_delay_us(void *user, uint32_t us);
 
+#if (SPS30_ENABLE_TRACE == 1)
 /**
- * @brief     link delay_ms function
- * @param[in] HANDLE pointer to an sps30 handle structure
- * @param[in] FUC pointer to a delay_ms function address
- * @note      none
+ * @brief     port trace
+ * @param[in] *user pointer to the user context
+ * @param[in] type sps30_trace_t transaction type
+ * @param[in] *buf pointer to the transaction bytes
+ * @param[in] len transaction length
+ * @param[in] res transaction result
+ * @param[in] time_us trace clock in us
+ * @note      the bytes of a failed read are undefined,
+ *            the trace clock is sps30_port_now_us when SPS30_STATIC_PORT_CLOCK is 1,
+ *            else the delay time spent by the driver since sps30_init
  */
-#define DRIVER_SPS30_LINK_DELAY_MS(HANDLE, FUC)               (HANDLE)->delay_ms = FUC
+void sps30_port_trace(void *user, uint8_t type, uint8_t *buf, uint16_t len, uint8_t res, uint32_t time_us);
+#endif
 
+#if (SPS30_STATIC_PORT_CLOCK == 1)
 /**
- * @brief     link debug_print function
- * @param[in] HANDLE pointer to an sps30 handle structure
- * @param[in] FUC pointer to a debug_print function address
- * @note      none
+ * @brief     port get the current time
+ * @param[in] *user pointer to the user context
+ * @return    monotonic time in us
+ * @note      the value may wrap around, only the differences are used
  */
-#define DRIVER_SPS30_LINK_DEBUG_PRINT(HANDLE, FUC)            (HANDLE)->debug_print = FUC
+uint32_t sps30_port_now_us(void *user);
+#endif
 
 /**
  * @}
  */
+#endif
 
 /**
  * @defgroup sps30_basic_driver sps30 basic driver function
@@ -283,7 +989,8 @@ uint8_t sps30_info(sps30_info_t *info);
  * @return    status code
  *            - 0 success
  *            - 2 handle is NULL
- * @note      none
+ *            - 4 interface is disabled
+ * @note      the interface must be enabled by SPS30_ENABLE_IIC or SPS30_ENABLE_UART
  */
 uint8_t sps30_set_interface(sps30_handle_t *handle, sps30_interface_t interface);
 
@@ -298,6 +1005,131 @@ uint8_t sps30_set_interface(sps30_handle_t *handle, sps30_interface_t interface)
  */
 uint8_t sps30_get_interface(sps30_handle_t *handle, sps30_interface_t *interface);
 
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief     set the uart receive mode
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] mode uart receive mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 5 handle is busy
+ * @note      in the frame mode the command delay is used as the deadline
+ */
+uint8_t sps30_set_uart_receive_mode(sps30_handle_t *handle, sps30_uart_receive_mode_t mode);
+
+/**
+ * @brief      get the uart receive mode
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[out] *mode pointer to a uart receive mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t sps30_get_uart_receive_mode(sps30_handle_t *handle, sps30_uart_receive_mode_t *mode);
+#endif
+
+/**
+ * @brief     set the read mode
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] mode read mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 5 handle is busy
+ * @note      the direct mode saves the data ready flag transaction on the iic bus,
+ *            a sync read within 1 s of the last one returns 5 when the linked now_us clock is in the build,
+ *            sps30_read_direct takes the time from the caller, else the caller must keep the 1 s cadence
+ */
+uint8_t sps30_set_read_mode(sps30_handle_t *handle, sps30_read_mode_t mode);
+
+/**
+ * @brief      get the read mode
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[out] *mode pointer to a read mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t sps30_get_read_mode(sps30_handle_t *handle, sps30_read_mode_t *mode);
+
+/**
+ * @brief     set the command timing
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] timing command timing
+ * @param[in] us delay time in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timing is invalid
+ * @note      sps30_init loads the datasheet timing, so call it after sps30_init
+ */
+uint8_t sps30_set_timing(sps30_handle_t *handle, sps30_timing_t timing, uint32_t us);
+
+/**
+ * @brief      get the command timing
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  timing command timing
+ * @param[out] *us pointer to a delay time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timing is invalid
+ * @note       none
+ */
+uint8_t sps30_get_timing(sps30_handle_t *handle, sps30_timing_t timing, uint32_t *us);
+
+/**
+ * @brief      find the smallest working command timing
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  timing command timing
+ * @param[in]  step_us search resolution in us
+ * @param[out] *us pointer to a delay time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 auto tune failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timing can't be tuned
+ *             - 5 handle is busy
+ * @note       only the read commands without side effects can be tuned,
+ *             every candidate must return a valid frame three times in a row,
+ *             the smallest working timing plus SPS30_AUTO_TUNE_MARGIN percent, at least step_us,
+ *             is saved in the timing table, it never exceeds the datasheet timing
+ */
+uint8_t sps30_auto_tune_timing(sps30_handle_t *handle, sps30_timing_t timing, uint32_t step_us, uint32_t *us);
+
+#if (SPS30_ENABLE_STATS == 1)
+/**
+ * @brief      get the statistics
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[out] *stats pointer to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       sync command latency is the elapsed time of the linked now_us clock,
+ *             else the delay time spent by the driver,
+ *             async command latency is the now_ms span between begin and the last poll
+ */
+uint8_t sps30_get_stats(sps30_handle_t *handle, sps30_stats_t *stats);
+
+/**
+ * @brief     reset the statistics
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      sps30_init resets the statistics
+ */
+uint8_t sps30_reset_stats(sps30_handle_t *handle);
+#endif
+
 /**
  * @brief     initialize the chip
  * @param[in] *handle pointer to an sps30 handle structure
@@ -324,6 +1156,7 @@ uint8_t sps30_init(sps30_handle_t *handle);
  */
 uint8_t sps30_deinit(sps30_handle_t *handle);
 
+#if (SPS30_ENABLE_FLOAT == 1)
 /**
  * @brief      read the result
  * @param[in]  *handle pointer to an sps30 handle structure
@@ -334,10 +1167,79 @@ uint8_t sps30_deinit(sps30_handle_t *handle);
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 mode is invalid
+ *             - 5 data is not ready or handle is busy
  * @note       none
  */
 uint8_t sps30_read(sps30_handle_t *handle, sps30_pm_t *pm);
 
+/**
+ * @brief      read the selected fields of the result
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  mask or of the sps30_field_t fields
+ * @param[out] *pm pointer to an sps30 pm structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 mode is invalid
+ *             - 5 data is not ready or handle is busy
+ *             - 6 mask is invalid
+ * @note       the iic read stops after the last selected field, so the mass
+ *             concentrations alone take 40% of the full transfer,
+ *             the fields not selected are left unchanged in pm
+ */
+uint8_t sps30_read_fields(sps30_handle_t *handle, uint16_t mask, sps30_pm_t *pm);
+#endif
+
+/**
+ * @brief      read the result as integers
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[out] *pm pointer to an sps30 pm u16 structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 mode is invalid
+ *             - 5 data is not ready or handle is busy
+ * @note       the measurement must be started with SPS30_FORMAT_UINT16
+ */
+uint8_t sps30_read_u16(sps30_handle_t *handle, sps30_pm_u16_t *pm);
+
+/**
+ * @brief      read the result without decoding
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[out] *raw pointer to an sps30 raw sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 mode is invalid
+ *             - 5 data is not ready or handle is busy
+ * @note       the payload is checked and stored as it is, decode it later with sps30_decode_raw
+ */
+uint8_t sps30_read_raw(sps30_handle_t *handle, sps30_raw_sample_t *raw);
+
+/**
+ * @brief      read the result without decoding at the caller time
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  now_ms current time in ms
+ * @param[out] *raw pointer to an sps30 raw sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 mode is invalid
+ *             - 5 data is not ready or handle is busy
+ * @note       in the direct mode a read within 1 s of the last one is refused
+ *             without any bus transaction, like sps30_read_begin,
+ *             use it when no now_us clock is linked, now_ms must come from the clock of sps30_read_begin
+ */
+uint8_t sps30_read_direct(sps30_handle_t *handle, uint32_t now_ms, sps30_raw_sample_t *raw);
+
 /**
  * @brief     enter the sleep mode
  * @param[in] *handle pointer to an sps30 handle structure
@@ -346,6 +1248,7 @@ uint8_t sps30_read(sps30_handle_t *handle, sps30_pm_t *pm);
  *            - 1 sleep failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 handle is busy
  * @note      none
  */
 uint8_t sps30_sleep(sps30_handle_t *handle);
@@ -358,6 +1261,7 @@ uint8_t sps30_sleep(sps30_handle_t *handle);
  *            - 1 reset failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 handle is busy
  * @note      none
  */
 uint8_t sps30_reset(sps30_handle_t *handle);
@@ -370,6 +1274,7 @@ uint8_t sps30_reset(sps30_handle_t *handle);
  *            - 1 wake up failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 handle is busy
  * @note      none
  */
 uint8_t sps30_wake_up(sps30_handle_t *handle);
@@ -383,6 +1288,7 @@ uint8_t sps30_wake_up(sps30_handle_t *handle);
  *            - 1 start measurement failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 handle is busy
  * @note      none
  */
 uint8_t sps30_start_measurement(sps30_handle_t *handle, sps30_format_t format);
@@ -395,6 +1301,7 @@ uint8_t sps30_start_measurement(sps30_handle_t *handle, sps30_format_t format);
  *            - 1 stop measurement failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 handle is busy
  * @note      none
  */
 uint8_t sps30_stop_measurement(sps30_handle_t *handle);
@@ -408,6 +1315,7 @@ uint8_t sps30_stop_measurement(sps30_handle_t *handle);
  *             - 1 read data read flag failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 5 handle is busy
  * @note       none
  */
 uint8_t sps30_read_data_flag(sps30_handle_t *handle, sps30_data_ready_flag_t *flag);
@@ -420,6 +1328,7 @@ uint8_t sps30_read_data_flag(sps30_handle_t *handle, sps30_data_ready_flag_t *fl
  *            - 1 start fan cleaning failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 handle is busy
  * @note      none
  */
 uint8_t sps30_start_fan_cleaning(sps30_handle_t *handle);
@@ -434,6 +1343,7 @@ uint8_t sps30_start_fan_cleaning(sps30_handle_t *handle);
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 second is invalid
+ *            - 5 handle is busy
  * @note      10 <= second <= 604800
  */
 uint8_t sps30_set_auto_cleaning_interval(sps30_handle_t *handle, uint32_t second);
@@ -447,6 +1357,7 @@ uint8_t sps30_set_auto_cleaning_interval(sps30_handle_t *handle, uint32_t second
  *             - 1 get auto cleaning interval failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 5 handle is busy
  * @note       none
  */
 uint8_t sps30_get_auto_cleaning_interval(sps30_handle_t *handle, uint32_t *second);
@@ -459,6 +1370,7 @@ uint8_t sps30_get_auto_cleaning_interval(sps30_handle_t *handle, uint32_t *secon
  *            - 1 disable auto cleaning interval failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 handle is busy
  * @note      none
  */
 uint8_t sps30_disable_auto_cleaning_interval(sps30_handle_t *handle);
@@ -472,6 +1384,7 @@ uint8_t sps30_disable_auto_cleaning_interval(sps30_handle_t *handle);
  *             - 1 get product type failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 5 handle is busy
  * @note       none
  */
 uint8_t sps30_get_product_type(sps30_handle_t *handle, char type[9]);
@@ -485,6 +1398,7 @@ uint8_t sps30_get_product_type(sps30_handle_t *handle, char type[9]);
  *             - 1 get serial number failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 5 handle is busy
  * @note       none
  */
 uint8_t sps30_get_serial_number(sps30_handle_t *handle, char sn[17]);
@@ -499,6 +1413,7 @@ uint8_t sps30_get_serial_number(sps30_handle_t *handle, char sn[17]);
  *             - 1 get version failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 5 handle is busy
  * @note       none
  */
 uint8_t sps30_get_version(sps30_handle_t *handle, uint8_t *major, uint8_t *minor);
@@ -512,6 +1427,7 @@ uint8_t sps30_get_version(sps30_handle_t *handle, uint8_t *major, uint8_t *minor
  *             - 1 get device status failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 5 handle is busy
  * @note       none
  */
 uint8_t sps30_get_device_status(sps30_handle_t *handle, uint32_t *status);
@@ -524,10 +1440,183 @@ uint8_t sps30_get_device_status(sps30_handle_t *handle, uint32_t *status);
  *            - 1 clear device status failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 handle is busy
  * @note      none
  */
 uint8_t sps30_clear_device_status(sps30_handle_t *handle);
 
+/**
+ * @}
+ */
+
+/**
+ * @defgroup sps30_async_driver sps30 async driver function
+ * @brief    sps30 async driver modules
+ * @ingroup  sps30_driver
+ * @{
+ */
+
+/**
+ * @brief     begin a command without blocking
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] command async command
+ * @param[in] param command param
+ * @param[in] now_ms current time in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 begin failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 command or param is invalid
+ *            - 5 handle is busy
+ * @note      now_ms can be any free running ms counter and may wrap around
+ */
+uint8_t sps30_async_begin(sps30_handle_t *handle, sps30_async_command_t command, uint32_t param, uint32_t now_ms);
+
+/**
+ * @brief      poll the pending command
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  now_ms current time in ms
+ * @param[out] *result pointer to a result buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 command failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 no command is pending
+ *             - 5 command is pending
+ * @note       the read command must be polled by sps30_read_poll,
+ *             the product type and serial number by sps30_async_poll_string
+ */
+uint8_t sps30_async_poll(sps30_handle_t *handle, uint32_t now_ms, uint32_t *result);
+
+/**
+ * @brief      poll the pending product type or serial number command
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  now_ms current time in ms
+ * @param[out] *str pointer to a string buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 command failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 no command is pending
+ *             - 5 command is pending
+ * @note       str must hold 17 chars, the product type has 8 chars and the serial number 16 chars
+ */
+uint8_t sps30_async_poll_string(sps30_handle_t *handle, uint32_t now_ms, char str[17]);
+
+/**
+ * @brief     begin reading the result without blocking
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] now_ms current time in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 begin failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 mode is invalid
+ *            - 5 handle is busy
+ *            - 6 data is not ready
+ * @note      in the direct mode a read within 1 s of the last one is refused
+ *            without any bus transaction
+ */
+uint8_t sps30_read_begin(sps30_handle_t *handle, uint32_t now_ms);
+
+#if (SPS30_ENABLE_FLOAT == 1)
+/**
+ * @brief      poll the pending read
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  now_ms current time in ms
+ * @param[out] *pm pointer to an sps30 pm structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 no read is pending
+ *             - 5 read is pending
+ *             - 6 data is not ready
+ * @note       none
+ */
+uint8_t sps30_read_poll(sps30_handle_t *handle, uint32_t now_ms, sps30_pm_t *pm);
+#endif
+
+/**
+ * @brief      poll the pending read as integers
+ * @param[in]  *handle pointer to an sps30 handle structure
+ * @param[in]  now_ms current time in ms
+ * @param[out] *pm pointer to an sps30 pm u16 structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 no read is pending
+ *             - 5 read is pending
+ *             - 6 data is not ready
+ *             - 7 mode is invalid
+ * @note       the measurement must be started with SPS30_FORMAT_UINT16
+ */
+uint8_t sps30_read_poll_u16(sps30_handle_t *handle, uint32_t now_ms, sps30_pm_u16_t *pm);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup sps30_decode_driver sps30 decode driver function
+ * @brief    sps30 decode driver modules
+ * @ingroup  sps30_driver
+ * @{
+ */
+
+#if (SPS30_ENABLE_FLOAT == 1) && (SPS30_ENABLE_IIC == 1)
+/**
+ * @brief      decode a batch of iic measured values frames
+ * @param[in]  *raw pointer to the raw frames buffer
+ * @param[in]  n number of frames
+ * @param[in]  format data format
+ * @param[out] *soa pointer to an sps30 pm soa structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 some frames have a crc error
+ *             - 2 buffer is NULL
+ *             - 4 format is invalid
+ * @note       every raw frame is the whole measured values read with the crc bytes,
+ *             60 bytes with ieee754 and 30 bytes with uint16, back to back,
+ *             the columns of a frame with a crc error are set to 0,
+ *             a NULL column is skipped
+ */
+uint8_t sps30_decode_batch(uint8_t *raw, uint16_t n, sps30_format_t format, sps30_pm_soa_t *soa);
+#endif
+
+#if (SPS30_ENABLE_FLOAT == 1)
+/**
+ * @brief      decode a raw sample
+ * @param[in]  *raw pointer to an sps30 raw sample structure
+ * @param[out] *pm pointer to an sps30 pm structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ *             - 4 format is invalid
+ * @note       it needs no handle, so it can run on the host
+ */
+uint8_t sps30_decode_raw(sps30_raw_sample_t *raw, sps30_pm_t *pm);
+#endif
+
+/**
+ * @brief      decode a raw sample as integers
+ * @param[in]  *raw pointer to an sps30 raw sample structure
+ * @param[out] *pm pointer to an sps30 pm u16 structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ *             - 4 format is invalid
+ * @note       only the SPS30_FORMAT_UINT16 samples can be decoded
+ */
+uint8_t sps30_decode_raw_u16(sps30_raw_sample_t *raw, sps30_pm_u16_t *pm);
+
 /**
  * @}
  */
@@ -539,6 +1628,7 @@ uint8_t sps30_clear_device_status(sps30_handle_t *handle);
  * @{
  */
 
+#if (SPS30_ENABLE_IIC == 1)
 /**
  * @brief     set the chip register with iic interface
  * @param[in] *handle pointer to an sps30 handle structure
@@ -550,6 +1640,7 @@ uint8_t sps30_clear_device_status(sps30_handle_t *handle);
  *            - 1 write failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 5 handle is busy
  * @note      none
  */
 uint8_t sps30_set_reg_iic(sps30_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len);
@@ -565,10 +1656,13 @@ uint8_t sps30_set_reg_iic(sps30_handle_t *handle, uint16_t reg, uint8_t *buf, ui
  *             - 1 read failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 5 handle is busy
  * @note       none
  */
 uint8_t sps30_get_reg_iic(sps30_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len);
+#endif
 
+#if (SPS30_ENABLE_UART == 1)
 /**
  * @brief      set and get the chip register with uart interface
  * @param[in]  *handle pointer to an sps30 handle structure
@@ -579,10 +1673,83 @@ uint8_t sps30_get_reg_iic(sps30_handle_t *handle, uint16_t reg, uint8_t *buf, ui
  * @return     status code
  *             - 0 success
  *             - 1 write read failed
- * @note       none
+ *             - 5 handle is busy
+ * @note       both stuffed frames must fit the uart buffer, SPS30_INNER_BUFFER_SIZE bytes unless one is linked
  */
 uint8_t sps30_set_get_reg_uart(sps30_handle_t *handle, uint8_t *input, uint16_t in_len, uint8_t *output, uint16_t out_len);
 
+/**
+ * @brief     feed the received uart bytes to the frame parser
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] *buf pointer to a received data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 frame is invalid
+ *            - 2 handle is NULL
+ *            - 4 frame is complete
+ * @note      it can be called from the uart irq or the dma idle line callback,
+ *            bytes are dropped until the driver has written a command frame,
+ *            so it also serves the reset frame sent by sps30_init,
+ *            4 means a checksum verified frame is ready for the pending command,
+ *            after a rejected frame the rest of the bytes are still parsed,
+ *            the end delimiter of the rejected frame may start the next one
+ */
+uint8_t sps30_shdlc_feed(sps30_handle_t *handle, uint8_t *buf, uint16_t len);
+#endif
+
+#if (SPS30_ENABLE_IIC == 1)
+/**
+ * @brief     calculate the iic crc
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    crc
+ * @note      the crc covers one 2 bytes word in the iic frames
+ */
+uint8_t sps30_iic_crc(uint8_t *data, uint16_t len);
+#endif
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief     calculate the uart checksum
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    checksum
+ * @note      the checksum covers the frame from the address to the last data byte
+ */
+uint8_t sps30_uart_checksum(uint8_t *data, uint16_t len);
+
+/**
+ * @brief      stuff a uart frame
+ * @param[in]  *input pointer to a frame buffer
+ * @param[in]  in_len frame length
+ * @param[out] *output pointer to an output buffer
+ * @param[in]  out_size output buffer size
+ * @param[out] *out_len pointer to an output length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 stuff failed
+ *             - 2 buffer is NULL
+ * @note       input is a whole frame from the start to the end delimiter
+ */
+uint8_t sps30_uart_stuff(uint8_t *input, uint16_t in_len, uint8_t *output, uint16_t out_size, uint16_t *out_len);
+
+/**
+ * @brief      unstuff a uart frame
+ * @param[in]  *input pointer to a stuffed frame buffer
+ * @param[in]  in_len stuffed frame length
+ * @param[out] *output pointer to an output buffer
+ * @param[in]  out_size output buffer size
+ * @param[out] *out_len pointer to an output length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 unstuff failed
+ *             - 2 buffer is NULL
+ * @note       input is a whole frame from the start to the end delimiter
+ */
+uint8_t sps30_uart_unstuff(uint8_t *input, uint16_t in_len, uint8_t *output, uint16_t out_size, uint16_t *out_len);
+#endif
+
 /**
  * @}
  */
@@ -0,0 +1,683 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_sps30_api_bench_test.c
+ * @brief     driver sps30 api bench test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_sps30_api_bench_test.h"
+#include "driver_sps30_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief api bench test definition
+ */
+#define SPS30_API_BENCH_MAX_CALLS        100000         /**< max calls of one api */
+#define SPS30_API_BENCH_NONE             0xFF           /**< no interface or no measurement */
+#define SPS30_API_BENCH_FLAG_TX          2              /**< iic read data ready flag bytes sent */
+#define SPS30_API_BENCH_FLAG_RX          3              /**< iic read data ready flag bytes received */
+
+/**
+ * @brief api bench case structure definition
+ */
+typedef struct sps30_api_bench_case_s
+{
+    const char *name;                   /**< api name */
+    uint8_t interface;                  /**< chip interface */
+    uint8_t format;                     /**< measurement format */
+    uint8_t sample;                     /**< 1 if every call needs a new sample */
+    uint8_t (*run)(void);               /**< one call of the api */
+} sps30_api_bench_case_t;
+
+static sps30_handle_t gs_handle;                             /**< sps30 handle */
+static sps30_sim_t gs_sim;                                   /**< sps30 simulator */
+static uint32_t gs_latency[SPS30_API_BENCH_MAX_CALLS];       /**< latency of every call */
+static uint64_t gs_tx_bytes;                                 /**< bus bytes sent */
+static uint64_t gs_rx_bytes;                                 /**< bus bytes received */
+static uint8_t gs_frame[47];                                 /**< measured values frame */
+#if (SPS30_ENABLE_UART == 1)
+static uint8_t gs_stuffed[256];                              /**< stuffed frame */
+static uint16_t gs_stuffed_len;                              /**< stuffed frame length */
+#endif
+static sps30_raw_sample_t gs_raw;                            /**< raw sample */
+#if (SPS30_ENABLE_FLOAT == 1)
+static sps30_pm_t gs_pm;                                     /**< pm output */
+#endif
+static sps30_pm_u16_t gs_pm_u16;                             /**< pm u16 output */
+static volatile uint32_t gs_sink;                            /**< keep the results alive */
+static int gs_perf_fd = -1;                                  /**< instructions counter */
+
+/**
+ * @brief     counting iic write
+ * @param[in] *user pointer to a simulator structure
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_sps30_api_bench_iic_write_cmd(void *user, uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    gs_tx_bytes += len;
+    
+    return sps30_sim_iic_write_cmd(user, addr, buf, len);
+}
+
+/**
+ * @brief      counting iic read
+ * @param[in]  *user pointer to a simulator structure
+ * @param[in]  addr iic device read address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_sps30_api_bench_iic_read_cmd(void *user, uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    gs_rx_bytes += len;
+    
+    return sps30_sim_iic_read_cmd(user, addr, buf, len);
+}
+
+/**
+ * @brief      counting uart read
+ * @param[in]  *user pointer to a simulator structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     length of the read data
+ * @note       none
+ */
+static uint16_t a_sps30_api_bench_uart_read(void *user, uint8_t *buf, uint16_t len)
+{
+    uint16_t n;
+    
+    n = sps30_sim_uart_read(user, buf, len);
+    gs_rx_bytes += n;
+    
+    return n;
+}
+
+/**
+ * @brief     counting uart write
+ * @param[in] *user pointer to a simulator structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_sps30_api_bench_uart_write(void *user, uint8_t *buf, uint16_t len)
+{
+    gs_tx_bytes += len;
+    
+    return sps30_sim_uart_write(user, buf, len);
+}
+
+#if (SPS30_ENABLE_FLOAT == 1)
+/**
+ * @brief  run sps30_read once
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_sps30_api_bench_read(void)
+{
+    return sps30_read(&gs_handle, &gs_pm);
+}
+#endif
+
+/**
+ * @brief  run sps30_read_u16 once
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_sps30_api_bench_read_u16(void)
+{
+    return sps30_read_u16(&gs_handle, &gs_pm_u16);
+}
+
+/**
+ * @brief  run sps30_read_raw once
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_sps30_api_bench_read_raw(void)
+{
+    return sps30_read_raw(&gs_handle, &gs_raw);
+}
+
+/**
+ * @brief  run sps30_read_data_flag once
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_sps30_api_bench_read_data_flag(void)
+{
+    sps30_data_ready_flag_t flag;
+    
+    return sps30_read_data_flag(&gs_handle, &flag);
+}
+
+/**
+ * @brief  run sps30_get_device_status once
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_sps30_api_bench_get_device_status(void)
+{
+    uint32_t status;
+    
+    return sps30_get_device_status(&gs_handle, &status);
+}
+
+/**
+ * @brief  run sps30_get_product_type once
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_sps30_api_bench_get_product_type(void)
+{
+    char type[9];
+    
+    return sps30_get_product_type(&gs_handle, type);
+}
+
+/**
+ * @brief  run sps30_get_serial_number once
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_sps30_api_bench_get_serial_number(void)
+{
+    char sn[17];
+    
+    return sps30_get_serial_number(&gs_handle, sn);
+}
+
+/**
+ * @brief  run sps30_get_version once
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_sps30_api_bench_get_version(void)
+{
+    uint8_t major;
+    uint8_t minor;
+    
+    return sps30_get_version(&gs_handle, &major, &minor);
+}
+
+/**
+ * @brief  run sps30_get_auto_cleaning_interval once
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_sps30_api_bench_get_auto_cleaning_interval(void)
+{
+    uint32_t second;
+    
+    return sps30_get_auto_cleaning_interval(&gs_handle, &second);
+}
+
+#if (SPS30_ENABLE_IIC == 1)
+/**
+ * @brief  run sps30_iic_crc once
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_sps30_api_bench_iic_crc(void)
+{
+    gs_sink += sps30_iic_crc(&gs_frame[5 + (gs_sink & 0x1F)], 2);
+    
+    return 0;
+}
+#endif
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief  run sps30_uart_checksum once
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_sps30_api_bench_uart_checksum(void)
+{
+    gs_sink += sps30_uart_checksum(&gs_frame[1], 44);
+    
+    return 0;
+}
+
+/**
+ * @brief  run sps30_uart_stuff once
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_sps30_api_bench_uart_stuff(void)
+{
+    return sps30_uart_stuff(gs_frame, 47, gs_stuffed, 256, &gs_stuffed_len);
+}
+
+/**
+ * @brief  run sps30_uart_unstuff once
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_sps30_api_bench_uart_unstuff(void)
+{
+    uint8_t frame[47];
+    uint16_t len;
+    
+    return sps30_uart_unstuff(gs_stuffed, gs_stuffed_len, frame, 47, &len);
+}
+#endif
+
+#if (SPS30_ENABLE_FLOAT == 1)
+/**
+ * @brief  run sps30_decode_raw once
+ * @return status code
+ * @note   none
+ */
+static uint8_t a_sps30_api_bench_decode_raw(void)
+{
+    return sps30_decode_raw(&gs_raw, &gs_pm);
+}
+#endif
+
+/**
+ * @brief api bench case table
+ */
+static const sps30_api_bench_case_t gs_case[] =
+{
+#if (SPS30_ENABLE_IIC == 1)
+#if (SPS30_ENABLE_FLOAT == 1)
+    {"sps30_read", SPS30_INTERFACE_IIC, SPS30_FORMAT_IEEE754, 1, a_sps30_api_bench_read},
+    {"sps30_read", SPS30_INTERFACE_IIC, SPS30_FORMAT_UINT16, 1, a_sps30_api_bench_read},
+#endif
+    {"sps30_read_u16", SPS30_INTERFACE_IIC, SPS30_FORMAT_UINT16, 1, a_sps30_api_bench_read_u16},
+    {"sps30_read_raw", SPS30_INTERFACE_IIC, SPS30_FORMAT_IEEE754, 1, a_sps30_api_bench_read_raw},
+    {"sps30_read_data_flag", SPS30_INTERFACE_IIC, SPS30_FORMAT_IEEE754, 0, a_sps30_api_bench_read_data_flag},
+    {"sps30_get_device_status", SPS30_INTERFACE_IIC, SPS30_FORMAT_IEEE754, 0, a_sps30_api_bench_get_device_status},
+    {"sps30_get_product_type", SPS30_INTERFACE_IIC, SPS30_FORMAT_IEEE754, 0, a_sps30_api_bench_get_product_type},
+    {"sps30_get_serial_number", SPS30_INTERFACE_IIC, SPS30_FORMAT_IEEE754, 0, a_sps30_api_bench_get_serial_number},
+    {"sps30_get_version", SPS30_INTERFACE_IIC, SPS30_FORMAT_IEEE754, 0, a_sps30_api_bench_get_version},
+    {"sps30_get_auto_cleaning_interval", SPS30_INTERFACE_IIC, SPS30_FORMAT_IEEE754, 0, a_sps30_api_bench_get_auto_cleaning_interval},
+#endif
+#if (SPS30_ENABLE_UART == 1)
+#if (SPS30_ENABLE_FLOAT == 1)
+    {"sps30_read", SPS30_INTERFACE_UART, SPS30_FORMAT_IEEE754, 1, a_sps30_api_bench_read},
+    {"sps30_read", SPS30_INTERFACE_UART, SPS30_FORMAT_UINT16, 1, a_sps30_api_bench_read},
+#endif
+    {"sps30_read_u16", SPS30_INTERFACE_UART, SPS30_FORMAT_UINT16, 1, a_sps30_api_bench_read_u16},
+    {"sps30_read_raw", SPS30_INTERFACE_UART, SPS30_FORMAT_IEEE754, 1, a_sps30_api_bench_read_raw},
+    {"sps30_get_device_status", SPS30_INTERFACE_UART, SPS30_FORMAT_IEEE754, 0, a_sps30_api_bench_get_device_status},
+    {"sps30_get_product_type", SPS30_INTERFACE_UART, SPS30_FORMAT_IEEE754, 0, a_sps30_api_bench_get_product_type},
+    {"sps30_get_serial_number", SPS30_INTERFACE_UART, SPS30_FORMAT_IEEE754, 0, a_sps30_api_bench_get_serial_number},
+    {"sps30_get_version", SPS30_INTERFACE_UART, SPS30_FORMAT_IEEE754, 0, a_sps30_api_bench_get_version},
+    {"sps30_get_auto_cleaning_interval", SPS30_INTERFACE_UART, SPS30_FORMAT_IEEE754, 0, a_sps30_api_bench_get_auto_cleaning_interval},
+#endif
+#if (SPS30_ENABLE_IIC == 1)
+    {"sps30_iic_crc", SPS30_API_BENCH_NONE, SPS30_API_BENCH_NONE, 0, a_sps30_api_bench_iic_crc},
+#endif
+#if (SPS30_ENABLE_UART == 1)
+    {"sps30_uart_checksum", SPS30_API_BENCH_NONE, SPS30_API_BENCH_NONE, 0, a_sps30_api_bench_uart_checksum},
+    {"sps30_uart_stuff", SPS30_API_BENCH_NONE, SPS30_API_BENCH_NONE, 0, a_sps30_api_bench_uart_stuff},
+    {"sps30_uart_unstuff", SPS30_API_BENCH_NONE, SPS30_API_BENCH_NONE, 0, a_sps30_api_bench_uart_unstuff},
+#endif
+#if (SPS30_ENABLE_FLOAT == 1)
+    {"sps30_decode_raw", SPS30_API_BENCH_NONE, SPS30_API_BENCH_NONE, 0, a_sps30_api_bench_decode_raw},
+#endif
+};
+
+/**
+ * @brief     read a clock
+ * @param[in] id clock id
+ * @return    time in ns
+ * @note      none
+ */
+static uint64_t a_sps30_api_bench_ns(clockid_t id)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(id, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief  open the instructions counter
+ * @note   the counter stays closed when the kernel doesn't allow it,
+ *         then the instructions are reported as null
+ */
+static void a_sps30_api_bench_perf_open(void)
+{
+#if defined(__linux__)
+    struct perf_event_attr attr;
+    
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    gs_perf_fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+}
+
+/**
+ * @brief  close the instructions counter
+ * @note   none
+ */
+static void a_sps30_api_bench_perf_close(void)
+{
+#if defined(__linux__)
+    if (gs_perf_fd >= 0)
+    {
+        (void)close(gs_perf_fd);
+    }
+#endif
+    gs_perf_fd = -1;
+}
+
+/**
+ * @brief  start the instructions counter
+ * @note   none
+ */
+static void a_sps30_api_bench_perf_start(void)
+{
+#if defined(__linux__)
+    if (gs_perf_fd >= 0)
+    {
+        (void)ioctl(gs_perf_fd, PERF_EVENT_IOC_RESET, 0);
+        (void)ioctl(gs_perf_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+/**
+ * @brief      stop the instructions counter
+ * @param[out] *count pointer to an instructions buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no counter
+ * @note       none
+ */
+static uint8_t a_sps30_api_bench_perf_stop(uint64_t *count)
+{
+#if defined(__linux__)
+    if (gs_perf_fd >= 0)
+    {
+        (void)ioctl(gs_perf_fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(gs_perf_fd, count, sizeof(uint64_t)) == (ssize_t)sizeof(uint64_t))
+        {
+            return 0;
+        }
+    }
+#endif
+    
+    return 1;
+}
+
+/**
+ * @brief     compare two latencies
+ * @param[in] *a pointer to a latency
+ * @param[in] *b pointer to a latency
+ * @return    compare result
+ * @note      none
+ */
+static int a_sps30_api_bench_compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief     set the chip up for one case
+ * @param[in] *c pointer to a case
+ * @return    status code
+ *            - 0 success
+ *            - 1 setup failed
+ * @note      none
+ */
+static uint8_t a_sps30_api_bench_setup(const sps30_api_bench_case_t *c)
+{
+    if (c->interface == SPS30_API_BENCH_NONE)
+    {
+        return 0;
+    }
+    
+    /* link the simulator with the counting bus */
+    (void)sps30_sim_init(&gs_sim);
+    DRIVER_SPS30_LINK_INIT(&gs_handle, sps30_handle_t);
+    if (sps30_sim_link(&gs_handle, &gs_sim) != 0)
+    {
+        sps30_interface_debug_print("sps30: sim link failed.\n");
+        
+        return 1;
+    }
+    DRIVER_SPS30_LINK_IIC_WRITE_COMMAND_CTX(&gs_handle, a_sps30_api_bench_iic_write_cmd);
+    DRIVER_SPS30_LINK_IIC_READ_COMMAND_CTX(&gs_handle, a_sps30_api_bench_iic_read_cmd);
+    DRIVER_SPS30_LINK_UART_READ_CTX(&gs_handle, a_sps30_api_bench_uart_read);
+    DRIVER_SPS30_LINK_UART_WRITE_CTX(&gs_handle, a_sps30_api_bench_uart_write);
+    DRIVER_SPS30_LINK_DEBUG_PRINT(&gs_handle, sps30_interface_debug_print);
+    if ((sps30_set_interface(&gs_handle, (sps30_interface_t)c->interface) != 0) ||
+        (sps30_init(&gs_handle) != 0))
+    {
+        sps30_interface_debug_print("sps30: init failed.\n");
+        
+        return 1;
+    }
+    if (sps30_start_measurement(&gs_handle, (sps30_format_t)c->format) != 0)
+    {
+        sps30_interface_debug_print("sps30: start measurement failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run one case
+ * @param[in] *c pointer to a case
+ * @param[in] n calls
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the first pass times every call with the monotonic clock and counts the bus bytes,
+ *            the second pass runs the calls back to back for the cpu time and the instructions,
+ *            the bus bytes are kept before the second pass so only one pass is counted
+ */
+static uint8_t a_sps30_api_bench_case(const sps30_api_bench_case_t *c, uint32_t n)
+{
+    uint8_t (*volatile run)(void) = c->run;
+    uint32_t i;
+    uint64_t t;
+    uint64_t cpu;
+    uint64_t instructions;
+    uint64_t tx;
+    uint64_t rx;
+    uint8_t res;
+    char str[24];
+    
+    if (a_sps30_api_bench_setup(c) != 0)
+    {
+        return 1;
+    }
+    
+    /* latency and bus bytes */
+    gs_tx_bytes = 0;
+    gs_rx_bytes = 0;
+    res = 0;
+    for (i = 0; i < n; i++)
+    {
+        if (c->sample != 0)
+        {
+            sps30_sim_advance(&gs_sim, 1000);
+        }
+        t = a_sps30_api_bench_ns(CLOCK_MONOTONIC);
+        res |= run();
+        gs_latency[i] = (uint32_t)(a_sps30_api_bench_ns(CLOCK_MONOTONIC) - t);
+    }
+    tx = gs_tx_bytes;
+    rx = gs_rx_bytes;
+    
+    /* cpu time and instructions */
+    a_sps30_api_bench_perf_start();
+    cpu = a_sps30_api_bench_ns(CLOCK_PROCESS_CPUTIME_ID);
+    for (i = 0; i < n; i++)
+    {
+        if (c->sample != 0)
+        {
+            sps30_sim_advance(&gs_sim, 1000);
+        }
+        res |= run();
+    }
+    cpu = a_sps30_api_bench_ns(CLOCK_PROCESS_CPUTIME_ID) - cpu;
+    if (a_sps30_api_bench_perf_stop(&instructions) == 0)
+    {
+        (void)snprintf(str, sizeof(str), "%.1f", (double)instructions / (double)n);
+    }
+    else
+    {
+        (void)strcpy(str, "null");
+    }
+    if (c->interface != SPS30_API_BENCH_NONE)
+    {
+        (void)sps30_stop_measurement(&gs_handle);
+        (void)sps30_deinit(&gs_handle);
+    }
+    if (res != 0)
+    {
+        sps30_interface_debug_print("sps30: %s failed.\n", c->name);
+        
+        return 1;
+    }
+    
+    /* the data ready flag is one command word and one crc word */
+    if ((c->run == a_sps30_api_bench_read_data_flag) && (c->interface == SPS30_INTERFACE_IIC) &&
+        ((tx != (uint64_t)n * SPS30_API_BENCH_FLAG_TX) || (rx != (uint64_t)n * SPS30_API_BENCH_FLAG_RX)))
+    {
+        sps30_interface_debug_print("sps30: %s bus bytes check failed.\n", c->name);
+        
+        return 1;
+    }
+    
+    /* one json line */
+    qsort(gs_latency, n, sizeof(uint32_t), a_sps30_api_bench_compare);
+    sps30_interface_debug_print("{\"api\":\"%s\",\"interface\":\"%s\",\"format\":\"%s\",\"calls\":%u,"
+                                "\"p50_ns\":%u,\"p99_ns\":%u,\"cpu_ns\":%.1f,\"tx_bytes\":%.1f,\"rx_bytes\":%.1f,"
+                                "\"instructions\":%s}\n",
+                                c->name,
+                                (c->interface == SPS30_INTERFACE_IIC) ? "iic" : ((c->interface == SPS30_INTERFACE_UART) ? "uart" : "none"),
+                                (c->format == SPS30_FORMAT_IEEE754) ? "ieee754" : ((c->format == SPS30_FORMAT_UINT16) ? "uint16" : "none"),
+                                (unsigned int)n, (unsigned int)gs_latency[n / 2], (unsigned int)gs_latency[(uint64_t)n * 99 / 100],
+                                (double)cpu / (double)n, (double)tx / (double)n, (double)rx / (double)n, str);
+    
+    return 0;
+}
+
+/**
+ * @brief     api bench test
+ * @param[in] times calls of each api
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      runs on the host against the software model and prints one json
+ *            line per api with the p50 and p99 latency, the bus bytes, the cpu
+ *            ns and the instructions of one call
+ */
+uint8_t sps30_api_bench_test(uint32_t times)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t seed;
+    
+    if ((times == 0) || (times > SPS30_API_BENCH_MAX_CALLS))
+    {
+        sps30_interface_debug_print("sps30: times is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* build a measured values frame with the bytes to stuff and its raw sample */
+    seed = 0x12345678;
+    gs_frame[0] = 0x7E;
+    gs_frame[1] = 0x00;
+    gs_frame[2] = 0x03;
+    gs_frame[3] = 0x00;
+    gs_frame[4] = 40;
+    for (i = 0; i < 40; i++)
+    {
+        seed = seed * 1103515245U + 12345U;
+        gs_frame[5 + i] = ((i % 8) == 0) ? 0x7E : (uint8_t)(seed >> 16);
+    }
+    gs_frame[46] = 0x7E;
+    gs_raw.format = SPS30_FORMAT_IEEE754;
+    gs_raw.len = 40;
+    memcpy(gs_raw.payload, &gs_frame[5], 40);
+#if (SPS30_ENABLE_UART == 1)
+    gs_frame[45] = sps30_uart_checksum(&gs_frame[1], 44);
+    (void)sps30_uart_stuff(gs_frame, 47, gs_stuffed, 256, &gs_stuffed_len);
+#endif
+    
+    /* run every case */
+    a_sps30_api_bench_perf_open();
+    res = 0;
+    for (i = 0; i < sizeof(gs_case) / sizeof(gs_case[0]); i++)
+    {
+        if (a_sps30_api_bench_case(&gs_case[i], times) != 0)
+        {
+            res = 1;
+            
+            break;
+        }
+    }
+    a_sps30_api_bench_perf_close();
+    
+    return res;
+}
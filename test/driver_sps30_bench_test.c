@@ -0,0 +1,747 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_sps30_bench_test.c
+ * @brief     driver sps30 bench test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_sps30_bench_test.h"
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief bench test definition
+ */
+#define SPS30_BENCH_BUFFER_SIZE        4096           /**< bench buffer size */
+#define SPS30_BENCH_ROUNDS             256            /**< rounds of one bench times */
+
+#define SPS30_BENCH_FRAME_SIZE         47             /**< measured values frame size */
+#define SPS30_BENCH_FRAMES             64             /**< frames of one bench round */
+#define SPS30_BENCH_BATCH              256            /**< iic frames of one batch */
+
+static uint8_t gs_buffer[SPS30_BENCH_BUFFER_SIZE];    /**< bench buffer */
+#if (SPS30_ENABLE_UART == 1)
+static uint8_t gs_frame[SPS30_BENCH_FRAMES][SPS30_BENCH_FRAME_SIZE];        /**< bench frames */
+static uint8_t gs_stuffed[SPS30_BENCH_FRAMES][256];                         /**< bench stuffed frames */
+static uint16_t gs_stuffed_len[SPS30_BENCH_FRAMES];                         /**< bench stuffed frames length */
+#endif
+#if (SPS30_ENABLE_FLOAT == 1) && (SPS30_ENABLE_IIC == 1)
+static uint8_t gs_raw[SPS30_BENCH_BATCH * 60];                              /**< bench iic frames */
+static float gs_column[2][10][SPS30_BENCH_BATCH];                           /**< bench decoded columns */
+static uint8_t gs_valid[SPS30_BENCH_BATCH];                                 /**< bench valid flags */
+#endif
+static volatile uint8_t gs_sink;                      /**< keep the results alive */
+
+/**
+ * @brief     reference crc with the old bit by bit path
+ * @param[in] iic_uart chip interface
+ * @param[in] *data pointer to a data buffer
+ * @param[in] count data length
+ * @return    crc
+ * @note      the interface branch is kept to match the old per call cost
+ */
+static uint8_t a_sps30_bench_crc_reference(uint8_t iic_uart, uint8_t *data, uint16_t count)
+{
+    if (iic_uart == SPS30_INTERFACE_IIC)
+    {
+        uint16_t current_byte;
+        uint8_t crc = 0xFF;
+        uint8_t crc_bit;
+        
+        for (current_byte = 0; current_byte < count; ++current_byte)        /* calculate crc */
+        {
+            crc ^= (data[current_byte]);                                    /* xor data */
+            for (crc_bit = 8; crc_bit > 0; --crc_bit)                       /* 8 bit */
+            {
+                if ((crc & 0x80) != 0)                                      /* if 7th bit is 1 */
+                {
+                    crc = (crc << 1) ^ 0x31;                                /* xor */
+                }
+                else
+                {
+                    crc = crc << 1;                                         /* left shift 1 */
+                }
+            }
+        }
+        
+        return crc;                                                         /* return crc */
+    }
+    else
+    {
+        uint16_t i;
+        uint32_t crc = 0x00;
+        
+        for (i = 0; i < count; i++)                                         /* sum */
+        {
+            crc += data[i];                                                 /* sum */
+        }
+        
+        return (uint8_t)(~(crc & 0xFF));                                    /* invert the least significant byte */
+    }
+}
+
+#if (SPS30_ENABLE_IIC == 1)
+/**
+ * @brief     reference iic crc with the old path
+ * @param[in] *data pointer to a data buffer
+ * @param[in] count data length
+ * @return    crc
+ * @note      none
+ */
+static uint8_t a_sps30_bench_iic_crc_reference(uint8_t *data, uint16_t count)
+{
+    return a_sps30_bench_crc_reference(SPS30_INTERFACE_IIC, data, count);
+}
+#endif
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief     reference uart checksum with the old path
+ * @param[in] *data pointer to a data buffer
+ * @param[in] count data length
+ * @return    checksum
+ * @note      none
+ */
+static uint8_t a_sps30_bench_uart_checksum_reference(uint8_t *data, uint16_t count)
+{
+    return a_sps30_bench_crc_reference(SPS30_INTERFACE_UART, data, count);
+}
+#endif
+
+/**
+ * @brief     run one crc kernel over the bench buffer
+ * @param[in] *crc_kernel pointer to a crc kernel
+ * @param[in] step bytes of one kernel call
+ * @param[in] rounds bench rounds
+ * @return    ns per byte
+ * @note      the kernel is called through a volatile pointer so that
+ *            the compiler can't hoist the loop invariant calls
+ */
+static double a_sps30_bench_run(uint8_t (*crc_kernel)(uint8_t *data, uint16_t count), uint16_t step, uint32_t rounds)
+{
+    uint8_t (*volatile kernel)(uint8_t *data, uint16_t count) = crc_kernel;
+    uint32_t i;
+    uint32_t j;
+    uint8_t crc;
+    double s;
+    clock_t start;
+    
+    crc = 0;
+    start = clock();
+    for (j = 0; j < rounds; j++)
+    {
+        for (i = 0; i < SPS30_BENCH_BUFFER_SIZE; i += step)
+        {
+            crc ^= kernel(&gs_buffer[i], step);
+        }
+    }
+    s = (double)(clock() - start) / (double)CLOCKS_PER_SEC;
+    gs_sink = crc;
+    
+    return s * 1000000000.0 / ((double)rounds * (double)SPS30_BENCH_BUFFER_SIZE);
+}
+
+/**
+ * @brief     crc bench
+ * @param[in] times test times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+static uint8_t a_sps30_bench_crc(uint32_t times)
+{
+    uint32_t i;
+    uint32_t rounds;
+    
+    /* check the new path with the reference */
+#if (SPS30_ENABLE_IIC == 1)
+    for (i = 0; i + 1 < SPS30_BENCH_BUFFER_SIZE; i += 2)
+    {
+        if (sps30_iic_crc(&gs_buffer[i], 2) != a_sps30_bench_iic_crc_reference(&gs_buffer[i], 2))
+        {
+            sps30_interface_debug_print("sps30: iic crc check failed.\n");
+            
+            return 1;
+        }
+    }
+#endif
+#if (SPS30_ENABLE_UART == 1)
+    for (i = 1; i < 64; i++)
+    {
+        if (sps30_uart_checksum(gs_buffer, (uint16_t)i) != a_sps30_bench_uart_checksum_reference(gs_buffer, (uint16_t)i))
+        {
+            sps30_interface_debug_print("sps30: uart checksum check failed.\n");
+            
+            return 1;
+        }
+    }
+#endif
+    rounds = times * SPS30_BENCH_ROUNDS;
+    
+#if (SPS30_ENABLE_IIC == 1)
+    /* iic words, one call per 2 bytes like the driver */
+    sps30_interface_debug_print("sps30: iic crc words bitwise %0.3f ns/byte, table %0.3f ns/byte.\n",
+                                a_sps30_bench_run(a_sps30_bench_iic_crc_reference, 2, rounds),
+                                a_sps30_bench_run(sps30_iic_crc, 2, rounds));
+    
+    /* iic crc over the whole buffer */
+    sps30_interface_debug_print("sps30: iic crc bulk bitwise %0.3f ns/byte, table %0.3f ns/byte.\n",
+                                a_sps30_bench_run(a_sps30_bench_iic_crc_reference, SPS30_BENCH_BUFFER_SIZE, rounds),
+                                a_sps30_bench_run(sps30_iic_crc, SPS30_BENCH_BUFFER_SIZE, rounds));
+#endif
+    
+#if (SPS30_ENABLE_UART == 1)
+    /* uart checksum over the whole buffer */
+    sps30_interface_debug_print("sps30: uart checksum old %0.3f ns/byte, new %0.3f ns/byte.\n",
+                                a_sps30_bench_run(a_sps30_bench_uart_checksum_reference, SPS30_BENCH_BUFFER_SIZE, rounds),
+                                a_sps30_bench_run(sps30_uart_checksum, SPS30_BENCH_BUFFER_SIZE, rounds));
+#endif
+    
+    return 0;
+}
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief      reference stuffing with the old path
+ * @param[in]  *input pointer to an input buffer
+ * @param[in]  in_len input length
+ * @param[out] *output pointer to a 256 bytes output buffer
+ * @param[out] *out_len pointer to an output length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 stuff failed
+ * @note       none
+ */
+static uint8_t a_sps30_bench_stuff_reference(uint8_t *input, uint16_t in_len, uint8_t *output, uint16_t *out_len)
+{
+    uint16_t i;
+    
+    memset(output, 0, sizeof(uint8_t) * 256);
+    output[0] = input[0];
+    *out_len = 1;
+    for (i = 1; i < (in_len - 1); i++)
+    {
+        if ((*out_len) >= 255)
+        {
+            return 1;
+        }
+        switch (input[i])
+        {
+            case 0x7E :
+            {
+                output[(*out_len)++] = 0x7D;
+                output[(*out_len)++] = 0x5E;
+                
+                break;
+            }
+            case 0x7D :
+            {
+                output[(*out_len)++] = 0x7D;
+                output[(*out_len)++] = 0x5D;
+                
+                break;
+            }
+            case 0x11 :
+            {
+                output[(*out_len)++] = 0x7D;
+                output[(*out_len)++] = 0x31;
+                
+                break;
+            }
+            case 0x13 :
+            {
+                output[(*out_len)++] = 0x7D;
+                output[(*out_len)++] = 0x33;
+                
+                break;
+            }
+            default :
+            {
+                output[(*out_len)++] = input[i];
+                
+                break;
+            }
+        }
+    }
+    output[(*out_len)++] = input[in_len - 1];
+    
+    return 0;
+}
+
+/**
+ * @brief      reference unstuffing with the old path
+ * @param[in]  *input pointer to a stuffed buffer
+ * @param[in]  len stuffed length
+ * @param[out] *output pointer to an output buffer
+ * @param[in]  out_len output length
+ * @return     status code
+ *             - 0 success
+ *             - 1 unstuff failed
+ * @note       none
+ */
+static uint8_t a_sps30_bench_unstuff_reference(uint8_t *input, uint16_t len, uint8_t *output, uint16_t out_len)
+{
+    uint16_t i, point;
+    
+    memset(output, 0, sizeof(uint8_t) * out_len);
+    output[0] = input[0];
+    point = 1;
+    for (i = 1; i < (len - 1); i++)
+    {
+        if (point >= (out_len - 1))
+        {
+            return 1;
+        }
+        if ((input[i] == 0x7D) && ((input[i + 1] == 0x5E) || (input[i + 1] == 0x5D) ||
+                                   (input[i + 1] == 0x31) || (input[i + 1] == 0x33)))
+        {
+            switch (input[i + 1])
+            {
+                case 0x5E :
+                {
+                    output[point++] = 0x7E;
+                    
+                    break;
+                }
+                case 0x5D :
+                {
+                    output[point++] = 0x7D;
+                    
+                    break;
+                }
+                case 0x31 :
+                {
+                    output[point++] = 0x11;
+                    
+                    break;
+                }
+                default :
+                {
+                    output[point++] = 0x13;
+                    
+                    break;
+                }
+            }
+            i++;
+        }
+        else
+        {
+            output[point++] = input[i];
+        }
+    }
+    output[point++] = input[len - 1];
+    
+    return (point != out_len) ? 1 : 0;
+}
+#endif
+
+#if (SPS30_ENABLE_UART == 1) || ((SPS30_ENABLE_FLOAT == 1) && (SPS30_ENABLE_IIC == 1))
+/**
+ * @brief     get the throughput
+ * @param[in] start start clock
+ * @param[in] bytes processed bytes or frames
+ * @return    millions per second
+ * @note      none
+ */
+static double a_sps30_bench_mbps(clock_t start, double bytes)
+{
+    double s;
+    
+    s = (double)(clock() - start) / (double)CLOCKS_PER_SEC;
+    if (s <= 0.0)
+    {
+        s = 1.0 / (double)CLOCKS_PER_SEC;
+    }
+    
+    return bytes / s / 1000000.0;
+}
+#endif
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief     framing bench
+ * @param[in] times test times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+static uint8_t a_sps30_bench_framing(uint32_t times)
+{
+    uint8_t (*volatile stuff)(uint8_t *input, uint16_t in_len, uint8_t *output, uint16_t out_size, uint16_t *out_len) = sps30_uart_stuff;
+    uint8_t (*volatile unstuff)(uint8_t *input, uint16_t in_len, uint8_t *output, uint16_t out_size, uint16_t *out_len) = sps30_uart_unstuff;
+    uint8_t (*volatile stuff_reference)(uint8_t *input, uint16_t in_len, uint8_t *output, uint16_t *out_len) = a_sps30_bench_stuff_reference;
+    uint8_t (*volatile unstuff_reference)(uint8_t *input, uint16_t len, uint8_t *output, uint16_t out_len) = a_sps30_bench_unstuff_reference;
+    uint8_t tx[256];
+    uint8_t rx[SPS30_BENCH_FRAME_SIZE];
+    uint16_t len;
+    uint16_t len_check;
+    uint32_t i;
+    uint32_t j;
+    uint32_t rounds;
+    double bytes;
+    double old_mbps;
+    double new_mbps;
+    clock_t start;
+    
+    /* build the measured values frames, the last one is all reserved bytes */
+    for (i = 0; i < SPS30_BENCH_FRAMES; i++)
+    {
+        gs_frame[i][0] = 0x7E;
+        gs_frame[i][1] = 0x00;
+        gs_frame[i][2] = 0x03;
+        gs_frame[i][3] = 0x00;
+        gs_frame[i][4] = 40;
+        for (j = 0; j < 40; j++)
+        {
+            if (i == (SPS30_BENCH_FRAMES - 1))
+            {
+                gs_frame[i][5 + j] = (j % 2) ? 0x7E : 0x11;
+            }
+            else
+            {
+                gs_frame[i][5 + j] = gs_buffer[(i * 40 + j) % SPS30_BENCH_BUFFER_SIZE];
+            }
+        }
+        gs_frame[i][45] = sps30_uart_checksum(&gs_frame[i][1], 44);
+        gs_frame[i][46] = 0x7E;
+    }
+    
+    /* check the new path with the reference */
+    for (i = 0; i < SPS30_BENCH_FRAMES; i++)
+    {
+        if (sps30_uart_stuff(gs_frame[i], SPS30_BENCH_FRAME_SIZE, gs_stuffed[i], 256, &gs_stuffed_len[i]) != 0)
+        {
+            sps30_interface_debug_print("sps30: stuff failed.\n");
+            
+            return 1;
+        }
+        if ((a_sps30_bench_stuff_reference(gs_frame[i], SPS30_BENCH_FRAME_SIZE, tx, &len_check) != 0) ||
+            (len_check != gs_stuffed_len[i]) || (memcmp(tx, gs_stuffed[i], len_check) != 0))
+        {
+            sps30_interface_debug_print("sps30: stuff check failed.\n");
+            
+            return 1;
+        }
+        if ((sps30_uart_unstuff(gs_stuffed[i], gs_stuffed_len[i], rx, SPS30_BENCH_FRAME_SIZE, &len) != 0) ||
+            (len != SPS30_BENCH_FRAME_SIZE) || (memcmp(rx, gs_frame[i], SPS30_BENCH_FRAME_SIZE) != 0))
+        {
+            sps30_interface_debug_print("sps30: unstuff check failed.\n");
+            
+            return 1;
+        }
+    }
+    rounds = times * SPS30_BENCH_ROUNDS * 16;
+    bytes = (double)rounds * (double)SPS30_BENCH_FRAMES * (double)SPS30_BENCH_FRAME_SIZE;
+    
+    /* stuff */
+    start = clock();
+    for (j = 0; j < rounds; j++)
+    {
+        for (i = 0; i < SPS30_BENCH_FRAMES; i++)
+        {
+            (void)stuff_reference(gs_frame[i], SPS30_BENCH_FRAME_SIZE, tx, &len);
+        }
+    }
+    old_mbps = a_sps30_bench_mbps(start, bytes);
+    start = clock();
+    for (j = 0; j < rounds; j++)
+    {
+        for (i = 0; i < SPS30_BENCH_FRAMES; i++)
+        {
+            (void)stuff(gs_frame[i], SPS30_BENCH_FRAME_SIZE, tx, 256, &len);
+        }
+    }
+    new_mbps = a_sps30_bench_mbps(start, bytes);
+    gs_sink = tx[len - 2];
+    sps30_interface_debug_print("sps30: uart stuff old %0.1f MB/s, new %0.1f MB/s.\n", old_mbps, new_mbps);
+    
+    /* unstuff */
+    start = clock();
+    for (j = 0; j < rounds; j++)
+    {
+        for (i = 0; i < SPS30_BENCH_FRAMES; i++)
+        {
+            (void)unstuff_reference(gs_stuffed[i], gs_stuffed_len[i], rx, SPS30_BENCH_FRAME_SIZE);
+        }
+    }
+    old_mbps = a_sps30_bench_mbps(start, bytes);
+    start = clock();
+    for (j = 0; j < rounds; j++)
+    {
+        for (i = 0; i < SPS30_BENCH_FRAMES; i++)
+        {
+            (void)unstuff(gs_stuffed[i], gs_stuffed_len[i], rx, SPS30_BENCH_FRAME_SIZE, &len);
+        }
+    }
+    new_mbps = a_sps30_bench_mbps(start, bytes);
+    gs_sink = rx[SPS30_BENCH_FRAME_SIZE - 2];
+    sps30_interface_debug_print("sps30: uart unstuff old %0.1f MB/s, new %0.1f MB/s.\n", old_mbps, new_mbps);
+    
+    return 0;
+}
+#endif
+
+#if (SPS30_ENABLE_FLOAT == 1) && (SPS30_ENABLE_IIC == 1)
+/**
+ * @brief      reference decode with the old per frame path
+ * @param[in]  *raw pointer to a raw frame
+ * @param[in]  format data format
+ * @param[out] *pm pointer to an sps30 pm structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 crc error
+ * @note       none
+ */
+static uint8_t a_sps30_bench_decode_reference(uint8_t *raw, uint8_t format, sps30_pm_t *pm)
+{
+    union float_u
+    {
+        float f;
+        uint32_t i;
+    };
+    union float_u f;
+    uint8_t buf[60];
+    float v[10];
+    uint16_t i;
+    uint16_t words;
+    
+    words = (format == SPS30_FORMAT_IEEE754) ? 20 : 10;
+    memcpy(buf, raw, words * 3);
+    for (i = 0; i < words; i++)
+    {
+        if (buf[i * 3 + 2] != sps30_iic_crc(&buf[i * 3], 2))
+        {
+            return 1;
+        }
+        buf[i * 2 + 0] = buf[i * 3 + 0];
+        buf[i * 2 + 1] = buf[i * 3 + 1];
+    }
+    for (i = 0; i < 10; i++)
+    {
+        if (format == SPS30_FORMAT_IEEE754)
+        {
+            f.i = (uint32_t)(buf[i * 4 + 0]) << 24 | (uint32_t)(buf[i * 4 + 1]) << 16 |
+                  (uint32_t)(buf[i * 4 + 2]) << 8 | (uint32_t)(buf[i * 4 + 3]) << 0;
+            v[i] = f.f;
+        }
+        else
+        {
+            v[i] = (float)(((uint16_t)(buf[i * 2 + 0]) << 8) | ((uint16_t)(buf[i * 2 + 1]) << 0));
+        }
+    }
+    if (format == SPS30_FORMAT_UINT16)
+    {
+        v[9] /= 1000.0f;
+    }
+    pm->pm1p0_ug_m3 = v[0];
+    pm->pm2p5_ug_m3 = v[1];
+    pm->pm4p0_ug_m3 = v[2];
+    pm->pm10_ug_m3 = v[3];
+    pm->pm0p5_cm3 = v[4];
+    pm->pm1p0_cm3 = v[5];
+    pm->pm2p5_cm3 = v[6];
+    pm->pm4p0_cm3 = v[7];
+    pm->pm10_cm3 = v[8];
+    pm->typical_particle_um = v[9];
+    
+    return 0;
+}
+
+/**
+ * @brief     reference batch decode into columns
+ * @param[in] format data format
+ * @param[in] n number of frames
+ * @note      none
+ */
+static void a_sps30_bench_batch_reference(uint8_t format, uint16_t n)
+{
+    sps30_pm_t pm;
+    uint16_t k;
+    uint16_t size;
+    
+    size = (format == SPS30_FORMAT_IEEE754) ? 60 : 30;
+    for (k = 0; k < n; k++)
+    {
+        memset(&pm, 0, sizeof(sps30_pm_t));
+        (void)a_sps30_bench_decode_reference(&gs_raw[k * size], format, &pm);
+        gs_column[1][0][k] = pm.pm1p0_ug_m3;
+        gs_column[1][1][k] = pm.pm2p5_ug_m3;
+        gs_column[1][2][k] = pm.pm4p0_ug_m3;
+        gs_column[1][3][k] = pm.pm10_ug_m3;
+        gs_column[1][4][k] = pm.pm0p5_cm3;
+        gs_column[1][5][k] = pm.pm1p0_cm3;
+        gs_column[1][6][k] = pm.pm2p5_cm3;
+        gs_column[1][7][k] = pm.pm4p0_cm3;
+        gs_column[1][8][k] = pm.pm10_cm3;
+        gs_column[1][9][k] = pm.typical_particle_um;
+    }
+}
+
+/**
+ * @brief     batch decode bench
+ * @param[in] times test times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+static uint8_t a_sps30_bench_decode(uint32_t times)
+{
+    uint8_t (*volatile batch)(uint8_t *raw, uint16_t n, sps30_format_t format, sps30_pm_soa_t *soa) = sps30_decode_batch;
+    void (*volatile batch_reference)(uint8_t format, uint16_t n) = a_sps30_bench_batch_reference;
+    sps30_pm_soa_t soa;
+    uint8_t f;
+    uint8_t res;
+    uint16_t size;
+    uint32_t i;
+    uint32_t j;
+    uint32_t rounds;
+    double frames;
+    double old_fps;
+    double new_fps;
+    clock_t start;
+    sps30_format_t format[2] = {SPS30_FORMAT_IEEE754, SPS30_FORMAT_UINT16};
+    
+    soa.pm1p0_ug_m3 = gs_column[0][0];
+    soa.pm2p5_ug_m3 = gs_column[0][1];
+    soa.pm4p0_ug_m3 = gs_column[0][2];
+    soa.pm10_ug_m3 = gs_column[0][3];
+    soa.pm0p5_cm3 = gs_column[0][4];
+    soa.pm1p0_cm3 = gs_column[0][5];
+    soa.pm2p5_cm3 = gs_column[0][6];
+    soa.pm4p0_cm3 = gs_column[0][7];
+    soa.pm10_cm3 = gs_column[0][8];
+    soa.typical_particle_um = gs_column[0][9];
+    soa.valid = gs_valid;
+    for (f = 0; f < 2; f++)
+    {
+        /* build the frames with the crc bytes, the last one has a crc error */
+        size = (format[f] == SPS30_FORMAT_IEEE754) ? 60 : 30;
+        for (i = 0; i < SPS30_BENCH_BATCH * size; i += 3)
+        {
+            gs_raw[i + 0] = gs_buffer[(i + 0) % SPS30_BENCH_BUFFER_SIZE];
+            gs_raw[i + 1] = gs_buffer[(i + 1) % SPS30_BENCH_BUFFER_SIZE];
+            gs_raw[i + 2] = sps30_iic_crc(&gs_raw[i], 2);
+        }
+        gs_raw[SPS30_BENCH_BATCH * size - 1] ^= 0x01;
+        
+        /* check the batch path with the reference */
+        res = sps30_decode_batch(gs_raw, SPS30_BENCH_BATCH, format[f], &soa);
+        batch_reference(format[f], SPS30_BENCH_BATCH);
+        if ((res != 1) || (gs_valid[0] != 1) || (gs_valid[SPS30_BENCH_BATCH - 1] != 0) ||
+            (memcmp(gs_column[0], gs_column[1], sizeof(gs_column[0])) != 0))
+        {
+            sps30_interface_debug_print("sps30: decode batch check failed.\n");
+            
+            return 1;
+        }
+        
+        /* decode */
+        rounds = times * SPS30_BENCH_ROUNDS;
+        frames = (double)rounds * (double)SPS30_BENCH_BATCH;
+        start = clock();
+        for (j = 0; j < rounds; j++)
+        {
+            batch_reference(format[f], SPS30_BENCH_BATCH);
+        }
+        old_fps = a_sps30_bench_mbps(start, frames);
+        start = clock();
+        for (j = 0; j < rounds; j++)
+        {
+            (void)batch(gs_raw, SPS30_BENCH_BATCH, format[f], &soa);
+        }
+        new_fps = a_sps30_bench_mbps(start, frames);
+        gs_sink = gs_valid[0];
+        sps30_interface_debug_print("sps30: %s decode per frame %0.2f M frames/s, batch %0.2f M frames/s.\n",
+                                    (format[f] == SPS30_FORMAT_IEEE754) ? "ieee754" : "uint16", old_fps, new_fps);
+    }
+    
+    return 0;
+}
+#endif
+
+/**
+ * @brief     bench test
+ * @param[in] times test times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      runs on the host without the chip
+ */
+uint8_t sps30_bench_test(uint32_t times)
+{
+    uint32_t i;
+    uint32_t seed;
+    
+    /* start bench test */
+    sps30_interface_debug_print("sps30: start bench test.\n");
+    
+    /* fill the buffer with pseudo random data */
+    seed = 0x12345678;
+    for (i = 0; i < SPS30_BENCH_BUFFER_SIZE; i++)
+    {
+        seed = seed * 1103515245U + 12345U;
+        gs_buffer[i] = (uint8_t)(seed >> 16);
+    }
+    
+    /* crc bench */
+    sps30_interface_debug_print("sps30: crc bench.\n");
+    if (a_sps30_bench_crc(times) != 0)
+    {
+        return 1;
+    }
+    
+#if (SPS30_ENABLE_UART == 1)
+    /* framing bench */
+    sps30_interface_debug_print("sps30: framing bench.\n");
+    if (a_sps30_bench_framing(times) != 0)
+    {
+        return 1;
+    }
+#endif
+    
+#if (SPS30_ENABLE_FLOAT == 1) && (SPS30_ENABLE_IIC == 1)
+    /* decode bench */
+    sps30_interface_debug_print("sps30: decode bench.\n");
+    if (a_sps30_bench_decode(times) != 0)
+    {
+        return 1;
+    }
+#endif
+    
+    /* finish bench test */
+    sps30_interface_debug_print("sps30: finish bench test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,411 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_sps30_fault.c
+ * @brief     driver sps30 fault injection source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_sps30_fault.h"
+#include <string.h>
+
+/**
+ * @brief fault definition
+ */
+#define SPS30_FAULT_IIC_READ_DATA_READY_FLAG        0x0202U        /**< iic read data ready flag command */
+#define SPS30_FAULT_UART_READ_MEASURED_VALUES       0x03           /**< uart read measured values command */
+#define SPS30_FAULT_UART_EMPTY_FRAME                8              /**< max stuffed frame length without data */
+
+/**
+ * @brief     check if the next eligible transaction gets the fault
+ * @param[in] *fault pointer to a fault structure
+ * @return    1 to inject, else 0
+ * @note      none
+ */
+static uint8_t a_sps30_fault_hit(sps30_fault_t *fault)
+{
+    fault->eligible++;                                                         /* eligible++ */
+    if ((fault->period == 0) || ((fault->eligible % fault->period) != 0))      /* check the period */
+    {
+        return 0;                                                              /* no fault */
+    }
+    fault->injected++;                                                         /* injected++ */
+    
+    return 1;                                                                  /* inject */
+}
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief         edit a received uart frame
+ * @param[in]     *fault pointer to a fault structure
+ * @param[in,out] *buf pointer to a stuffed frame buffer
+ * @param[in]     n frame length
+ * @param[in]     size buffer size
+ * @return        new frame length
+ * @note          the frame is unstuffed, changed by the fault type and stuffed again,
+ *                the state fault keeps the data so the driver checks the state byte,
+ *                a frame that can't be changed is returned as it is
+ */
+static uint16_t a_sps30_fault_uart_edit(sps30_fault_t *fault, uint8_t *buf, uint16_t n, uint16_t size)
+{
+    uint8_t frame[256];
+    uint16_t l;
+    uint16_t out;
+    
+    if ((sps30_uart_unstuff(buf, n, frame, 256, &l) != 0) || (l < 7))          /* unstuff the frame */
+    {
+        return n;                                                              /* keep the frame */
+    }
+    if (fault->type == SPS30_FAULT_CRC)                                        /* flip the checksum */
+    {
+        frame[l - 2] ^= 0x01;                                                  /* flip */
+    }
+    else if (fault->type == SPS30_FAULT_STATE)                                 /* state error */
+    {
+        frame[3] = fault->state;                                               /* set the state */
+        frame[l - 2] = sps30_uart_checksum(&frame[1], l - 3);                  /* set the checksum */
+    }
+    else
+    {
+        frame[4] = 0;                                                          /* no data */
+        frame[5] = sps30_uart_checksum(&frame[1], 4);                          /* set the checksum */
+        frame[6] = 0x7E;                                                       /* set the stop */
+        l = 7;                                                                 /* set the length */
+    }
+    if (sps30_uart_stuff(frame, l, buf, size, &out) != 0)                      /* stuff the frame */
+    {
+        return n;                                                              /* keep the frame */
+    }
+    
+    return out;                                                                /* return the length */
+}
+#endif
+
+#if (SPS30_ENABLE_IIC == 1)
+/**
+ * @brief     fault iic init
+ * @param[in] *user pointer to a fault structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_sps30_fault_iic_init(void *user)
+{
+    return sps30_sim_iic_init(((sps30_fault_t *)user)->sim);
+}
+
+/**
+ * @brief     fault iic deinit
+ * @param[in] *user pointer to a fault structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_sps30_fault_iic_deinit(void *user)
+{
+    return sps30_sim_iic_deinit(((sps30_fault_t *)user)->sim);
+}
+
+/**
+ * @brief     fault iic write cmd
+ * @param[in] *user pointer to a fault structure
+ * @param[in] addr iic device address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_sps30_fault_iic_write_cmd(void *user, uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    sps30_fault_t *fault = (sps30_fault_t *)user;
+    
+    fault->transactions++;                                                     /* transactions++ */
+    if ((fault->type == SPS30_FAULT_IIC_NAK) && (a_sps30_fault_hit(fault) != 0))   /* nak */
+    {
+        return 1;                                                              /* return error */
+    }
+    fault->iic_command = (len >= 2) ? (uint16_t)((buf[0] << 8) | buf[1]) : 0;  /* keep the command */
+    
+    return sps30_sim_iic_write_cmd(fault->sim, addr, buf, len);
+}
+
+/**
+ * @brief      fault iic read cmd
+ * @param[in]  *user pointer to a fault structure
+ * @param[in]  addr iic device address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_sps30_fault_iic_read_cmd(void *user, uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    sps30_fault_t *fault = (sps30_fault_t *)user;
+    uint8_t res;
+    
+    fault->transactions++;                                                     /* transactions++ */
+    res = sps30_sim_iic_read_cmd(fault->sim, addr, buf, len);                  /* read */
+    if ((res != 0) || (len < 3))                                               /* check the data */
+    {
+        return res;                                                            /* return the result */
+    }
+    if ((fault->type == SPS30_FAULT_CRC) && (a_sps30_fault_hit(fault) != 0))   /* flip the last crc */
+    {
+        buf[len - 1] ^= 0x01;                                                  /* flip */
+    }
+    else if ((fault->type == SPS30_FAULT_DATA_NOT_READY) &&
+             (fault->iic_command == SPS30_FAULT_IIC_READ_DATA_READY_FLAG) &&
+             (a_sps30_fault_hit(fault) != 0))                                  /* stuck not ready */
+    {
+        buf[0] = 0x00;                                                         /* not ready */
+        buf[1] = 0x00;                                                         /* not ready */
+        buf[2] = sps30_iic_crc(buf, 2);                                        /* set the crc */
+    }
+    else
+    {
+        
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+#endif
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief     fault uart init
+ * @param[in] *user pointer to a fault structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_sps30_fault_uart_init(void *user)
+{
+    return sps30_sim_uart_init(((sps30_fault_t *)user)->sim);
+}
+
+/**
+ * @brief     fault uart deinit
+ * @param[in] *user pointer to a fault structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_sps30_fault_uart_deinit(void *user)
+{
+    return sps30_sim_uart_deinit(((sps30_fault_t *)user)->sim);
+}
+
+/**
+ * @brief      fault uart read
+ * @param[in]  *user pointer to a fault structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     length of the read data
+ * @note       none
+ */
+static uint16_t a_sps30_fault_uart_read(void *user, uint8_t *buf, uint16_t len)
+{
+    sps30_fault_t *fault = (sps30_fault_t *)user;
+    uint16_t n;
+    
+    n = sps30_sim_uart_read(fault->sim, buf, len);                             /* read */
+    if (n == 0)                                                                /* empty poll */
+    {
+        return 0;                                                              /* return empty */
+    }
+    fault->transactions++;                                                     /* transactions++ */
+    if (n <= SPS30_FAULT_UART_EMPTY_FRAME)                                     /* no data */
+    {
+        return n;                                                              /* only data frames are hit */
+    }
+    switch (fault->type)
+    {
+        case SPS30_FAULT_UART_TRUNCATE :
+        {
+            if (a_sps30_fault_hit(fault) != 0)                                 /* truncate */
+            {
+                n /= 2;                                                        /* drop the rest */
+            }
+            
+            break;
+        }
+        case SPS30_FAULT_CRC :
+        case SPS30_FAULT_STATE :
+        {
+            if (a_sps30_fault_hit(fault) != 0)                                 /* edit the frame */
+            {
+                n = a_sps30_fault_uart_edit(fault, buf, n, len);               /* edit */
+            }
+            
+            break;
+        }
+        case SPS30_FAULT_DATA_NOT_READY :
+        {
+            if ((fault->uart_command == SPS30_FAULT_UART_READ_MEASURED_VALUES) &&
+                (a_sps30_fault_hit(fault) != 0))                               /* empty measured values */
+            {
+                n = a_sps30_fault_uart_edit(fault, buf, n, len);               /* edit */
+            }
+            
+            break;
+        }
+        default :
+        {
+            break;
+        }
+    }
+    
+    return n;                                                                  /* return the length */
+}
+
+/**
+ * @brief     fault uart flush
+ * @param[in] *user pointer to a fault structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_sps30_fault_uart_flush(void *user)
+{
+    return sps30_sim_uart_flush(((sps30_fault_t *)user)->sim);
+}
+
+/**
+ * @brief     fault uart write
+ * @param[in] *user pointer to a fault structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_sps30_fault_uart_write(void *user, uint8_t *buf, uint16_t len)
+{
+    sps30_fault_t *fault = (sps30_fault_t *)user;
+    
+    fault->transactions++;                                                     /* transactions++ */
+    fault->uart_command = (len >= 3) ? buf[2] : 0;                             /* keep the command */
+    
+    return sps30_sim_uart_write(fault->sim, buf, len);
+}
+#endif
+
+/**
+ * @brief     fault delay ms
+ * @param[in] *user pointer to a fault structure
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_sps30_fault_delay_ms(void *user, uint32_t ms)
+{
+    sps30_fault_t *fault = (sps30_fault_t *)user;
+    
+    fault->time_us += (uint64_t)ms * 1000;                                     /* add the time */
+    sps30_sim_delay_ms(fault->sim, ms);                                        /* advance the simulator */
+}
+
+/**
+ * @brief     fault delay us
+ * @param[in] *user pointer to a fault structure
+ * @param[in] us time
+ * @note      none
+ */
+static void a_sps30_fault_delay_us(void *user, uint32_t us)
+{
+    sps30_fault_t *fault = (sps30_fault_t *)user;
+    
+    fault->time_us += us;                                                      /* add the time */
+    sps30_sim_delay_us(fault->sim, us);                                        /* advance the simulator */
+}
+
+#if (SPS30_ENABLE_TRACE == 1) || (SPS30_ENABLE_STATS == 1)
+/**
+ * @brief     fault now us
+ * @param[in] *user pointer to a fault structure
+ * @return    virtual time in us
+ * @note      none
+ */
+static uint32_t a_sps30_fault_now_us(void *user)
+{
+    return sps30_sim_now_us(((sps30_fault_t *)user)->sim);                     /* return the simulator time */
+}
+#endif
+
+uint8_t sps30_fault_link(sps30_handle_t *handle, sps30_fault_t *fault, sps30_sim_t *sim)
+{
+    if ((handle == NULL) || (fault == NULL) || (sim == NULL))                  /* check the params */
+    {
+        return 2;                                                              /* return error */
+    }
+    memset(fault, 0, sizeof(sps30_fault_t));                                   /* clear the fault */
+    fault->sim = sim;                                                          /* set the simulator */
+    fault->state = 0x43;                                                       /* command not allowed in current state */
+#if (SPS30_ENABLE_IIC == 1)
+    DRIVER_SPS30_LINK_IIC_INIT_CTX(handle, a_sps30_fault_iic_init);
+    DRIVER_SPS30_LINK_IIC_DEINIT_CTX(handle, a_sps30_fault_iic_deinit);
+    DRIVER_SPS30_LINK_IIC_WRITE_COMMAND_CTX(handle, a_sps30_fault_iic_write_cmd);
+    DRIVER_SPS30_LINK_IIC_READ_COMMAND_CTX(handle, a_sps30_fault_iic_read_cmd);
+#endif
+#if (SPS30_ENABLE_UART == 1)
+    DRIVER_SPS30_LINK_UART_INIT_CTX(handle, a_sps30_fault_uart_init);
+    DRIVER_SPS30_LINK_UART_DEINIT_CTX(handle, a_sps30_fault_uart_deinit);
+    DRIVER_SPS30_LINK_UART_READ_CTX(handle, a_sps30_fault_uart_read);
+    DRIVER_SPS30_LINK_UART_WRITE_CTX(handle, a_sps30_fault_uart_write);
+    DRIVER_SPS30_LINK_UART_FLUSH_CTX(handle, a_sps30_fault_uart_flush);
+#endif
+    DRIVER_SPS30_LINK_DELAY_MS_CTX(handle, a_sps30_fault_delay_ms);
+    DRIVER_SPS30_LINK_DELAY_US_CTX(handle, a_sps30_fault_delay_us);
+#if (SPS30_ENABLE_TRACE == 1) || (SPS30_ENABLE_STATS == 1)
+    DRIVER_SPS30_LINK_NOW_US_CTX(handle, a_sps30_fault_now_us);
+#endif
+    DRIVER_SPS30_LINK_USER_DATA(handle, fault);
+    
+#if (SPS30_STATIC_PORT == 1)
+    return 1;                                                                  /* the static port keeps its own functions */
+#else
+    return 0;                                                                  /* success return 0 */
+#endif
+}
+
+void sps30_fault_set(sps30_fault_t *fault, sps30_fault_type_t type, uint32_t period)
+{
+    fault->type = (uint8_t)type;                                               /* set the type */
+    fault->period = period;                                                    /* set the period */
+    fault->eligible = 0;                                                       /* init 0 */
+    fault->injected = 0;                                                       /* init 0 */
+    fault->transactions = 0;                                                   /* init 0 */
+    fault->time_us = 0;                                                        /* init 0 */
+}
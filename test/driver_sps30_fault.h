@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_sps30_fault.h
+ * @brief     driver sps30 fault injection header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_SPS30_FAULT_H
+#define DRIVER_SPS30_FAULT_H
+
+#include "driver_sps30_sim.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup sps30_fault_driver sps30 fault injection function
+ * @brief    sps30 fault injection transport on top of the simulator
+ * @ingroup  sps30_test_driver
+ * @{
+ */
+
+/**
+ * @brief sps30 fault type enumeration definition
+ */
+typedef enum
+{
+    SPS30_FAULT_NONE           = 0x00,        /**< no fault */
+    SPS30_FAULT_IIC_NAK        = 0x01,        /**< iic_write_cmd is not acknowledged */
+    SPS30_FAULT_UART_TRUNCATE  = 0x02,        /**< uart_read returns the first half of a frame and drops the rest */
+    SPS30_FAULT_CRC            = 0x03,        /**< the last crc or checksum byte of a read is flipped */
+    SPS30_FAULT_STATE          = 0x04,        /**< the shdlc response state is set to the state error code */
+    SPS30_FAULT_DATA_NOT_READY = 0x05,        /**< the data ready flag is stuck at not ready */
+} sps30_fault_type_t;
+
+/**
+ * @brief sps30 fault structure definition
+ */
+typedef struct sps30_fault_s
+{
+    sps30_sim_t *sim;                 /**< simulator behind the faults */
+    uint8_t type;                     /**< sps30_fault_type_t */
+    uint8_t state;                    /**< shdlc state code of SPS30_FAULT_STATE */
+    uint8_t uart_command;             /**< last uart command */
+    uint16_t iic_command;             /**< last iic command */
+    uint32_t period;                  /**< a fault every period eligible transactions, 0 for never */
+    uint32_t eligible;                /**< eligible transactions */
+    uint32_t injected;                /**< injected faults */
+    uint32_t transactions;            /**< bus transactions */
+    uint64_t time_us;                 /**< time spent in the delays in us */
+} sps30_fault_t;
+
+/**
+ * @brief     link a fault transport to a handle
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] *fault pointer to a fault structure
+ * @param[in] *sim pointer to an initialized simulator structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 static port is enabled
+ *            - 2 handle, fault or sim is NULL
+ * @note      links the ctx bus and delay functions and the user context like
+ *            sps30_sim_link, the faults are off until sps30_fault_set is called
+ */
+uint8_t sps30_fault_link(sps30_handle_t *handle, sps30_fault_t *fault, sps30_sim_t *sim);
+
+/**
+ * @brief     set the fault
+ * @param[in] *fault pointer to a fault structure
+ * @param[in] type sps30_fault_type_t
+ * @param[in] period a fault every period eligible transactions, 0 for never
+ * @note      the counters are cleared, the eligible transactions are the iic writes
+ *            for the nak, the reads with data for the crc, the uart reads with data
+ *            for the truncation and the state, the data ready flag reads and the uart
+ *            measured values reads for the stuck data ready
+ */
+void sps30_fault_set(sps30_fault_t *fault, sps30_fault_type_t type, uint32_t period);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
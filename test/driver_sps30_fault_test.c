@@ -0,0 +1,397 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_sps30_fault_test.c
+ * @brief     driver sps30 fault test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_sps30_fault_test.h"
+#include "driver_sps30_fault.h"
+#include <string.h>
+
+/**
+ * @brief fault test definition
+ */
+#define SPS30_FAULT_TEST_PERIOD        4          /**< a fault every 4 eligible transactions */
+#define SPS30_FAULT_TEST_RETRY         20         /**< max retries of one sample */
+#define SPS30_FAULT_TEST_BACKOFF_MS    100        /**< wait before a retry */
+#if (SPS30_ENABLE_FLOAT == 1)
+#define SPS30_FAULT_TEST_FORMAT        SPS30_FORMAT_IEEE754    /**< float samples */
+#else
+#define SPS30_FAULT_TEST_FORMAT        SPS30_FORMAT_UINT16     /**< integer samples without float */
+#endif
+
+/**
+ * @brief fault test result structure definition
+ */
+typedef struct sps30_fault_test_result_s
+{
+    uint32_t injected;              /**< injected faults */
+    uint32_t retries;               /**< retried reads */
+    uint32_t max_retries;           /**< most retries of one sample */
+    uint32_t failed;                /**< samples lost after all retries */
+    uint32_t corrupted;             /**< passed reads with wrong values */
+    uint32_t transactions;          /**< bus transactions */
+    uint64_t time_us;               /**< time in the driver delays */
+    uint64_t elapsed_us;            /**< virtual time with the retry waits */
+} sps30_fault_test_result_t;
+
+static sps30_handle_t gs_handle;        /**< sps30 handle */
+static sps30_sim_t gs_sim;              /**< sps30 simulator */
+static sps30_fault_t gs_fault;          /**< sps30 fault transport */
+
+/**
+ * @brief      read samples with one fault type
+ * @param[in]  times read times
+ * @param[out] *result pointer to a result structure
+ * @note       every read is retried after a wait until it passes, like an application would,
+ *             a passed read must carry the simulator values
+ */
+static void a_sps30_fault_test_sample(uint32_t times, sps30_fault_test_result_t *result)
+{
+    uint32_t i;
+    uint32_t j;
+    uint64_t start_us;
+#if (SPS30_ENABLE_FLOAT == 1)
+    sps30_pm_t pm;
+#else
+    sps30_pm_u16_t pm;
+#endif
+    
+    start_us = gs_sim.now_us;
+    for (i = 0; i < times; i++)
+    {
+        sps30_interface_delay_ms(1000);
+        gs_sim.value[0] = 1.0f + (float)(i % 100);
+        for (j = 0; j < SPS30_FAULT_TEST_RETRY; j++)
+        {
+#if (SPS30_ENABLE_FLOAT == 1)
+            if (sps30_read(&gs_handle, &pm) == 0)
+#else
+            if (sps30_read_u16(&gs_handle, &pm) == 0)
+#endif
+            {
+                break;
+            }
+            result->retries++;
+            sps30_interface_delay_ms(SPS30_FAULT_TEST_BACKOFF_MS);
+        }
+        if (j == SPS30_FAULT_TEST_RETRY)
+        {
+            result->failed++;
+        }
+#if (SPS30_ENABLE_FLOAT == 1)
+        else if ((pm.pm1p0_ug_m3 != gs_sim.value[0]) || (pm.typical_particle_um != gs_sim.value[9]))
+#else
+        else if ((pm.pm1p0_ug_m3 != (uint16_t)(gs_sim.value[0] + 0.5f)) ||
+                 (pm.typical_particle_nm != (uint16_t)(gs_sim.value[9] * 1000.0f + 0.5f)))
+#endif
+        {
+            result->corrupted++;
+        }
+        else
+        {
+            
+        }
+        if (j > result->max_retries)
+        {
+            result->max_retries = j;
+        }
+    }
+    result->injected = gs_fault.injected;
+    result->transactions = gs_fault.transactions;
+    result->time_us = gs_fault.time_us;
+    result->elapsed_us = gs_sim.now_us - start_us;
+}
+
+/**
+ * @brief      read the serial number with one fault type
+ * @param[in]  times read times
+ * @param[out] *result pointer to a result structure
+ * @note       every read is retried at once until it passes, the answer is always ready,
+ *             so the cost is the bus recovery without the wait for the next sample,
+ *             a passed read must carry the simulator serial number
+ */
+static void a_sps30_fault_test_command(uint32_t times, sps30_fault_test_result_t *result)
+{
+    uint32_t i;
+    uint32_t j;
+    uint64_t start_us;
+    char sn[17];
+    
+    start_us = gs_sim.now_us;
+    for (i = 0; i < times; i++)
+    {
+        for (j = 0; j < SPS30_FAULT_TEST_RETRY; j++)
+        {
+            memset(sn, 0, sizeof(sn));
+            if (sps30_get_serial_number(&gs_handle, sn) == 0)
+            {
+                break;
+            }
+            result->retries++;
+        }
+        if (j == SPS30_FAULT_TEST_RETRY)
+        {
+            result->failed++;
+        }
+        else if (strcmp(sn, gs_sim.serial_number) != 0)
+        {
+            result->corrupted++;
+        }
+        else
+        {
+            
+        }
+        if (j > result->max_retries)
+        {
+            result->max_retries = j;
+        }
+    }
+    result->injected = gs_fault.injected;
+    result->transactions = gs_fault.transactions;
+    result->time_us = gs_fault.time_us;
+    result->elapsed_us = gs_sim.now_us - start_us;
+}
+
+/**
+ * @brief      run one fault type
+ * @param[in]  interface chip interface
+ * @param[in]  type sps30_fault_type_t
+ * @param[in]  times read times
+ * @param[out] *sample pointer to the measured values result structure
+ * @param[out] *command pointer to the serial number result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       the uart reads until the frame end, so a truncated frame waits for the deadline
+ */
+static uint8_t a_sps30_fault_test_run(sps30_interface_t interface, sps30_fault_type_t type, uint32_t times,
+                                      sps30_fault_test_result_t *sample, sps30_fault_test_result_t *command)
+{
+    /* link the fault transport */
+    memset(sample, 0, sizeof(sps30_fault_test_result_t));
+    memset(command, 0, sizeof(sps30_fault_test_result_t));
+    (void)sps30_sim_init(&gs_sim);
+    DRIVER_SPS30_LINK_INIT(&gs_handle, sps30_handle_t);
+    if (sps30_fault_link(&gs_handle, &gs_fault, &gs_sim) != 0)
+    {
+        sps30_interface_debug_print("sps30: fault link failed.\n");
+        
+        return 1;
+    }
+    DRIVER_SPS30_LINK_DEBUG_PRINT(&gs_handle, sps30_sim_quiet_print);          /* the driver prints every injected fault */
+    if ((sps30_set_interface(&gs_handle, interface) != 0) || (sps30_init(&gs_handle) != 0) ||
+#if (SPS30_ENABLE_UART == 1)
+        ((interface == SPS30_INTERFACE_UART) &&
+         (sps30_set_uart_receive_mode(&gs_handle, SPS30_UART_RECEIVE_MODE_FRAME) != 0)) ||
+#endif
+        (sps30_start_measurement(&gs_handle, SPS30_FAULT_TEST_FORMAT) != 0))
+    {
+        sps30_interface_debug_print("sps30: start failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* read with the faults */
+    sps30_fault_set(&gs_fault, type, SPS30_FAULT_TEST_PERIOD);
+    a_sps30_fault_test_sample(times, sample);
+    sps30_fault_set(&gs_fault, type, SPS30_FAULT_TEST_PERIOD);
+    a_sps30_fault_test_command(times, command);
+    
+    /* stop without the faults */
+    sps30_fault_set(&gs_fault, SPS30_FAULT_NONE, 0);
+    if (sps30_stop_measurement(&gs_handle) != 0)
+    {
+        sps30_interface_debug_print("sps30: stop measurement failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    (void)sps30_deinit(&gs_handle);
+    
+    return 0;
+}
+
+/**
+ * @brief     check and print one result
+ * @param[in] *name fault name
+ * @param[in] *phase result name
+ * @param[in] *result pointer to a result structure
+ * @param[in] *base pointer to the baseline result structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the cost is the part above the baseline per injected fault
+ */
+static uint8_t a_sps30_fault_test_report(const char *name, const char *phase, sps30_fault_test_result_t *result,
+                                         sps30_fault_test_result_t *base)
+{
+    double n;
+    
+    if (result->corrupted != 0)
+    {
+        sps30_interface_debug_print("sps30: %s %s check failed, %d corrupted reads passed.\n",
+                                    name, phase, (int)result->corrupted);
+        
+        return 1;
+    }
+    if (result->injected == 0)
+    {
+        sps30_interface_debug_print("sps30: %s %s not injected.\n", name, phase);
+        
+        return 0;
+    }
+    n = (double)result->injected;
+    sps30_interface_debug_print("sps30: %s %s injected %d, retries %d, max retries %d, lost %d.\n", name, phase,
+                                (int)result->injected, (int)result->retries, (int)result->max_retries, (int)result->failed);
+    sps30_interface_debug_print("sps30: %s %s recovery %0.1f transactions, %0.3f ms driver time and %0.3f ms elapsed per fault.\n",
+                                name, phase, ((double)result->transactions - (double)base->transactions) / n,
+                                ((double)result->time_us - (double)base->time_us) / 1000.0 / n,
+                                ((double)result->elapsed_us - (double)base->elapsed_us) / 1000.0 / n);
+    
+    return 0;
+}
+
+/**
+ * @brief     run the fault test
+ * @param[in] interface chip interface
+ * @param[in] times read times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the sample recovery includes the wait for the next sample after a lost measured values
+ *            frame, the bus recovery on the serial number read is the cost of the fault alone,
+ *            a fault type is reported as not injected when times is too small for its period
+ */
+static uint8_t a_sps30_fault_test(sps30_interface_t interface, uint32_t times)
+{
+    const struct
+    {
+        sps30_fault_type_t type;
+        const char *name;
+        uint8_t iic;
+        uint8_t uart;
+    } fault[] =
+    {
+        {SPS30_FAULT_IIC_NAK, "iic nak", 1, 0},
+        {SPS30_FAULT_UART_TRUNCATE, "uart truncate", 0, 1},
+        {SPS30_FAULT_CRC, "crc", 1, 1},
+        {SPS30_FAULT_STATE, "shdlc state", 0, 1},
+        {SPS30_FAULT_DATA_NOT_READY, "data not ready", 1, 1},
+    };
+    sps30_fault_test_result_t base_sample;
+    sps30_fault_test_result_t base_command;
+    sps30_fault_test_result_t sample;
+    sps30_fault_test_result_t command;
+    uint32_t i;
+    
+    /* baseline without the faults */
+    if (a_sps30_fault_test_run(interface, SPS30_FAULT_NONE, times, &base_sample, &base_command) != 0)
+    {
+        return 1;
+    }
+    if ((base_sample.retries != 0) || (base_sample.failed != 0) || (base_sample.corrupted != 0) ||
+        (base_command.retries != 0) || (base_command.failed != 0) || (base_command.corrupted != 0))
+    {
+        sps30_interface_debug_print("sps30: baseline read failed.\n");
+        
+        return 1;
+    }
+    sps30_interface_debug_print("sps30: baseline %0.1f transactions and %0.3f ms driver time per sample.\n",
+                                (double)base_sample.transactions / (double)times,
+                                (double)base_sample.time_us / 1000.0 / (double)times);
+    sps30_interface_debug_print("sps30: baseline %0.1f transactions and %0.3f ms driver time per serial number.\n",
+                                (double)base_command.transactions / (double)times,
+                                (double)base_command.time_us / 1000.0 / (double)times);
+    
+    /* every fault of the interface */
+    for (i = 0; i < sizeof(fault) / sizeof(fault[0]); i++)
+    {
+        if (((interface == SPS30_INTERFACE_IIC) && (fault[i].iic == 0)) ||
+            ((interface == SPS30_INTERFACE_UART) && (fault[i].uart == 0)))
+        {
+            continue;
+        }
+        if (a_sps30_fault_test_run(interface, fault[i].type, times, &sample, &command) != 0)
+        {
+            return 1;
+        }
+        if (sample.injected == 0)
+        {
+            sps30_interface_debug_print("sps30: %s not injected, %d reads give fewer than %d eligible transactions.\n",
+                                        fault[i].name, (int)times, SPS30_FAULT_TEST_PERIOD);
+            
+            continue;
+        }
+        if ((a_sps30_fault_test_report(fault[i].name, "sample", &sample, &base_sample) != 0) ||
+            (a_sps30_fault_test_report(fault[i].name, "bus", &command, &base_command) != 0))
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     fault test
+ * @param[in] interface chip interface
+ * @param[in] times read times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      runs on the host against the software model with virtual time,
+ *            injects one fault type at a time and reports the recovery cost
+ */
+uint8_t sps30_fault_test(sps30_interface_t interface, uint32_t times)
+{
+    uint8_t res;
+    
+    /* start fault test */
+    sps30_interface_debug_print("sps30: start fault test.\n");
+    
+    (void)sps30_sim_init(&gs_sim);
+    sps30_interface_set_clock(&gs_sim.clock);
+    res = a_sps30_fault_test(interface, times);
+    sps30_interface_set_clock(NULL);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* finish fault test */
+    sps30_interface_debug_print("sps30: finish fault test.\n");
+    
+    return 0;
+}
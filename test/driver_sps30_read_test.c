@@ -52,7 +52,11 @@ uint8_t sps30_read_test(sps30_interface_t interface, uint32_t times)
     uint8_t res;
     uint32_t i;
     sps30_info_t info;
+#if (SPS30_ENABLE_FLOAT == 1)
     sps30_pm_t pm;
+#else
+    sps30_pm_u16_t pm;
+#endif
     
     /* link functions */
     DRIVER_SPS30_LINK_INIT(&gs_handle, sps30_handle_t);
@@ -66,6 +70,7 @@ uint8_t sps30_read_test(sps30_interface_t interface, uint32_t times)
     DRIVER_SPS30_LINK_IIC_WRITE_COMMAND(&gs_handle, sps30_interface_iic_write_cmd);
     DRIVER_SPS30_LINK_IIC_READ_COMMAND(&gs_handle, sps30_interface_iic_read_cmd);
     DRIVER_SPS30_LINK_DELAY_MS(&gs_handle, sps30_interface_delay_ms);
+    DRIVER_SPS30_LINK_DELAY_US(&gs_handle, sps30_interface_delay_us);
     DRIVER_SPS30_LINK_DEBUG_PRINT(&gs_handle, sps30_interface_debug_print);
     
     /* get information */
@@ -121,6 +126,7 @@ uint8_t sps30_read_test(sps30_interface_t interface, uint32_t times)
         return 1;
     }
     
+#if (SPS30_ENABLE_FLOAT == 1)
     /* IEEE754 read test */
     sps30_interface_debug_print("sps30: IEEE754 read test.\n");
     
@@ -175,6 +181,8 @@ uint8_t sps30_read_test(sps30_interface_t interface, uint32_t times)
     /* delay 2000 ms */
     sps30_interface_delay_ms(2000);
     
+#endif
+    
     /* UINT16 read test */
     sps30_interface_debug_print("sps30: UINT16 read test.\n");
     
@@ -193,6 +201,7 @@ uint8_t sps30_read_test(sps30_interface_t interface, uint32_t times)
     
     for (i = 0; i < times; i++)
     {
+#if (SPS30_ENABLE_FLOAT == 1)
         res = sps30_read(&gs_handle, &pm);
         if (res != 0)
         {
@@ -211,6 +220,26 @@ uint8_t sps30_read_test(sps30_interface_t interface, uint32_t times)
         sps30_interface_debug_print("sps30: pm4.0 is %0.2f cm3.\n", pm.pm4p0_cm3);
         sps30_interface_debug_print("sps30: pm10.0 is %0.2f cm3.\n", pm.pm10_cm3);
         sps30_interface_debug_print("sps30: typical is %0.2f um.\n", pm.typical_particle_um);
+#else
+        res = sps30_read_u16(&gs_handle, &pm);
+        if (res != 0)
+        {
+            sps30_interface_debug_print("sps30: read failed.\n");
+            (void)sps30_deinit(&gs_handle);
+            
+            return 1;
+        }
+        sps30_interface_debug_print("sps30: pm1.0 is %d ug/m3.\n", pm.pm1p0_ug_m3);
+        sps30_interface_debug_print("sps30: pm2.5 is %d ug/m3.\n", pm.pm2p5_ug_m3);
+        sps30_interface_debug_print("sps30: pm4.0 is %d ug/m3.\n", pm.pm4p0_ug_m3);
+        sps30_interface_debug_print("sps30: pm10.0 is %d ug/m3.\n", pm.pm10_ug_m3);
+        sps30_interface_debug_print("sps30: pm0.5 is %d cm3.\n", pm.pm0p5_cm3);
+        sps30_interface_debug_print("sps30: pm1.0 is %d cm3.\n", pm.pm1p0_cm3);
+        sps30_interface_debug_print("sps30: pm2.5 is %d cm3.\n", pm.pm2p5_cm3);
+        sps30_interface_debug_print("sps30: pm4.0 is %d cm3.\n", pm.pm4p0_cm3);
+        sps30_interface_debug_print("sps30: pm10.0 is %d cm3.\n", pm.pm10_cm3);
+        sps30_interface_debug_print("sps30: typical is %d nm.\n", pm.typical_particle_nm);
+#endif
 
         
         /* delay 2000 ms */
@@ -72,6 +72,7 @@ uint8_t sps30_register_test(sps30_interface_t interface)
     DRIVER_SPS30_LINK_IIC_WRITE_COMMAND(&gs_handle, sps30_interface_iic_write_cmd);
     DRIVER_SPS30_LINK_IIC_READ_COMMAND(&gs_handle, sps30_interface_iic_read_cmd);
     DRIVER_SPS30_LINK_DELAY_MS(&gs_handle, sps30_interface_delay_ms);
+    DRIVER_SPS30_LINK_DELAY_US(&gs_handle, sps30_interface_delay_us);
     DRIVER_SPS30_LINK_DEBUG_PRINT(&gs_handle, sps30_interface_debug_print);
     
     /* get information */
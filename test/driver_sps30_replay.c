@@ -0,0 +1,709 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_sps30_replay.c
+ * @brief     driver sps30 bus record and replay source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_sps30_replay.h"
+#include "driver_sps30_interface.h"
+#include <string.h>
+
+#if (SPS30_STATIC_PORT != 1)
+/**
+ * @brief     write one record
+ * @param[in] *record pointer to a recorder structure
+ * @param[in] type sps30_trace_t
+ * @param[in] res bus result
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @note      a failed write is kept in the error flag
+ */
+static void a_sps30_record_write(sps30_record_t *record, uint8_t type, uint8_t res, const uint8_t *buf, uint16_t len)
+{
+    uint8_t header[SPS30_REPLAY_RECORD_SIZE];
+    uint32_t time_ms;
+    
+    time_ms = sps30_interface_now_ms();                                        /* get the time */
+    header[0] = type;                                                          /* set the type */
+    header[1] = res;                                                           /* set the result */
+    header[2] = (uint8_t)(len >> 0);                                           /* set the length */
+    header[3] = (uint8_t)(len >> 8);                                           /* set the length */
+    header[4] = (uint8_t)(time_ms >> 0);                                       /* set the time */
+    header[5] = (uint8_t)(time_ms >> 8);                                       /* set the time */
+    header[6] = (uint8_t)(time_ms >> 16);                                      /* set the time */
+    header[7] = (uint8_t)(time_ms >> 24);                                      /* set the time */
+    if ((fwrite(header, 1, SPS30_REPLAY_RECORD_SIZE, record->fp) != SPS30_REPLAY_RECORD_SIZE) ||
+        ((len != 0) && (fwrite(buf, 1, len, record->fp) != len)))              /* write the record */
+    {
+        record->error = 1;                                                     /* set the error */
+        
+        return;
+    }
+    record->records++;                                                         /* records++ */
+}
+
+#if (SPS30_ENABLE_IIC == 1)
+/**
+ * @brief     recorder iic init
+ * @param[in] *user pointer to a recorder structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+static uint8_t a_sps30_record_iic_init(void *user)
+{
+    sps30_record_t *record = (sps30_record_t *)user;
+    
+    return (record->link.iic_init_ctx != NULL) ? record->link.iic_init_ctx(record->link.user) : record->link.iic_init();
+}
+
+/**
+ * @brief     recorder iic deinit
+ * @param[in] *user pointer to a recorder structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+static uint8_t a_sps30_record_iic_deinit(void *user)
+{
+    sps30_record_t *record = (sps30_record_t *)user;
+    
+    return (record->link.iic_deinit_ctx != NULL) ? record->link.iic_deinit_ctx(record->link.user) : record->link.iic_deinit();
+}
+
+/**
+ * @brief     recorder iic write cmd
+ * @param[in] *user pointer to a recorder structure
+ * @param[in] addr iic device address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+static uint8_t a_sps30_record_iic_write_cmd(void *user, uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    sps30_record_t *record = (sps30_record_t *)user;
+    uint8_t res;
+    
+    res = (record->link.iic_write_cmd_ctx != NULL) ? record->link.iic_write_cmd_ctx(record->link.user, addr, buf, len) :
+                                                     record->link.iic_write_cmd(addr, buf, len);
+    a_sps30_record_write(record, SPS30_TRACE_IIC_WRITE, res, buf, len);       /* record the write */
+    
+    return res;
+}
+
+/**
+ * @brief      recorder iic read cmd
+ * @param[in]  *user pointer to a recorder structure
+ * @param[in]  addr iic device address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 failed
+ * @note       none
+ */
+static uint8_t a_sps30_record_iic_read_cmd(void *user, uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    sps30_record_t *record = (sps30_record_t *)user;
+    uint8_t res;
+    
+    res = (record->link.iic_read_cmd_ctx != NULL) ? record->link.iic_read_cmd_ctx(record->link.user, addr, buf, len) :
+                                                    record->link.iic_read_cmd(addr, buf, len);
+    a_sps30_record_write(record, SPS30_TRACE_IIC_READ, res, buf, len);        /* record the read */
+    
+    return res;
+}
+#endif
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief     recorder uart init
+ * @param[in] *user pointer to a recorder structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+static uint8_t a_sps30_record_uart_init(void *user)
+{
+    sps30_record_t *record = (sps30_record_t *)user;
+    
+    return (record->link.uart_init_ctx != NULL) ? record->link.uart_init_ctx(record->link.user) : record->link.uart_init();
+}
+
+/**
+ * @brief     recorder uart deinit
+ * @param[in] *user pointer to a recorder structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+static uint8_t a_sps30_record_uart_deinit(void *user)
+{
+    sps30_record_t *record = (sps30_record_t *)user;
+    
+    return (record->link.uart_deinit_ctx != NULL) ? record->link.uart_deinit_ctx(record->link.user) : record->link.uart_deinit();
+}
+
+/**
+ * @brief      recorder uart read
+ * @param[in]  *user pointer to a recorder structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     length of the read data
+ * @note       none
+ */
+static uint16_t a_sps30_record_uart_read(void *user, uint8_t *buf, uint16_t len)
+{
+    sps30_record_t *record = (sps30_record_t *)user;
+    uint16_t n;
+    
+    n = (record->link.uart_read_ctx != NULL) ? record->link.uart_read_ctx(record->link.user, buf, len) :
+                                               record->link.uart_read(buf, len);
+    if (n != 0)                                                                /* skip the empty polls */
+    {
+        a_sps30_record_write(record, SPS30_TRACE_UART_READ, 0, buf, n);        /* record the read */
+    }
+    
+    return n;
+}
+
+/**
+ * @brief     recorder uart flush
+ * @param[in] *user pointer to a recorder structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+static uint8_t a_sps30_record_uart_flush(void *user)
+{
+    sps30_record_t *record = (sps30_record_t *)user;
+    
+    return (record->link.uart_flush_ctx != NULL) ? record->link.uart_flush_ctx(record->link.user) : record->link.uart_flush();
+}
+
+/**
+ * @brief     recorder uart write
+ * @param[in] *user pointer to a recorder structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+static uint8_t a_sps30_record_uart_write(void *user, uint8_t *buf, uint16_t len)
+{
+    sps30_record_t *record = (sps30_record_t *)user;
+    uint8_t res;
+    
+    res = (record->link.uart_write_ctx != NULL) ? record->link.uart_write_ctx(record->link.user, buf, len) :
+                                                  record->link.uart_write(buf, len);
+    a_sps30_record_write(record, SPS30_TRACE_UART_WRITE, res, buf, len);      /* record the write */
+    
+    return res;
+}
+#endif
+
+/**
+ * @brief     recorder delay ms
+ * @param[in] *user pointer to a recorder structure
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_sps30_record_delay_ms(void *user, uint32_t ms)
+{
+    sps30_record_t *record = (sps30_record_t *)user;
+    
+    if (record->link.delay_ms_ctx != NULL)
+    {
+        record->link.delay_ms_ctx(record->link.user, ms);
+    }
+    else
+    {
+        record->link.delay_ms(ms);
+    }
+}
+
+/**
+ * @brief     recorder delay us
+ * @param[in] *user pointer to a recorder structure
+ * @param[in] us time
+ * @note      none
+ */
+static void a_sps30_record_delay_us(void *user, uint32_t us)
+{
+    sps30_record_t *record = (sps30_record_t *)user;
+    
+    if (record->link.delay_us_ctx != NULL)
+    {
+        record->link.delay_us_ctx(record->link.user, us);
+    }
+    else
+    {
+        record->link.delay_us(us);
+    }
+}
+
+#if (SPS30_ENABLE_TRACE == 1) || (SPS30_ENABLE_STATS == 1)
+/**
+ * @brief     recorder now us
+ * @param[in] *user pointer to a recorder structure
+ * @return    time in us
+ * @note      none
+ */
+static uint32_t a_sps30_record_now_us(void *user)
+{
+    sps30_record_t *record = (sps30_record_t *)user;
+    
+    return (record->link.now_us_ctx != NULL) ? record->link.now_us_ctx(record->link.user) : record->link.now_us();
+}
+#endif
+#endif
+
+uint8_t sps30_record_start(sps30_handle_t *handle, sps30_record_t *record, FILE *fp)
+{
+#if (SPS30_STATIC_PORT != 1)
+    const uint8_t header[SPS30_REPLAY_HEADER_SIZE] = {'S', '3', '0', 'T', SPS30_REPLAY_VERSION, 0, 0, 0};
+#endif
+    
+    if ((handle == NULL) || (record == NULL) || (fp == NULL))                  /* check the params */
+    {
+        return 2;                                                              /* return error */
+    }
+#if (SPS30_STATIC_PORT == 1)
+    return 1;                                                                  /* the static port has no links to replace */
+#else
+    if (fwrite(header, 1, SPS30_REPLAY_HEADER_SIZE, fp) != SPS30_REPLAY_HEADER_SIZE)    /* write the header */
+    {
+        return 1;                                                              /* return error */
+    }
+    record->fp = fp;                                                           /* set the file */
+    record->records = 0;                                                       /* init 0 */
+    record->error = 0;                                                         /* init 0 */
+    memcpy(&record->link, handle, sizeof(sps30_handle_t));                     /* keep the linked functions */
+    
+    /* only wrap the linked functions, so the driver checks see the same links */
+#if (SPS30_ENABLE_IIC == 1)
+    if ((record->link.iic_init_ctx != NULL) || (record->link.iic_init != NULL))
+    {
+        DRIVER_SPS30_LINK_IIC_INIT_CTX(handle, a_sps30_record_iic_init);
+    }
+    if ((record->link.iic_deinit_ctx != NULL) || (record->link.iic_deinit != NULL))
+    {
+        DRIVER_SPS30_LINK_IIC_DEINIT_CTX(handle, a_sps30_record_iic_deinit);
+    }
+    if ((record->link.iic_write_cmd_ctx != NULL) || (record->link.iic_write_cmd != NULL))
+    {
+        DRIVER_SPS30_LINK_IIC_WRITE_COMMAND_CTX(handle, a_sps30_record_iic_write_cmd);
+    }
+    if ((record->link.iic_read_cmd_ctx != NULL) || (record->link.iic_read_cmd != NULL))
+    {
+        DRIVER_SPS30_LINK_IIC_READ_COMMAND_CTX(handle, a_sps30_record_iic_read_cmd);
+    }
+#endif
+#if (SPS30_ENABLE_UART == 1)
+    if ((record->link.uart_init_ctx != NULL) || (record->link.uart_init != NULL))
+    {
+        DRIVER_SPS30_LINK_UART_INIT_CTX(handle, a_sps30_record_uart_init);
+    }
+    if ((record->link.uart_deinit_ctx != NULL) || (record->link.uart_deinit != NULL))
+    {
+        DRIVER_SPS30_LINK_UART_DEINIT_CTX(handle, a_sps30_record_uart_deinit);
+    }
+    if ((record->link.uart_read_ctx != NULL) || (record->link.uart_read != NULL))
+    {
+        DRIVER_SPS30_LINK_UART_READ_CTX(handle, a_sps30_record_uart_read);
+    }
+    if ((record->link.uart_write_ctx != NULL) || (record->link.uart_write != NULL))
+    {
+        DRIVER_SPS30_LINK_UART_WRITE_CTX(handle, a_sps30_record_uart_write);
+    }
+    if ((record->link.uart_flush_ctx != NULL) || (record->link.uart_flush != NULL))
+    {
+        DRIVER_SPS30_LINK_UART_FLUSH_CTX(handle, a_sps30_record_uart_flush);
+    }
+#endif
+    if ((record->link.delay_ms_ctx != NULL) || (record->link.delay_ms != NULL))
+    {
+        DRIVER_SPS30_LINK_DELAY_MS_CTX(handle, a_sps30_record_delay_ms);
+    }
+    if ((record->link.delay_us_ctx != NULL) || (record->link.delay_us != NULL))
+    {
+        DRIVER_SPS30_LINK_DELAY_US_CTX(handle, a_sps30_record_delay_us);
+    }
+#if (SPS30_ENABLE_TRACE == 1) || (SPS30_ENABLE_STATS == 1)
+    if ((record->link.now_us_ctx != NULL) || (record->link.now_us != NULL))
+    {
+        DRIVER_SPS30_LINK_NOW_US_CTX(handle, a_sps30_record_now_us);
+    }
+#endif
+    DRIVER_SPS30_LINK_USER_DATA(handle, record);
+    
+    return 0;                                                                  /* success return 0 */
+#endif
+}
+
+uint8_t sps30_record_stop(sps30_handle_t *handle, sps30_record_t *record)
+{
+    if ((handle == NULL) || (record == NULL))                                  /* check the params */
+    {
+        return 2;                                                              /* return error */
+    }
+#if (SPS30_STATIC_PORT == 1)
+    return 1;                                                                  /* the static port has no links to replace */
+#else
+#if (SPS30_ENABLE_IIC == 1)
+    DRIVER_SPS30_LINK_IIC_INIT_CTX(handle, record->link.iic_init_ctx);
+    DRIVER_SPS30_LINK_IIC_DEINIT_CTX(handle, record->link.iic_deinit_ctx);
+    DRIVER_SPS30_LINK_IIC_WRITE_COMMAND_CTX(handle, record->link.iic_write_cmd_ctx);
+    DRIVER_SPS30_LINK_IIC_READ_COMMAND_CTX(handle, record->link.iic_read_cmd_ctx);
+#endif
+#if (SPS30_ENABLE_UART == 1)
+    DRIVER_SPS30_LINK_UART_INIT_CTX(handle, record->link.uart_init_ctx);
+    DRIVER_SPS30_LINK_UART_DEINIT_CTX(handle, record->link.uart_deinit_ctx);
+    DRIVER_SPS30_LINK_UART_READ_CTX(handle, record->link.uart_read_ctx);
+    DRIVER_SPS30_LINK_UART_WRITE_CTX(handle, record->link.uart_write_ctx);
+    DRIVER_SPS30_LINK_UART_FLUSH_CTX(handle, record->link.uart_flush_ctx);
+#endif
+    DRIVER_SPS30_LINK_DELAY_MS_CTX(handle, record->link.delay_ms_ctx);
+    DRIVER_SPS30_LINK_DELAY_US_CTX(handle, record->link.delay_us_ctx);
+#if (SPS30_ENABLE_TRACE == 1) || (SPS30_ENABLE_STATS == 1)
+    DRIVER_SPS30_LINK_NOW_US_CTX(handle, record->link.now_us_ctx);
+#endif
+    DRIVER_SPS30_LINK_USER_DATA(handle, record->link.user);
+    if (fflush(record->fp) != 0)                                               /* flush the file */
+    {
+        record->error = 1;                                                     /* set the error */
+    }
+    
+    return (record->error != 0) ? 1 : 0;                                       /* return the result */
+#endif
+}
+
+/**
+ * @brief      take the next record
+ * @param[in]  *replay pointer to a replay structure
+ * @param[in]  type expected sps30_trace_t
+ * @param[out] **data pointer to a data pointer
+ * @param[out] *len pointer to a data length buffer
+ * @return     record result or 0xFF if the next record is not the expected type
+ * @note       the record is consumed only if the type matches
+ */
+static uint8_t a_sps30_replay_next(sps30_replay_t *replay, uint8_t type, const uint8_t **data, uint16_t *len)
+{
+    const uint8_t *p;
+    
+    if (replay->point + SPS30_REPLAY_RECORD_SIZE > replay->len)                /* check the end */
+    {
+        return 0xFF;                                                           /* return error */
+    }
+    p = &replay->buf[replay->point];                                           /* get the record */
+    if (p[0] != type)                                                          /* check the type */
+    {
+        return 0xFF;                                                           /* return error */
+    }
+    *len = (uint16_t)(p[2] | (p[3] << 8));                                     /* get the length */
+    *data = &p[SPS30_REPLAY_RECORD_SIZE];                                      /* get the data */
+    replay->time_ms = (uint32_t)p[4] | ((uint32_t)p[5] << 8) |
+                      ((uint32_t)p[6] << 16) | ((uint32_t)p[7] << 24);         /* get the time */
+    
+    return p[1];                                                               /* return the result */
+}
+
+/**
+ * @brief     consume the current record
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] len data length of the record
+ * @note      none
+ */
+static void a_sps30_replay_skip(sps30_replay_t *replay, uint16_t len)
+{
+    replay->point += SPS30_REPLAY_RECORD_SIZE + len;                           /* next record */
+    replay->offset = 0;                                                        /* init 0 */
+    replay->records++;                                                         /* records++ */
+}
+
+/**
+ * @brief     replay a write
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] type sps30_trace_t
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    recorded result or 1 on a mismatch
+ * @note      none
+ */
+static uint8_t a_sps30_replay_write(sps30_replay_t *replay, uint8_t type, uint8_t *buf, uint16_t len)
+{
+    const uint8_t *data;
+    uint16_t l;
+    uint8_t res;
+    
+    res = a_sps30_replay_next(replay, type, &data, &l);                        /* get the record */
+    if ((res == 0xFF) || (l != len) || (memcmp(data, buf, len) != 0))          /* check the record */
+    {
+        replay->mismatch++;                                                    /* mismatch++ */
+        
+        return 1;                                                              /* return error */
+    }
+    a_sps30_replay_skip(replay, l);                                            /* next record */
+    
+    return res;                                                                /* return the result */
+}
+
+/**
+ * @brief     replay init, deinit and flush
+ * @param[in] *user pointer to a replay structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+static uint8_t a_sps30_replay_ok(void *user)
+{
+    (void)user;
+    
+    return 0;
+}
+
+#if (SPS30_ENABLE_IIC == 1)
+/**
+ * @brief     replay iic write cmd
+ * @param[in] *user pointer to a replay structure
+ * @param[in] addr iic device address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+static uint8_t a_sps30_replay_iic_write_cmd(void *user, uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    
+    return a_sps30_replay_write((sps30_replay_t *)user, SPS30_TRACE_IIC_WRITE, buf, len);
+}
+
+/**
+ * @brief      replay iic read cmd
+ * @param[in]  *user pointer to a replay structure
+ * @param[in]  addr iic device address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 failed
+ * @note       none
+ */
+static uint8_t a_sps30_replay_iic_read_cmd(void *user, uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    sps30_replay_t *replay = (sps30_replay_t *)user;
+    const uint8_t *data;
+    uint16_t l;
+    uint8_t res;
+    
+    (void)addr;
+    res = a_sps30_replay_next(replay, SPS30_TRACE_IIC_READ, &data, &l);       /* get the record */
+    if ((res == 0xFF) || (l != len))                                           /* check the record */
+    {
+        replay->mismatch++;                                                    /* mismatch++ */
+        
+        return 1;                                                              /* return error */
+    }
+    memcpy(buf, data, len);                                                    /* copy the data */
+    a_sps30_replay_skip(replay, l);                                            /* next record */
+    
+    return res;                                                                /* return the result */
+}
+#endif
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief      replay uart read
+ * @param[in]  *user pointer to a replay structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     length of the read data
+ * @note       a record longer than the buffer is served over several reads
+ */
+static uint16_t a_sps30_replay_uart_read(void *user, uint8_t *buf, uint16_t len)
+{
+    sps30_replay_t *replay = (sps30_replay_t *)user;
+    const uint8_t *data;
+    uint16_t l;
+    uint16_t n;
+    
+    if (a_sps30_replay_next(replay, SPS30_TRACE_UART_READ, &data, &l) == 0xFF) /* no data now */
+    {
+        return 0;                                                              /* return empty */
+    }
+    n = l - replay->offset;                                                    /* get the left bytes */
+    if (n > len)                                                               /* check the buffer */
+    {
+        n = len;                                                               /* split the record */
+    }
+    memcpy(buf, &data[replay->offset], n);                                     /* copy the data */
+    replay->offset += n;                                                       /* add the offset */
+    if (replay->offset >= l)                                                   /* check the record */
+    {
+        a_sps30_replay_skip(replay, l);                                        /* next record */
+    }
+    
+    return n;                                                                  /* return the length */
+}
+
+/**
+ * @brief     replay uart write
+ * @param[in] *user pointer to a replay structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+static uint8_t a_sps30_replay_uart_write(void *user, uint8_t *buf, uint16_t len)
+{
+    return a_sps30_replay_write((sps30_replay_t *)user, SPS30_TRACE_UART_WRITE, buf, len);
+}
+#endif
+
+/**
+ * @brief     replay delay
+ * @param[in] *user pointer to a replay structure
+ * @param[in] t time
+ * @note      none
+ */
+static void a_sps30_replay_delay(void *user, uint32_t t)
+{
+    (void)user;
+    (void)t;
+}
+
+#if (SPS30_ENABLE_TRACE == 1) || (SPS30_ENABLE_STATS == 1)
+/**
+ * @brief     replay now us
+ * @param[in] *user pointer to a replay structure
+ * @return    recorded time of the last record in us
+ * @note      none
+ */
+static uint32_t a_sps30_replay_now_us(void *user)
+{
+    return ((sps30_replay_t *)user)->time_ms * 1000;
+}
+#endif
+
+uint8_t sps30_replay_init(sps30_replay_t *replay, const uint8_t *buf, uint32_t len)
+{
+    uint32_t point;
+    
+    if ((replay == NULL) || (buf == NULL))                                     /* check the params */
+    {
+        return 2;                                                              /* return error */
+    }
+    if ((len < SPS30_REPLAY_HEADER_SIZE) || (memcmp(buf, "S30T", 4) != 0) ||
+        (buf[4] != SPS30_REPLAY_VERSION))                                      /* check the header */
+    {
+        return 1;                                                              /* return error */
+    }
+    point = SPS30_REPLAY_HEADER_SIZE;                                          /* skip the header */
+    while (point < len)                                                        /* check every record */
+    {
+        if ((point + SPS30_REPLAY_RECORD_SIZE > len) || (buf[point] > SPS30_TRACE_UART_READ))
+        {
+            return 1;                                                          /* return error */
+        }
+        point += SPS30_REPLAY_RECORD_SIZE + (uint32_t)(buf[point + 2] | (buf[point + 3] << 8));
+    }
+    if (point != len)                                                          /* check the last record */
+    {
+        return 1;                                                              /* return error */
+    }
+    memset(replay, 0, sizeof(sps30_replay_t));                                 /* clear the replay */
+    replay->buf = buf;                                                         /* set the buffer */
+    replay->len = len;                                                         /* set the length */
+    replay->point = SPS30_REPLAY_HEADER_SIZE;                                  /* first record */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+uint8_t sps30_replay_link(sps30_handle_t *handle, sps30_replay_t *replay)
+{
+    if ((handle == NULL) || (replay == NULL))                                  /* check the params */
+    {
+        return 2;                                                              /* return error */
+    }
+#if (SPS30_ENABLE_IIC == 1)
+    DRIVER_SPS30_LINK_IIC_INIT_CTX(handle, a_sps30_replay_ok);
+    DRIVER_SPS30_LINK_IIC_DEINIT_CTX(handle, a_sps30_replay_ok);
+    DRIVER_SPS30_LINK_IIC_WRITE_COMMAND_CTX(handle, a_sps30_replay_iic_write_cmd);
+    DRIVER_SPS30_LINK_IIC_READ_COMMAND_CTX(handle, a_sps30_replay_iic_read_cmd);
+#endif
+#if (SPS30_ENABLE_UART == 1)
+    DRIVER_SPS30_LINK_UART_INIT_CTX(handle, a_sps30_replay_ok);
+    DRIVER_SPS30_LINK_UART_DEINIT_CTX(handle, a_sps30_replay_ok);
+    DRIVER_SPS30_LINK_UART_READ_CTX(handle, a_sps30_replay_uart_read);
+    DRIVER_SPS30_LINK_UART_WRITE_CTX(handle, a_sps30_replay_uart_write);
+    DRIVER_SPS30_LINK_UART_FLUSH_CTX(handle, a_sps30_replay_ok);
+#endif
+    DRIVER_SPS30_LINK_DELAY_MS_CTX(handle, a_sps30_replay_delay);
+    DRIVER_SPS30_LINK_DELAY_US_CTX(handle, a_sps30_replay_delay);
+#if (SPS30_ENABLE_TRACE == 1) || (SPS30_ENABLE_STATS == 1)
+    DRIVER_SPS30_LINK_NOW_US_CTX(handle, a_sps30_replay_now_us);
+#endif
+    DRIVER_SPS30_LINK_USER_DATA(handle, replay);
+    
+#if (SPS30_STATIC_PORT == 1)
+    return 1;                                                                  /* the static port keeps its own functions */
+#else
+    return 0;                                                                  /* success return 0 */
+#endif
+}
+
+uint8_t sps30_replay_done(sps30_replay_t *replay)
+{
+    return (replay->point >= replay->len) ? 1 : 0;                             /* check the end */
+}
+
+uint32_t sps30_replay_now_ms(void *user)
+{
+    return ((sps30_replay_t *)user)->time_ms;                                  /* return the time */
+}
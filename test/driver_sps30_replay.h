@@ -0,0 +1,170 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_sps30_replay.h
+ * @brief     driver sps30 bus record and replay header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_SPS30_REPLAY_H
+#define DRIVER_SPS30_REPLAY_H
+
+#include "driver_sps30.h"
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup sps30_replay_driver sps30 record and replay function
+ * @brief    sps30 bus traffic capture and deterministic replay
+ * @ingroup  sps30_test_driver
+ * @{
+ */
+
+/**
+ * @brief sps30 trace file definition
+ * @note  the file starts with the 8 bytes header "S30T", version and 3 reserved bytes,
+ *        then every record is type, res, len (2 bytes), time_ms (4 bytes) and len data
+ *        bytes, all in little endian, the type is one of sps30_trace_t
+ */
+#define SPS30_REPLAY_VERSION        1        /**< trace file version */
+#define SPS30_REPLAY_HEADER_SIZE    8        /**< trace file header size */
+#define SPS30_REPLAY_RECORD_SIZE    8        /**< record header size */
+
+/**
+ * @brief sps30 recorder structure definition
+ */
+typedef struct sps30_record_s
+{
+    FILE *fp;                        /**< trace file */
+    sps30_handle_t link;             /**< copy of the handle with the recorded functions */
+    uint32_t records;                /**< written records */
+    uint8_t error;                   /**< file write error flag */
+} sps30_record_t;
+
+/**
+ * @brief sps30 replay structure definition
+ */
+typedef struct sps30_replay_s
+{
+    const uint8_t *buf;              /**< trace buffer */
+    uint32_t len;                    /**< trace length */
+    uint32_t point;                  /**< next record point */
+    uint16_t offset;                 /**< served bytes of the current uart read record */
+    uint32_t time_ms;                /**< time of the last served record */
+    uint32_t records;                /**< served records */
+    uint32_t mismatch;               /**< requests that don't match the trace */
+} sps30_replay_t;
+
+/**
+ * @brief     start recording a handle
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] *record pointer to a recorder structure
+ * @param[in] *fp pointer to a trace file opened for binary writing
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed or static port is enabled
+ *            - 2 handle, record or fp is NULL
+ * @note      call it after the bus functions are linked, the recorder sits between
+ *            the driver and them and takes the handle user context, every iic read
+ *            and write, every uart write and every uart read that returns data is
+ *            written with the sps30_interface_now_ms time
+ */
+uint8_t sps30_record_start(sps30_handle_t *handle, sps30_record_t *record, FILE *fp);
+
+/**
+ * @brief     stop recording a handle
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] *record pointer to a recorder structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed during the record or static port is enabled
+ *            - 2 handle or record is NULL
+ * @note      the linked functions and the user context are restored, the file is
+ *            flushed but left open
+ */
+uint8_t sps30_record_stop(sps30_handle_t *handle, sps30_record_t *record);
+
+/**
+ * @brief     initialize a replay
+ * @param[in] *replay pointer to a replay structure
+ * @param[in] *buf pointer to a trace buffer
+ * @param[in] len trace length
+ * @return    status code
+ *            - 0 success
+ *            - 1 trace is invalid
+ *            - 2 replay or buf is NULL
+ * @note      the buffer must stay valid during the replay
+ */
+uint8_t sps30_replay_init(sps30_replay_t *replay, const uint8_t *buf, uint32_t len);
+
+/**
+ * @brief     link a replay to a handle
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] *replay pointer to a replay structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 static port is enabled
+ *            - 2 handle or replay is NULL
+ * @note      links the ctx bus and delay functions and the user context, the reads
+ *            answer with the recorded bytes, the writes are checked against the
+ *            recorded bytes and answer with the recorded result, the delays return
+ *            at once, the debug_print function is left to the caller
+ */
+uint8_t sps30_replay_link(sps30_handle_t *handle, sps30_replay_t *replay);
+
+/**
+ * @brief     check if a replay is finished
+ * @param[in] *replay pointer to a replay structure
+ * @return    1 if all records are served, else 0
+ * @note      none
+ */
+uint8_t sps30_replay_done(sps30_replay_t *replay);
+
+/**
+ * @brief     get the replay time
+ * @param[in] *user pointer to a replay structure
+ * @return    time of the last served record in ms
+ * @note      it can be set as the interface time source, so the async apis see the recorded time
+ */
+uint32_t sps30_replay_now_ms(void *user);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
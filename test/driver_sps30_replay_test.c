@@ -0,0 +1,379 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_sps30_replay_test.c
+ * @brief     driver sps30 replay test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_sps30_replay_test.h"
+#include "driver_sps30_replay.h"
+#include "driver_sps30_sim.h"
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief replay test definition
+ */
+#define SPS30_REPLAY_TEST_MAX_TIMES        1000             /**< max read times */
+#define SPS30_REPLAY_TEST_TRACE_SIZE       (512 * 1024)     /**< trace buffer size */
+#define SPS30_REPLAY_TEST_ROUNDS           100              /**< replay bench rounds */
+#if (SPS30_ENABLE_FLOAT == 1)
+#define SPS30_REPLAY_TEST_FORMAT           SPS30_FORMAT_IEEE754    /**< float results */
+#else
+#define SPS30_REPLAY_TEST_FORMAT           SPS30_FORMAT_UINT16     /**< integer results without float */
+#endif
+
+static sps30_handle_t gs_handle;                               /**< sps30 handle */
+static sps30_sim_t gs_sim;                                     /**< sps30 simulator */
+static sps30_record_t gs_record;                               /**< sps30 recorder */
+static sps30_replay_t gs_replay;                               /**< sps30 replay */
+#if (SPS30_ENABLE_FLOAT == 1)
+static sps30_pm_t gs_pm[SPS30_REPLAY_TEST_MAX_TIMES];          /**< recorded results */
+#else
+static sps30_pm_u16_t gs_pm[SPS30_REPLAY_TEST_MAX_TIMES];      /**< recorded integer results */
+#endif
+static uint8_t gs_trace[SPS30_REPLAY_TEST_TRACE_SIZE];         /**< trace buffer */
+
+/**
+ * @brief     replay delay
+ * @param[in] *user pointer to a replay structure
+ * @param[in] t time
+ * @note      none
+ */
+static void a_sps30_replay_test_delay(void *user, uint32_t t)
+{
+    (void)user;
+    (void)t;
+}
+
+static const sps30_interface_clock_t gs_replay_clock =
+{
+    sps30_replay_now_ms, a_sps30_replay_test_delay, a_sps30_replay_test_delay, &gs_replay,
+};                                                             /**< replay clock */
+
+/**
+ * @brief     run the recorded session
+ * @param[in] interface chip interface
+ * @param[in] times read times
+ * @param[in] check 0 to keep the results, 1 to check them
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the same calls run against the simulator and the replay,
+ *            it prints through the handle, so a quiet handle keeps it silent
+ */
+static uint8_t a_sps30_replay_test_session(sps30_interface_t interface, uint32_t times, uint8_t check)
+{
+    uint32_t i;
+    char type[9];
+    char sn[17];
+#if (SPS30_ENABLE_FLOAT == 1)
+    sps30_pm_t pm;
+#else
+    sps30_pm_u16_t pm;
+#endif
+    
+    if ((sps30_set_interface(&gs_handle, interface) != 0) || (sps30_init(&gs_handle) != 0))
+    {
+        gs_handle.debug_print("sps30: init failed.\n");
+        
+        return 1;
+    }
+    if ((sps30_get_product_type(&gs_handle, type) != 0) || (sps30_get_serial_number(&gs_handle, sn) != 0) ||
+        (sps30_start_measurement(&gs_handle, SPS30_REPLAY_TEST_FORMAT) != 0))
+    {
+        gs_handle.debug_print("sps30: start failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (i = 0; i < times; i++)
+    {
+        /* one sample per second, the fan cleaning in the middle */
+        sps30_interface_delay_ms(1000);
+        if (i == times / 2)
+        {
+            if (sps30_start_fan_cleaning(&gs_handle) != 0)
+            {
+                gs_handle.debug_print("sps30: start fan cleaning failed.\n");
+                (void)sps30_deinit(&gs_handle);
+                
+                return 1;
+            }
+            sps30_interface_delay_ms(10000);
+        }
+        gs_sim.value[0] = 1.0f + (float)(i % 100);
+#if (SPS30_ENABLE_FLOAT == 1)
+        if (sps30_read(&gs_handle, &pm) != 0)
+#else
+        if (sps30_read_u16(&gs_handle, &pm) != 0)
+#endif
+        {
+            gs_handle.debug_print("sps30: read failed.\n");
+            (void)sps30_deinit(&gs_handle);
+            
+            return 1;
+        }
+        if (check == 0)
+        {
+            gs_pm[i] = pm;
+        }
+        else if (memcmp(&pm, &gs_pm[i], sizeof(pm)) != 0)
+        {
+            gs_handle.debug_print("sps30: read %d doesn't match the record.\n", (int)i);
+            (void)sps30_deinit(&gs_handle);
+            
+            return 1;
+        }
+        else
+        {
+            
+        }
+    }
+    if (sps30_stop_measurement(&gs_handle) != 0)
+    {
+        gs_handle.debug_print("sps30: stop measurement failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    (void)sps30_deinit(&gs_handle);
+    
+    return 0;
+}
+
+/**
+ * @brief     record the session against the simulator
+ * @param[in] interface chip interface
+ * @param[in] times read times
+ * @param[out] *len pointer to a trace length buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 record failed
+ * @note      none
+ */
+static uint8_t a_sps30_replay_test_record(sps30_interface_t interface, uint32_t times, uint32_t *len)
+{
+    uint8_t res;
+    size_t l;
+    FILE *fp;
+    
+    fp = tmpfile();
+    if (fp == NULL)
+    {
+        sps30_interface_debug_print("sps30: open trace file failed.\n");
+        
+        return 1;
+    }
+    (void)sps30_sim_init(&gs_sim);
+    DRIVER_SPS30_LINK_INIT(&gs_handle, sps30_handle_t);
+    if (sps30_sim_link(&gs_handle, &gs_sim) != 0)
+    {
+        sps30_interface_debug_print("sps30: sim link failed.\n");
+        (void)fclose(fp);
+        
+        return 1;
+    }
+    DRIVER_SPS30_LINK_DEBUG_PRINT(&gs_handle, sps30_interface_debug_print);
+    if (sps30_record_start(&gs_handle, &gs_record, fp) != 0)
+    {
+        sps30_interface_debug_print("sps30: record start failed.\n");
+        (void)fclose(fp);
+        
+        return 1;
+    }
+    sps30_interface_set_clock(&gs_sim.clock);
+    res = a_sps30_replay_test_session(interface, times, 0);
+    sps30_interface_set_clock(NULL);
+    if ((sps30_record_stop(&gs_handle, &gs_record) != 0) || (res != 0))
+    {
+        sps30_interface_debug_print("sps30: record failed.\n");
+        (void)fclose(fp);
+        
+        return 1;
+    }
+    rewind(fp);
+    l = fread(gs_trace, 1, SPS30_REPLAY_TEST_TRACE_SIZE, fp);
+    (void)fclose(fp);
+    if ((l == 0) || (l >= SPS30_REPLAY_TEST_TRACE_SIZE))
+    {
+        sps30_interface_debug_print("sps30: trace is too large.\n");
+        
+        return 1;
+    }
+    *len = (uint32_t)l;
+    sps30_interface_debug_print("sps30: record %d records in %d bytes.\n", (int)gs_record.records, (int)l);
+    
+    return 0;
+}
+
+/**
+ * @brief     replay the session from the trace
+ * @param[in] interface chip interface
+ * @param[in] times read times
+ * @param[in] len trace length
+ * @param[in] quiet 1 to drop the prints of a replay that is expected to fail
+ * @return    status code
+ *            - 0 success
+ *            - 1 replay failed
+ * @note      none
+ */
+static uint8_t a_sps30_replay_test_replay(sps30_interface_t interface, uint32_t times, uint32_t len, uint8_t quiet)
+{
+    uint8_t res;
+    
+    if (sps30_replay_init(&gs_replay, gs_trace, len) != 0)
+    {
+        sps30_interface_debug_print("sps30: trace is invalid.\n");
+        
+        return 1;
+    }
+    DRIVER_SPS30_LINK_INIT(&gs_handle, sps30_handle_t);
+    if (sps30_replay_link(&gs_handle, &gs_replay) != 0)
+    {
+        sps30_interface_debug_print("sps30: replay link failed.\n");
+        
+        return 1;
+    }
+    DRIVER_SPS30_LINK_DEBUG_PRINT(&gs_handle, (quiet != 0) ? sps30_sim_quiet_print : sps30_interface_debug_print);
+    sps30_interface_set_clock(&gs_replay_clock);
+    res = a_sps30_replay_test_session(interface, times, 1);
+    sps30_interface_set_clock(NULL);
+    if ((res != 0) || (gs_replay.mismatch != 0) || (sps30_replay_done(&gs_replay) == 0))
+    {
+        if (quiet == 0)
+        {
+            sps30_interface_debug_print("sps30: replay failed with %d mismatches.\n", (int)gs_replay.mismatch);
+        }
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     find a byte to corrupt
+ * @param[in] len trace length
+ * @return    offset of a data byte of the first read record in the second half
+ * @note      the crc or the checksum of that read must fail on the replay
+ */
+static uint32_t a_sps30_replay_test_corrupt(uint32_t len)
+{
+    uint32_t point;
+    uint16_t l;
+    
+    point = SPS30_REPLAY_HEADER_SIZE;
+    while (point < len)
+    {
+        l = (uint16_t)(gs_trace[point + 2] | (gs_trace[point + 3] << 8));
+        if ((point > len / 2) && (l > 8) &&
+            ((gs_trace[point] == SPS30_TRACE_IIC_READ) || (gs_trace[point] == SPS30_TRACE_UART_READ)))
+        {
+            return point + SPS30_REPLAY_RECORD_SIZE + 5;
+        }
+        point += SPS30_REPLAY_RECORD_SIZE + l;
+    }
+    
+    return len - 1;
+}
+
+/**
+ * @brief     replay test
+ * @param[in] interface chip interface
+ * @param[in] times read times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      runs on the host, records a session against the software model,
+ *            replays it without the model and checks every read
+ */
+uint8_t sps30_replay_test(sps30_interface_t interface, uint32_t times)
+{
+    uint32_t i;
+    uint32_t len;
+    uint32_t corrupt;
+    double s;
+    clock_t start;
+    
+    /* start replay test */
+    sps30_interface_debug_print("sps30: start replay test.\n");
+    if ((times == 0) || (times > SPS30_REPLAY_TEST_MAX_TIMES))
+    {
+        sps30_interface_debug_print("sps30: times is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* record */
+    if (a_sps30_replay_test_record(interface, times, &len) != 0)
+    {
+        return 1;
+    }
+    
+    /* replay and check */
+    if (a_sps30_replay_test_replay(interface, times, len, 0) != 0)
+    {
+        return 1;
+    }
+    sps30_interface_debug_print("sps30: replay check passed.\n");
+    
+    /* a corrupted trace must not replay */
+    corrupt = a_sps30_replay_test_corrupt(len);
+    gs_trace[corrupt] ^= 0x01;
+    if (a_sps30_replay_test_replay(interface, times, len, 1) == 0)
+    {
+        sps30_interface_debug_print("sps30: corrupted trace check failed.\n");
+        
+        return 1;
+    }
+    gs_trace[corrupt] ^= 0x01;
+    sps30_interface_debug_print("sps30: corrupted trace rejected as expected, mismatches %d.\n", (int)gs_replay.mismatch);
+    
+    /* replay at full speed */
+    start = clock();
+    for (i = 0; i < SPS30_REPLAY_TEST_ROUNDS; i++)
+    {
+        if (a_sps30_replay_test_replay(interface, times, len, 0) != 0)
+        {
+            return 1;
+        }
+    }
+    s = (double)(clock() - start) / (double)CLOCKS_PER_SEC;
+    sps30_interface_debug_print("sps30: replay %d reads in %0.3f ms.\n",
+                                (int)(times * SPS30_REPLAY_TEST_ROUNDS), s * 1000.0);
+    
+    /* finish replay test */
+    sps30_interface_debug_print("sps30: finish replay test.\n");
+    
+    return 0;
+}
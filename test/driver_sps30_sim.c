@@ -0,0 +1,835 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_sps30_sim.c
+ * @brief     driver sps30 simulator source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_sps30_sim.h"
+#include <string.h>
+
+/**
+ * @brief simulator definition
+ */
+#define SPS30_SIM_ADDRESS              (0x69 << 1)        /**< iic write address */
+#define SPS30_SIM_SAMPLE_US            1000000ULL         /**< measured values cadence in us */
+#define SPS30_SIM_CLEANING_US          10000000ULL        /**< fan cleaning time in us */
+#define SPS30_SIM_ERROR_LENGTH         0x01               /**< wrong data length state */
+#define SPS30_SIM_ERROR_COMMAND        0x02               /**< unknown command state */
+#define SPS30_SIM_ERROR_PARAMETER      0x04               /**< illegal command parameter state */
+#define SPS30_SIM_ERROR_STATE          0x43               /**< command not allowed in current state */
+
+/**
+ * @brief     calculate the iic crc
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @return    crc
+ * @note      bitwise crc-8, kept apart from the driver table on purpose
+ */
+static uint8_t a_sps30_sim_crc(const uint8_t *data, uint16_t len)
+{
+    uint16_t i;
+    uint8_t j;
+    uint8_t crc = 0xFF;
+    
+    for (i = 0; i < len; i++)                                     /* all bytes */
+    {
+        crc ^= data[i];                                           /* xor the byte */
+        for (j = 0; j < 8; j++)                                   /* 8 bits */
+        {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);   /* shift */
+        }
+    }
+    
+    return crc;                                                   /* return crc */
+}
+
+/**
+ * @brief     get the latest sample index
+ * @param[in] *sim pointer to a simulator structure
+ * @return    sample index, 0 before the first sample
+ * @note      none
+ */
+static uint32_t a_sps30_sim_index(sps30_sim_t *sim)
+{
+    if (sim->state != SPS30_SIM_STATE_MEASUREMENT)                   /* not measuring */
+    {
+        return sim->sample;                                          /* no new sample */
+    }
+    
+    return (uint32_t)((sim->now_us - sim->start_us) / SPS30_SIM_SAMPLE_US);    /* one sample per second */
+}
+
+/**
+ * @brief      encode the measured values
+ * @param[in]  *sim pointer to a simulator structure
+ * @param[out] *buf pointer to a big endian payload buffer
+ * @return     payload length
+ * @note       the uint16 format rounds the values and gives the typical size in nm
+ */
+static uint16_t a_sps30_sim_values(sps30_sim_t *sim, uint8_t *buf)
+{
+    union float_u
+    {
+        float f;
+        uint32_t i;
+    };
+    union float_u f;
+    float v;
+    uint8_t i;
+    
+    for (i = 0; i < 10; i++)                                         /* 10 values */
+    {
+        if (sim->format == SPS30_FORMAT_IEEE754)                     /* float */
+        {
+            f.f = sim->value[i];                                     /* set the value */
+            buf[i * 4 + 0] = (uint8_t)(f.i >> 24);                   /* set msb */
+            buf[i * 4 + 1] = (uint8_t)(f.i >> 16);                   /* set byte 2 */
+            buf[i * 4 + 2] = (uint8_t)(f.i >> 8);                    /* set byte 1 */
+            buf[i * 4 + 3] = (uint8_t)(f.i >> 0);                    /* set lsb */
+        }
+        else                                                         /* uint16 */
+        {
+            v = (i == 9) ? (sim->value[i] * 1000.0f) : sim->value[i];    /* typical size in nm */
+            v = (v < 0.0f) ? 0.0f : ((v > 65535.0f) ? 65535.0f : v);     /* clamp */
+            buf[i * 2 + 0] = (uint8_t)((uint16_t)(v + 0.5f) >> 8);       /* set msb */
+            buf[i * 2 + 1] = (uint8_t)((uint16_t)(v + 0.5f) >> 0);       /* set lsb */
+        }
+    }
+    
+    return (sim->format == SPS30_FORMAT_IEEE754) ? 40 : 20;          /* return the length */
+}
+
+/**
+ * @brief     queue a uart response frame
+ * @param[in] *sim pointer to a simulator structure
+ * @param[in] cmd command
+ * @param[in] state state byte
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @note      the frame is stuffed into the response buffer
+ */
+static void a_sps30_sim_respond(sps30_sim_t *sim, uint8_t cmd, uint8_t state, const uint8_t *data, uint8_t len)
+{
+    uint8_t frame[5 + 255];
+    uint8_t sum;
+    uint16_t i;
+    
+    frame[0] = 0x00;                                                 /* set addr */
+    frame[1] = cmd;                                                  /* set command */
+    frame[2] = state;                                                /* set state */
+    frame[3] = len;                                                  /* set length */
+    if (len != 0)                                                    /* check the data */
+    {
+        memcpy(&frame[4], data, len);                                /* copy the data */
+    }
+    sum = 0;                                                         /* init 0 */
+    for (i = 0; i < (uint16_t)(4 + len); i++)                        /* sum all bytes */
+    {
+        sum = (uint8_t)(sum + frame[i]);                             /* add the byte */
+    }
+    frame[4 + len] = (uint8_t)(~sum);                                /* set checksum */
+    if ((uint16_t)(sim->tx_len + (5 + len) * 2 + 2) > SPS30_SIM_BUFFER_SIZE)  /* check the space */
+    {
+        return;                                                      /* drop the frame */
+    }
+    sim->tx_buf[sim->tx_len++] = 0x7E;                               /* set start */
+    for (i = 0; i < (uint16_t)(5 + len); i++)                        /* stuff all bytes */
+    {
+        if ((frame[i] == 0x7E) || (frame[i] == 0x7D) || (frame[i] == 0x11) || (frame[i] == 0x13))
+        {
+            sim->tx_buf[sim->tx_len++] = 0x7D;                       /* escape */
+            sim->tx_buf[sim->tx_len++] = frame[i] ^ 0x20;            /* flip bit 5 */
+        }
+        else
+        {
+            sim->tx_buf[sim->tx_len++] = frame[i];                   /* copy the byte */
+        }
+    }
+    sim->tx_buf[sim->tx_len++] = 0x7E;                               /* set stop */
+}
+
+/**
+ * @brief     run an shdlc command
+ * @param[in] *sim pointer to a simulator structure
+ * @param[in] cmd command
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length
+ * @note      the response frame is queued
+ */
+static void a_sps30_sim_shdlc(sps30_sim_t *sim, uint8_t cmd, uint8_t *data, uint8_t len)
+{
+    uint8_t out[60];
+    uint8_t state;
+    uint8_t out_len;
+    uint32_t index;
+    
+    state = 0;                                                                 /* no error */
+    out_len = 0;                                                               /* no data */
+    switch (cmd)
+    {
+        case 0x00 :                                                            /* start measurement */
+        {
+            if ((len != 2) || (data[0] != 0x01))
+            {
+                state = SPS30_SIM_ERROR_LENGTH;
+            }
+            else if ((data[1] != SPS30_FORMAT_IEEE754) && (data[1] != SPS30_FORMAT_UINT16))
+            {
+                state = SPS30_SIM_ERROR_PARAMETER;
+            }
+            else if (sim->state != SPS30_SIM_STATE_IDLE)
+            {
+                state = SPS30_SIM_ERROR_STATE;
+            }
+            else
+            {
+                sim->format = data[1];                                         /* save the format */
+                sim->state = SPS30_SIM_STATE_MEASUREMENT;                      /* start measuring */
+                sim->start_us = sim->now_us;                                   /* save the start time */
+                sim->sample = 0;                                               /* no sample yet */
+            }
+            
+            break;
+        }
+        case 0x01 :                                                            /* stop measurement */
+        {
+            if (sim->state != SPS30_SIM_STATE_MEASUREMENT)
+            {
+                state = SPS30_SIM_ERROR_STATE;
+            }
+            else
+            {
+                sim->state = SPS30_SIM_STATE_IDLE;                             /* stop measuring */
+            }
+            
+            break;
+        }
+        case 0x03 :                                                            /* read measured values */
+        {
+            if (sim->state != SPS30_SIM_STATE_MEASUREMENT)
+            {
+                state = SPS30_SIM_ERROR_STATE;
+            }
+            else
+            {
+                index = a_sps30_sim_index(sim);                                /* get the sample */
+                if (index > sim->sample)                                       /* new sample */
+                {
+                    sim->sample = index;                                       /* mark it read */
+                    out_len = (uint8_t)a_sps30_sim_values(sim, out);           /* the frame is empty without it */
+                }
+            }
+            
+            break;
+        }
+        case 0x10 :                                                            /* sleep */
+        {
+            if (sim->state != SPS30_SIM_STATE_IDLE)
+            {
+                state = SPS30_SIM_ERROR_STATE;
+            }
+            else
+            {
+                sim->state = SPS30_SIM_STATE_SLEEP;                            /* sleep after the response */
+                sim->wake = 0;                                                 /* interface is off */
+            }
+            
+            break;
+        }
+        case 0x11 :                                                            /* wake up */
+        {
+            if (sim->state != SPS30_SIM_STATE_SLEEP)
+            {
+                state = SPS30_SIM_ERROR_STATE;
+            }
+            else
+            {
+                sim->state = SPS30_SIM_STATE_IDLE;                             /* back to idle */
+            }
+            
+            break;
+        }
+        case 0x56 :                                                            /* start fan cleaning */
+        {
+            if (sim->state != SPS30_SIM_STATE_MEASUREMENT)
+            {
+                state = SPS30_SIM_ERROR_STATE;
+            }
+            else
+            {
+                sim->cleaning_us = sim->now_us + SPS30_SIM_CLEANING_US;        /* clean for 10 s */
+            }
+            
+            break;
+        }
+        case 0x80 :                                                            /* read write auto cleaning interval */
+        {
+            if ((len == 1) && (data[0] == 0x00))                               /* read */
+            {
+                out[0] = (uint8_t)(sim->auto_cleaning_interval >> 24);
+                out[1] = (uint8_t)(sim->auto_cleaning_interval >> 16);
+                out[2] = (uint8_t)(sim->auto_cleaning_interval >> 8);
+                out[3] = (uint8_t)(sim->auto_cleaning_interval >> 0);
+                out_len = 4;
+            }
+            else if ((len == 5) && (data[0] == 0x00))                          /* write */
+            {
+                sim->auto_cleaning_interval = (uint32_t)data[1] << 24 | (uint32_t)data[2] << 16 |
+                                              (uint32_t)data[3] << 8 | (uint32_t)data[4] << 0;
+            }
+            else
+            {
+                state = SPS30_SIM_ERROR_LENGTH;
+            }
+            
+            break;
+        }
+        case 0xD0 :                                                            /* device information */
+        {
+            if ((len == 1) && (data[0] == 0x00))                               /* product type */
+            {
+                memcpy(out, sim->product_type, 9);
+                out_len = 9;
+            }
+            else if ((len == 1) && (data[0] == 0x03))                          /* serial number */
+            {
+                memcpy(out, sim->serial_number, 17);
+                out_len = 17;
+            }
+            else
+            {
+                state = SPS30_SIM_ERROR_PARAMETER;
+            }
+            
+            break;
+        }
+        case 0xD1 :                                                            /* read version */
+        {
+            out[0] = sim->version[0];                                          /* firmware major */
+            out[1] = sim->version[1];                                          /* firmware minor */
+            out[2] = 0x00;                                                     /* reserved */
+            out[3] = 0x07;                                                     /* hardware revision */
+            out[4] = 0x00;                                                     /* reserved */
+            out[5] = 0x02;                                                     /* shdlc major */
+            out[6] = 0x00;                                                     /* shdlc minor */
+            out_len = 7;
+            
+            break;
+        }
+        case 0xD2 :                                                            /* read device status register */
+        {
+            if ((len != 1) || (data[0] > 1))
+            {
+                state = SPS30_SIM_ERROR_LENGTH;
+            }
+            else
+            {
+                out[0] = (uint8_t)(sim->status >> 24);
+                out[1] = (uint8_t)(sim->status >> 16);
+                out[2] = (uint8_t)(sim->status >> 8);
+                out[3] = (uint8_t)(sim->status >> 0);
+                out[4] = 0x00;                                                 /* reserved */
+                out_len = 5;
+                if (data[0] == 1)                                              /* clear after read */
+                {
+                    sim->status = 0;                                           /* clear the status */
+                }
+            }
+            
+            break;
+        }
+        case 0xD3 :                                                            /* reset */
+        {
+            sim->state = SPS30_SIM_STATE_IDLE;                                 /* back to idle */
+            
+            break;
+        }
+        default :
+        {
+            state = SPS30_SIM_ERROR_COMMAND;
+            
+            break;
+        }
+    }
+    a_sps30_sim_respond(sim, cmd, state, out, out_len);                        /* queue the response */
+}
+
+/**
+ * @brief     prepare the iic words for the next read
+ * @param[in] *sim pointer to a simulator structure
+ * @param[in] *data pointer to a data buffer
+ * @param[in] len data length, a multiple of 2
+ * @note      none
+ */
+static void a_sps30_sim_iic_prepare(sps30_sim_t *sim, const uint8_t *data, uint8_t len)
+{
+    uint8_t i;
+    
+    for (i = 0; i < len / 2; i++)                                              /* all words */
+    {
+        sim->iic_buf[i * 3 + 0] = data[i * 2 + 0];                             /* set msb */
+        sim->iic_buf[i * 3 + 1] = data[i * 2 + 1];                             /* set lsb */
+        sim->iic_buf[i * 3 + 2] = a_sps30_sim_crc(&data[i * 2], 2);            /* set crc */
+    }
+    sim->iic_len = (uint8_t)(len / 2 * 3);                                     /* save the length */
+}
+
+uint8_t sps30_sim_init(sps30_sim_t *sim)
+{
+    const float value[10] = {1.5f, 3.0f, 4.0f, 4.5f, 10.0f, 12.0f, 12.5f, 12.6f, 12.7f, 0.5f};
+    
+    if (sim == NULL)                                                           /* check sim */
+    {
+        return 2;                                                              /* return error */
+    }
+    
+    memset(sim, 0, sizeof(sps30_sim_t));                                       /* clear the sim */
+    sim->state = SPS30_SIM_STATE_IDLE;                                         /* power on in idle */
+    sim->format = SPS30_FORMAT_IEEE754;                                        /* default format */
+    sim->auto_cleaning_interval = 604800;                                      /* one week */
+    memcpy(sim->value, value, sizeof(value));                                  /* default values */
+    strcpy(sim->product_type, "00080000");                                     /* product type */
+    strcpy(sim->serial_number, "SIM0000000000000");                            /* serial number */
+    sim->version[0] = 2;                                                       /* firmware major */
+    sim->version[1] = 2;                                                       /* firmware minor */
+    sim->clock.now_ms = sps30_sim_now_ms;                                      /* set the clock time */
+    sim->clock.delay_ms = sps30_sim_delay_ms;                                  /* set the clock delay ms */
+    sim->clock.delay_us = sps30_sim_delay_us;                                  /* set the clock delay us */
+    sim->clock.user = sim;                                                     /* set the clock user */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+uint8_t sps30_sim_link(sps30_handle_t *handle, sps30_sim_t *sim)
+{
+    if ((handle == NULL) || (sim == NULL))                                     /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    
+#if (SPS30_ENABLE_IIC == 1)
+    DRIVER_SPS30_LINK_IIC_INIT_CTX(handle, sps30_sim_iic_init);
+    DRIVER_SPS30_LINK_IIC_DEINIT_CTX(handle, sps30_sim_iic_deinit);
+    DRIVER_SPS30_LINK_IIC_WRITE_COMMAND_CTX(handle, sps30_sim_iic_write_cmd);
+    DRIVER_SPS30_LINK_IIC_READ_COMMAND_CTX(handle, sps30_sim_iic_read_cmd);
+#endif
+#if (SPS30_ENABLE_UART == 1)
+    DRIVER_SPS30_LINK_UART_INIT_CTX(handle, sps30_sim_uart_init);
+    DRIVER_SPS30_LINK_UART_DEINIT_CTX(handle, sps30_sim_uart_deinit);
+    DRIVER_SPS30_LINK_UART_READ_CTX(handle, sps30_sim_uart_read);
+    DRIVER_SPS30_LINK_UART_WRITE_CTX(handle, sps30_sim_uart_write);
+    DRIVER_SPS30_LINK_UART_FLUSH_CTX(handle, sps30_sim_uart_flush);
+#endif
+    DRIVER_SPS30_LINK_DELAY_MS_CTX(handle, sps30_sim_delay_ms);
+    DRIVER_SPS30_LINK_DELAY_US_CTX(handle, sps30_sim_delay_us);
+#if (SPS30_ENABLE_TRACE == 1) || (SPS30_ENABLE_STATS == 1)
+    DRIVER_SPS30_LINK_NOW_US_CTX(handle, sps30_sim_now_us);
+#endif
+    DRIVER_SPS30_LINK_USER_DATA(handle, sim);
+    
+#if (SPS30_STATIC_PORT == 1)
+    return 1;                                                                  /* the static port keeps its own functions */
+#else
+    return 0;                                                                  /* success return 0 */
+#endif
+}
+
+void sps30_sim_advance(sps30_sim_t *sim, uint32_t ms)
+{
+    sim->now_us += (uint64_t)ms * 1000;                                        /* advance the time */
+}
+
+uint32_t sps30_sim_now_ms(void *user)
+{
+    return (uint32_t)(((sps30_sim_t *)user)->now_us / 1000);                   /* return the time */
+}
+
+uint32_t sps30_sim_now_us(void *user)
+{
+    return (uint32_t)(((sps30_sim_t *)user)->now_us);                          /* return the time */
+}
+
+void sps30_sim_quiet_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+uint8_t sps30_sim_iic_init(void *user)
+{
+    (void)user;
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+uint8_t sps30_sim_iic_deinit(void *user)
+{
+    (void)user;
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+uint8_t sps30_sim_iic_write_cmd(void *user, uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    sps30_sim_t *sim = (sps30_sim_t *)user;
+    uint8_t data[60];
+    uint16_t cmd;
+    uint16_t i;
+    uint32_t index;
+    
+    if ((addr != SPS30_SIM_ADDRESS) || (len < 2) || ((len - 2) % 3 != 0))     /* check the transfer */
+    {
+        return 1;                                                              /* nack */
+    }
+    if ((sim->state == SPS30_SIM_STATE_SLEEP) && (sim->wake == 0))             /* interface is off */
+    {
+        sim->wake = 1;                                                         /* the first transfer wakes it */
+        
+        return 1;                                                              /* nack */
+    }
+    for (i = 0; i < (len - 2) / 3; i++)                                        /* check all words */
+    {
+        if (buf[2 + i * 3 + 2] != a_sps30_sim_crc(&buf[2 + i * 3], 2))         /* check crc */
+        {
+            return 1;                                                          /* nack */
+        }
+    }
+    cmd = (uint16_t)((uint16_t)buf[0] << 8 | buf[1]);                          /* get the command */
+    if ((sim->state == SPS30_SIM_STATE_SLEEP) && (cmd != 0x1103))              /* only wake up in the sleep mode */
+    {
+        return 1;                                                              /* nack */
+    }
+    sim->iic_len = 0;                                                          /* clear the prepared data */
+    sim->command_us = sim->now_us;                                             /* save the command time */
+    switch (cmd)
+    {
+        case 0x0010 :                                                          /* start measurement */
+        {
+            if ((len != 5) || (sim->state != SPS30_SIM_STATE_IDLE) ||
+                ((buf[2] != SPS30_FORMAT_IEEE754) && (buf[2] != SPS30_FORMAT_UINT16)))
+            {
+                return 1;
+            }
+            sim->format = buf[2];                                              /* save the format */
+            sim->state = SPS30_SIM_STATE_MEASUREMENT;                          /* start measuring */
+            sim->start_us = sim->now_us;                                       /* save the start time */
+            sim->sample = 0;                                                   /* no sample yet */
+            
+            return 0;
+        }
+        case 0x0104 :                                                          /* stop measurement */
+        {
+            if (sim->state != SPS30_SIM_STATE_MEASUREMENT)
+            {
+                return 1;
+            }
+            sim->state = SPS30_SIM_STATE_IDLE;                                 /* stop measuring */
+            
+            return 0;
+        }
+        case 0x0202 :                                                          /* read data ready flag */
+        {
+            data[0] = 0x00;
+            data[1] = (a_sps30_sim_index(sim) > sim->sample) ? 1 : 0;          /* new sample flag */
+            a_sps30_sim_iic_prepare(sim, data, 2);
+            
+            return 0;
+        }
+        case 0x0300 :                                                          /* read measured values */
+        {
+            if (sim->state != SPS30_SIM_STATE_MEASUREMENT)
+            {
+                return 1;
+            }
+            index = a_sps30_sim_index(sim);                                    /* get the sample */
+            sim->sample = index;                                               /* mark it read */
+            a_sps30_sim_iic_prepare(sim, data, (uint8_t)a_sps30_sim_values(sim, data));
+            
+            return 0;
+        }
+        case 0x1001 :                                                          /* sleep */
+        {
+            if (sim->state != SPS30_SIM_STATE_IDLE)
+            {
+                return 1;
+            }
+            sim->state = SPS30_SIM_STATE_SLEEP;                                /* sleep */
+            sim->wake = 0;                                                     /* interface is off */
+            
+            return 0;
+        }
+        case 0x1103 :                                                          /* wake up */
+        {
+            if (sim->state != SPS30_SIM_STATE_SLEEP)
+            {
+                return 1;
+            }
+            sim->state = SPS30_SIM_STATE_IDLE;                                 /* back to idle */
+            
+            return 0;
+        }
+        case 0x5607 :                                                          /* start fan cleaning */
+        {
+            if (sim->state != SPS30_SIM_STATE_MEASUREMENT)
+            {
+                return 1;
+            }
+            sim->cleaning_us = sim->now_us + SPS30_SIM_CLEANING_US;            /* clean for 10 s */
+            
+            return 0;
+        }
+        case 0x8004 :                                                          /* read write auto cleaning interval */
+        {
+            if (len == 8)                                                      /* write */
+            {
+                sim->auto_cleaning_interval = (uint32_t)buf[2] << 24 | (uint32_t)buf[3] << 16 |
+                                              (uint32_t)buf[5] << 8 | (uint32_t)buf[6] << 0;
+                
+                return 0;
+            }
+            if (len != 2)
+            {
+                return 1;
+            }
+            data[0] = (uint8_t)(sim->auto_cleaning_interval >> 24);
+            data[1] = (uint8_t)(sim->auto_cleaning_interval >> 16);
+            data[2] = (uint8_t)(sim->auto_cleaning_interval >> 8);
+            data[3] = (uint8_t)(sim->auto_cleaning_interval >> 0);
+            a_sps30_sim_iic_prepare(sim, data, 4);
+            
+            return 0;
+        }
+        case 0xD002 :                                                          /* read product type */
+        {
+            memset(data, 0, 32);
+            memcpy(data, sim->product_type, 8);
+            a_sps30_sim_iic_prepare(sim, data, 32);
+            
+            return 0;
+        }
+        case 0xD033 :                                                          /* read serial number */
+        {
+            memset(data, 0, 32);
+            memcpy(data, sim->serial_number, 16);
+            a_sps30_sim_iic_prepare(sim, data, 32);
+            
+            return 0;
+        }
+        case 0xD100 :                                                          /* read version */
+        {
+            a_sps30_sim_iic_prepare(sim, sim->version, 2);
+            
+            return 0;
+        }
+        case 0xD206 :                                                          /* read device status register */
+        {
+            data[0] = (uint8_t)(sim->status >> 24);
+            data[1] = (uint8_t)(sim->status >> 16);
+            data[2] = (uint8_t)(sim->status >> 8);
+            data[3] = (uint8_t)(sim->status >> 0);
+            a_sps30_sim_iic_prepare(sim, data, 4);
+            
+            return 0;
+        }
+        case 0xD210 :                                                          /* clear device status register */
+        {
+            sim->status = 0;                                                   /* clear the status */
+            
+            return 0;
+        }
+        case 0xD304 :                                                          /* reset */
+        {
+            sim->state = SPS30_SIM_STATE_IDLE;                                 /* back to idle */
+            
+            return 0;
+        }
+        default :
+        {
+            return 1;                                                          /* unknown command */
+        }
+    }
+}
+
+uint8_t sps30_sim_iic_read_cmd(void *user, uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    sps30_sim_t *sim = (sps30_sim_t *)user;
+    
+    if ((addr != SPS30_SIM_ADDRESS) || (sim->iic_len == 0))                    /* nothing to read */
+    {
+        return 1;                                                              /* nack */
+    }
+    if ((sim->now_us - sim->command_us) < sim->response_us)                    /* still processing */
+    {
+        return 1;                                                              /* nack */
+    }
+    if (len > sim->iic_len)                                                    /* read past the data */
+    {
+        memset(buf, 0xFF, len);                                                /* the bus reads high */
+        memcpy(buf, sim->iic_buf, sim->iic_len);                               /* copy the data */
+    }
+    else
+    {
+        memcpy(buf, sim->iic_buf, len);                                        /* copy the data */
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+uint8_t sps30_sim_uart_init(void *user)
+{
+    (void)user;
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+uint8_t sps30_sim_uart_deinit(void *user)
+{
+    (void)user;
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+uint16_t sps30_sim_uart_read(void *user, uint8_t *buf, uint16_t len)
+{
+    sps30_sim_t *sim = (sps30_sim_t *)user;
+    uint16_t n;
+    
+    if ((sim->now_us - sim->command_us) < sim->response_us)                    /* still processing */
+    {
+        return 0;                                                              /* no response yet */
+    }
+    n = sim->tx_len - sim->tx_point;                                           /* get the pending length */
+    n = (n > len) ? len : n;                                                   /* limit the length */
+    memcpy(buf, &sim->tx_buf[sim->tx_point], n);                               /* copy the data */
+    sim->tx_point += n;                                                        /* move the point */
+    if (sim->tx_point == sim->tx_len)                                          /* all read */
+    {
+        sim->tx_point = 0;                                                     /* reset the point */
+        sim->tx_len = 0;                                                       /* reset the length */
+    }
+    
+    return n;                                                                  /* return the length */
+}
+
+uint8_t sps30_sim_uart_flush(void *user)
+{
+    sps30_sim_t *sim = (sps30_sim_t *)user;
+    
+    sim->tx_point = 0;                                                         /* drop the responses */
+    sim->tx_len = 0;                                                           /* drop the responses */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+uint8_t sps30_sim_uart_write(void *user, uint8_t *buf, uint16_t len)
+{
+    sps30_sim_t *sim = (sps30_sim_t *)user;
+    uint8_t sum;
+    uint8_t c;
+    uint16_t i;
+    uint16_t j;
+    
+    for (i = 0; i < len; i++)                                                  /* parse all bytes */
+    {
+        c = buf[i];                                                            /* get the byte */
+        if ((sim->state == SPS30_SIM_STATE_SLEEP) && (sim->wake == 0))         /* interface is off */
+        {
+            sim->wake = (c == 0xFF) ? 1 : 0;                                   /* a 0xFF byte wakes it */
+            
+            continue;                                                          /* drop the byte */
+        }
+        if (c == 0x7E)                                                         /* delimiter */
+        {
+            if ((sim->rx_frame != 0) && (sim->rx_len != 0))                    /* stop delimiter */
+            {
+                sim->rx_frame = 0;                                             /* frame done */
+                sim->command_us = sim->now_us;                                 /* save the command time */
+                sum = 0;                                                       /* init 0 */
+                for (j = 0; j < sim->rx_len; j++)                              /* sum all bytes */
+                {
+                    sum = (uint8_t)(sum + sim->rx_buf[j]);                     /* add the byte */
+                }
+                if ((sim->rx_len < 4) || (sum != 0xFF) ||
+                    (sim->rx_buf[2] != sim->rx_len - 4) || (sim->rx_buf[0] != 0x00))   /* check the frame */
+                {
+                    continue;                                                  /* a bad frame is not answered */
+                }
+                if ((sim->state == SPS30_SIM_STATE_SLEEP) && (sim->rx_buf[1] != 0x11))    /* only wake up */
+                {
+                    a_sps30_sim_respond(sim, sim->rx_buf[1], SPS30_SIM_ERROR_STATE, NULL, 0);
+                    
+                    continue;                                                  /* next byte */
+                }
+                a_sps30_sim_shdlc(sim, sim->rx_buf[1], &sim->rx_buf[3], sim->rx_buf[2]);    /* run the command */
+            }
+            else
+            {
+                sim->rx_frame = 1;                                             /* start delimiter */
+                sim->rx_len = 0;                                               /* clear the frame */
+                sim->rx_escape = 0;                                            /* clear the escape */
+            }
+            
+            continue;                                                          /* next byte */
+        }
+        if (sim->rx_frame == 0)                                                /* outside a frame */
+        {
+            continue;                                                          /* drop the byte */
+        }
+        if (c == 0x7D)                                                         /* escape */
+        {
+            sim->rx_escape = 1;                                                /* flag the escape */
+            
+            continue;                                                          /* next byte */
+        }
+        if (sim->rx_escape != 0)                                               /* escaped byte */
+        {
+            c ^= 0x20;                                                         /* flip bit 5 */
+            sim->rx_escape = 0;                                                /* clear the escape */
+        }
+        if (sim->rx_len < SPS30_SIM_BUFFER_SIZE)                               /* check the space */
+        {
+            sim->rx_buf[sim->rx_len++] = c;                                    /* save the byte */
+        }
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+void sps30_sim_delay_ms(void *user, uint32_t ms)
+{
+    sps30_sim_advance((sps30_sim_t *)user, ms);                                /* advance the time */
+}
+
+void sps30_sim_delay_us(void *user, uint32_t us)
+{
+    ((sps30_sim_t *)user)->now_us += us;                                       /* advance the time */
+}
@@ -0,0 +1,273 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_sps30_sim.h
+ * @brief     driver sps30 simulator header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_SPS30_SIM_H
+#define DRIVER_SPS30_SIM_H
+
+#include "driver_sps30.h"
+#include "driver_sps30_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup sps30_sim_driver sps30 simulator function
+ * @brief    sps30 software model behind the linked interface functions
+ * @ingroup  sps30_test_driver
+ * @{
+ */
+
+/**
+ * @brief sps30 simulator buffer size definition
+ */
+#define SPS30_SIM_BUFFER_SIZE    256        /**< uart buffer size */
+
+/**
+ * @brief sps30 simulator state enumeration definition
+ */
+typedef enum
+{
+    SPS30_SIM_STATE_IDLE        = 0x00,        /**< idle mode */
+    SPS30_SIM_STATE_MEASUREMENT = 0x01,        /**< measurement mode */
+    SPS30_SIM_STATE_SLEEP       = 0x02,        /**< sleep mode */
+} sps30_sim_state_t;
+
+/**
+ * @brief sps30 simulator structure definition
+ */
+typedef struct sps30_sim_s
+{
+    uint8_t state;                              /**< sps30_sim_state_t */
+    uint8_t format;                             /**< measured values format */
+    uint8_t wake;                               /**< interface woken in the sleep mode */
+    uint8_t rx_escape;                          /**< uart escape flag */
+    uint8_t rx_frame;                           /**< uart in frame flag */
+    uint8_t iic_len;                            /**< iic prepared read length */
+    uint16_t rx_len;                            /**< uart received length */
+    uint16_t tx_len;                            /**< uart response length */
+    uint16_t tx_point;                          /**< uart response read point */
+    uint32_t auto_cleaning_interval;            /**< auto cleaning interval in s */
+    uint32_t status;                            /**< device status register */
+    uint32_t sample;                            /**< last read sample index */
+    uint64_t now_us;                            /**< virtual time in us */
+    uint64_t start_us;                          /**< measurement start time in us */
+    uint64_t cleaning_us;                       /**< fan cleaning end time in us */
+    uint64_t command_us;                        /**< last command time in us */
+    uint32_t response_us;                       /**< command processing time in us, 0 answers at once */
+    float value[10];                            /**< measured values in the sps30_pm_t order */
+    char product_type[9];                       /**< product type */
+    char serial_number[17];                     /**< serial number */
+    uint8_t version[2];                         /**< firmware major and minor */
+    uint8_t iic_buf[60];                        /**< iic prepared read data */
+    uint8_t rx_buf[SPS30_SIM_BUFFER_SIZE];      /**< uart received frame */
+    uint8_t tx_buf[SPS30_SIM_BUFFER_SIZE];      /**< uart response frames */
+    sps30_interface_clock_t clock;              /**< interface time source on the virtual time */
+} sps30_sim_t;
+
+/**
+ * @brief     initialize the simulator to the power on state
+ * @param[in] *sim pointer to a simulator structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 sim is NULL
+ * @note      the measured values, the product type, the serial number, the version
+ *            and the status may be changed after it, the clock member is set up for
+ *            sps30_interface_set_clock
+ */
+uint8_t sps30_sim_init(sps30_sim_t *sim);
+
+/**
+ * @brief     link the simulator to a handle
+ * @param[in] *handle pointer to an sps30 handle structure
+ * @param[in] *sim pointer to a simulator structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 static port is enabled
+ *            - 2 handle or sim is NULL
+ * @note      links the ctx bus and delay functions and the user context,
+ *            the debug_print function is left to the caller
+ */
+uint8_t sps30_sim_link(sps30_handle_t *handle, sps30_sim_t *sim);
+
+/**
+ * @brief     advance the virtual time
+ * @param[in] *sim pointer to a simulator structure
+ * @param[in] ms time
+ * @note      the linked delay functions advance it too, nothing sleeps
+ */
+void sps30_sim_advance(sps30_sim_t *sim, uint32_t ms);
+
+/**
+ * @brief     get the virtual time
+ * @param[in] *user pointer to a simulator structure
+ * @return    virtual time in ms
+ * @note      pairs with sps30_sim_delay_ms and sps30_sim_delay_us as a time source
+ */
+uint32_t sps30_sim_now_ms(void *user);
+
+/**
+ * @brief     get the virtual time in us
+ * @param[in] *user pointer to a simulator structure
+ * @return    virtual time in us
+ * @note      linked as the now_us_ctx function of the driver
+ */
+uint32_t sps30_sim_now_us(void *user);
+
+/**
+ * @brief     quiet print
+ * @param[in] fmt format data
+ * @note      linked as the debug_print function when the driver is made to fail on purpose
+ */
+void sps30_sim_quiet_print(const char *const fmt, ...);
+
+/**
+ * @brief     simulator iic init
+ * @param[in] *user pointer to a simulator structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t sps30_sim_iic_init(void *user);
+
+/**
+ * @brief     simulator iic deinit
+ * @param[in] *user pointer to a simulator structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t sps30_sim_iic_deinit(void *user);
+
+/**
+ * @brief     simulator iic write command
+ * @param[in] *user pointer to a simulator structure
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 nack
+ * @note      a wrong address, crc, command or state is a nack
+ */
+uint8_t sps30_sim_iic_write_cmd(void *user, uint8_t addr, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      simulator iic read command
+ * @param[in]  *user pointer to a simulator structure
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 nack
+ * @note       the bytes after the prepared data read as 0xFF
+ */
+uint8_t sps30_sim_iic_read_cmd(void *user, uint8_t addr, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     simulator uart init
+ * @param[in] *user pointer to a simulator structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t sps30_sim_uart_init(void *user);
+
+/**
+ * @brief     simulator uart deinit
+ * @param[in] *user pointer to a simulator structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t sps30_sim_uart_deinit(void *user);
+
+/**
+ * @brief      simulator uart read
+ * @param[in]  *user pointer to a simulator structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     read length
+ * @note       none
+ */
+uint16_t sps30_sim_uart_read(void *user, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     simulator uart flush
+ * @param[in] *user pointer to a simulator structure
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t sps30_sim_uart_flush(void *user);
+
+/**
+ * @brief     simulator uart write
+ * @param[in] *user pointer to a simulator structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ * @note      every complete shdlc frame is answered at once
+ */
+uint8_t sps30_sim_uart_write(void *user, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     simulator delay ms
+ * @param[in] *user pointer to a simulator structure
+ * @param[in] ms time
+ * @note      none
+ */
+void sps30_sim_delay_ms(void *user, uint32_t ms);
+
+/**
+ * @brief     simulator delay us
+ * @param[in] *user pointer to a simulator structure
+ * @param[in] us time
+ * @note      none
+ */
+void sps30_sim_delay_us(void *user, uint32_t us);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
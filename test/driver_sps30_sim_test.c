@@ -0,0 +1,579 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_sps30_sim_test.c
+ * @brief     driver sps30 simulator test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_sps30_sim_test.h"
+#include "driver_sps30_sim.h"
+#include <string.h>
+
+static sps30_handle_t gs_handle;        /**< sps30 handle */
+static sps30_sim_t gs_sim;              /**< sps30 simulator */
+
+#if (SPS30_ENABLE_FLOAT == 1)
+/**
+ * @brief     check the float measured values against the simulator
+ * @param[in] *pm pointer to an sps30 pm structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_sps30_sim_test_check(sps30_pm_t *pm)
+{
+    const float value[10] = {pm->pm1p0_ug_m3, pm->pm2p5_ug_m3, pm->pm4p0_ug_m3, pm->pm10_ug_m3,
+                             pm->pm0p5_cm3, pm->pm1p0_cm3, pm->pm2p5_cm3, pm->pm4p0_cm3, pm->pm10_cm3,
+                             pm->typical_particle_um};
+    
+    return (memcmp(value, gs_sim.value, sizeof(value)) == 0) ? 0 : 1;
+}
+#endif
+
+/**
+ * @brief     check the uint16 measured values against the simulator
+ * @param[in] *pm pointer to an sps30 pm u16 structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_sps30_sim_test_check_u16(sps30_pm_u16_t *pm)
+{
+    const uint16_t value[10] = {pm->pm1p0_ug_m3, pm->pm2p5_ug_m3, pm->pm4p0_ug_m3, pm->pm10_ug_m3,
+                                pm->pm0p5_cm3, pm->pm1p0_cm3, pm->pm2p5_cm3, pm->pm4p0_cm3, pm->pm10_cm3,
+                                pm->typical_particle_nm};
+    uint8_t i;
+    
+    for (i = 0; i < 10; i++)
+    {
+        if (value[i] != (uint16_t)(gs_sim.value[i] * ((i == 9) ? 1000.0f : 1.0f) + 0.5f))
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      run an async command against the simulator
+ * @param[in]  command async command
+ * @param[out] *result pointer to a result buffer
+ * @param[out] *str pointer to a string buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 check failed
+ * @note       the sync commands and the mode setters must be refused while the command is pending
+ */
+static uint8_t a_sps30_sim_test_async(sps30_async_command_t command, uint32_t *result, char str[17])
+{
+    uint8_t res;
+    char sn[17];
+    
+    if (sps30_async_begin(&gs_handle, command, 0, sps30_interface_now_ms()) != 0)
+    {
+        return 1;
+    }
+    if ((sps30_get_serial_number(&gs_handle, sn) != 5) ||
+        (sps30_set_read_mode(&gs_handle, SPS30_READ_MODE_DIRECT) != 5) ||
+        (sps30_read_begin(&gs_handle, sps30_interface_now_ms()) != 5) ||
+        (sps30_async_begin(&gs_handle, command, 0, sps30_interface_now_ms()) != 5))
+    {
+        return 1;
+    }
+    do
+    {
+        sps30_interface_delay_ms(1);
+        if ((command == SPS30_ASYNC_COMMAND_GET_PRODUCT_TYPE) || (command == SPS30_ASYNC_COMMAND_GET_SERIAL_NUMBER))
+        {
+            res = sps30_async_poll_string(&gs_handle, sps30_interface_now_ms(), str);
+        }
+        else
+        {
+            res = sps30_async_poll(&gs_handle, sps30_interface_now_ms(), result);
+        }
+    } while (res == 5);
+    
+    return res;
+}
+
+#if (SPS30_ENABLE_UART == 1)
+/**
+ * @brief     feed a serial number response to the frame parser
+ * @param[in] mode 0 byte by byte, 1 split after an escape, 2 noise prefix,
+ *            3 corrupted frame before the good one, 4 corrupted frame alone
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the simulator serial number carries a 0x7D and a 0x7E byte, so the frame has escapes,
+ *            a corrupted frame alone must fail the pending command at once
+ */
+static uint8_t a_sps30_sim_test_feed(uint8_t mode)
+{
+    const uint8_t noise[4] = {0x00, 0x13, 0x7D, 0xFF};
+    uint8_t frame[64];
+    uint8_t chunk[136];
+    uint16_t len;
+    uint16_t i;
+    uint8_t res;
+    char sn[17];
+    
+    if (sps30_async_begin(&gs_handle, SPS30_ASYNC_COMMAND_GET_SERIAL_NUMBER, 0, sps30_interface_now_ms()) != 0)
+    {
+        return 1;
+    }
+    sps30_interface_delay_ms(1);
+    len = sps30_sim_uart_read(&gs_sim, frame, 64);
+    if ((len < 8) || (len == 64))
+    {
+        return 1;
+    }
+    if (mode == 0)
+    {
+        for (i = 0; i < len; i++)
+        {
+            res = sps30_shdlc_feed(&gs_handle, &frame[i], 1);
+            if ((res != ((i == (len - 1)) ? 4 : 0)) ||
+                ((i < (len - 1)) && (sps30_async_poll_string(&gs_handle, sps30_interface_now_ms(), sn) != 5)))
+            {
+                return 1;
+            }
+        }
+    }
+    else if (mode == 1)
+    {
+        for (i = 1; (i < len) && (frame[i] != 0x7D); i++)
+        {
+            
+        }
+        if ((i == len) || (sps30_shdlc_feed(&gs_handle, frame, i + 1) != 0) ||
+            (sps30_async_poll_string(&gs_handle, sps30_interface_now_ms(), sn) != 5) ||
+            (sps30_shdlc_feed(&gs_handle, &frame[i + 1], len - i - 1) != 4))
+        {
+            return 1;
+        }
+    }
+    else if (mode == 2)
+    {
+        memcpy(chunk, noise, 4);
+        memcpy(&chunk[4], frame, len);
+        if (sps30_shdlc_feed(&gs_handle, chunk, 4 + len) != 4)
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        memcpy(chunk, frame, len);
+        chunk[len - 3] ^= 0x01;
+        memcpy(&chunk[len], frame, len);
+        res = sps30_shdlc_feed(&gs_handle, chunk, (mode == 3) ? (2 * len) : len);
+        if (mode == 4)
+        {
+            return ((res == 1) && (sps30_async_poll_string(&gs_handle, sps30_interface_now_ms(), sn) == 1)) ? 0 : 1;
+        }
+        if (res != 4)
+        {
+            return 1;
+        }
+    }
+    if ((sps30_async_poll_string(&gs_handle, sps30_interface_now_ms(), sn) != 0) || (strcmp(sn, gs_sim.serial_number) != 0))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+#endif
+
+/**
+ * @brief     run the simulator test
+ * @param[in] interface chip interface
+ * @param[in] times test times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+static uint8_t a_sps30_sim_test_run(sps30_interface_t interface, uint32_t times)
+{
+    uint8_t res;
+    uint8_t major;
+    uint8_t minor;
+    uint32_t i;
+    uint32_t second;
+    uint32_t now;
+    uint32_t status;
+    char type[9];
+    char sn[17];
+#if (SPS30_ENABLE_FLOAT == 1)
+    sps30_data_ready_flag_t flag;
+    sps30_pm_t pm;
+#endif
+    sps30_pm_u16_t pm_u16;
+    sps30_raw_sample_t raw;
+    
+    /* start sim test */
+    sps30_interface_debug_print("sps30: start sim test.\n");
+    
+    /* link the simulator */
+    (void)sps30_sim_init(&gs_sim);
+    DRIVER_SPS30_LINK_INIT(&gs_handle, sps30_handle_t);
+    res = sps30_sim_link(&gs_handle, &gs_sim);
+    if (res != 0)
+    {
+        sps30_interface_debug_print("sps30: sim link failed.\n");
+        
+        return 1;
+    }
+    DRIVER_SPS30_LINK_DEBUG_PRINT(&gs_handle, sps30_interface_debug_print);
+    
+    /* set the interface */
+    res = sps30_set_interface(&gs_handle, interface);
+    if (res != 0)
+    {
+        sps30_interface_debug_print("sps30: set interface failed.\n");
+    
+        return 1;
+    }
+    
+    /* init the chip */
+    res = sps30_init(&gs_handle);
+    if (res != 0)
+    {
+        sps30_interface_debug_print("sps30: init failed.\n");
+    
+        return 1;
+    }
+    
+    /* check the device information */
+    if ((sps30_get_product_type(&gs_handle, type) != 0) || (strcmp(type, gs_sim.product_type) != 0) ||
+        (sps30_get_serial_number(&gs_handle, sn) != 0) || (strcmp(sn, gs_sim.serial_number) != 0) ||
+        (sps30_get_version(&gs_handle, &major, &minor) != 0) || (major != gs_sim.version[0]) || (minor != gs_sim.version[1]))
+    {
+        sps30_interface_debug_print("sps30: check device information failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sps30_interface_debug_print("sps30: check device information passed.\n");
+    
+    /* check the async commands */
+    gs_sim.status = 1UL << 4;
+    if ((a_sps30_sim_test_async(SPS30_ASYNC_COMMAND_GET_DEVICE_STATUS, &status, sn) != 0) || (status != (1UL << 4)) ||
+        (a_sps30_sim_test_async(SPS30_ASYNC_COMMAND_GET_PRODUCT_TYPE, &status, sn) != 0) || (strcmp(sn, gs_sim.product_type) != 0) ||
+        (a_sps30_sim_test_async(SPS30_ASYNC_COMMAND_GET_SERIAL_NUMBER, &status, sn) != 0) || (strcmp(sn, gs_sim.serial_number) != 0))
+    {
+        sps30_interface_debug_print("sps30: check async commands failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    gs_sim.status = 0;
+    sps30_interface_debug_print("sps30: check async commands passed.\n");
+    
+#if (SPS30_ENABLE_UART == 1)
+    /* check the feed parser */
+    if (interface == SPS30_INTERFACE_UART)
+    {
+        strcpy(gs_sim.serial_number, "SIM}~00000000000");
+        if ((sps30_set_uart_receive_mode(&gs_handle, SPS30_UART_RECEIVE_MODE_FEED) != 0) ||
+            (a_sps30_sim_test_feed(0) != 0) || (a_sps30_sim_test_feed(1) != 0) || (a_sps30_sim_test_feed(2) != 0) ||
+            (a_sps30_sim_test_feed(3) != 0) || (a_sps30_sim_test_feed(4) != 0) ||
+            (sps30_set_uart_receive_mode(&gs_handle, SPS30_UART_RECEIVE_MODE_DELAY) != 0))
+        {
+            sps30_interface_debug_print("sps30: check feed parser failed.\n");
+            (void)sps30_deinit(&gs_handle);
+            
+            return 1;
+        }
+        strcpy(gs_sim.serial_number, "SIM0000000000000");
+        sps30_interface_debug_print("sps30: check feed parser passed.\n");
+    }
+    
+#endif
+    
+    /* check the auto cleaning interval */
+    if ((sps30_set_auto_cleaning_interval(&gs_handle, 3600 * 24) != 0) ||
+        (sps30_get_auto_cleaning_interval(&gs_handle, &second) != 0) || (second != 3600 * 24))
+    {
+        sps30_interface_debug_print("sps30: check auto cleaning interval failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sps30_interface_debug_print("sps30: check auto cleaning interval passed.\n");
+    
+    /* check the timing table and the auto tune against a 4 ms response, the probes fail on purpose */
+    gs_sim.response_us = 4000;
+    DRIVER_SPS30_LINK_DEBUG_PRINT(&gs_handle, sps30_sim_quiet_print);
+    if ((sps30_set_timing(&gs_handle, SPS30_TIMING_MAX, 1000) != 4) ||
+        (sps30_set_timing(&gs_handle, SPS30_TIMING_VERSION, 3000) != 0) ||
+        (sps30_get_timing(&gs_handle, SPS30_TIMING_VERSION, &second) != 0) || (second != 3000) ||
+        (sps30_get_version(&gs_handle, &major, &minor) == 0) ||
+        (sps30_auto_tune_timing(&gs_handle, SPS30_TIMING_VERSION, 100, &second) != 0) ||
+        (second < 5000) || (second >= 5125) ||
+        (sps30_get_timing(&gs_handle, SPS30_TIMING_VERSION, &status) != 0) || (status != second) ||
+        (sps30_get_version(&gs_handle, &major, &minor) != 0) ||
+        (sps30_auto_tune_timing(&gs_handle, SPS30_TIMING_VERSION, 2000, &second) != 0) ||
+        (second < 6000) || (second >= 8000))
+    {
+        DRIVER_SPS30_LINK_DEBUG_PRINT(&gs_handle, sps30_interface_debug_print);
+        sps30_interface_debug_print("sps30: check auto tune failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the guard band stops at the datasheet timing */
+    gs_sim.response_us = 19000;
+    if ((sps30_auto_tune_timing(&gs_handle, SPS30_TIMING_VERSION, 100, &second) != 0) || (second != 20000))
+    {
+        DRIVER_SPS30_LINK_DEBUG_PRINT(&gs_handle, sps30_interface_debug_print);
+        sps30_interface_debug_print("sps30: check auto tune failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    gs_sim.response_us = 0;
+    DRIVER_SPS30_LINK_DEBUG_PRINT(&gs_handle, sps30_interface_debug_print);
+    sps30_interface_debug_print("sps30: check auto tune passed.\n");
+    
+#if (SPS30_ENABLE_FLOAT == 1)
+    /* IEEE754 read test */
+    res = sps30_start_measurement(&gs_handle, SPS30_FORMAT_IEEE754);
+#else
+    /* start measurement for the fan cleaning, the float-less build has no IEEE754 read test */
+    res = sps30_start_measurement(&gs_handle, SPS30_FORMAT_UINT16);
+#endif
+    if (res != 0)
+    {
+        sps30_interface_debug_print("sps30: start measurement failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+#if (SPS30_ENABLE_FLOAT == 1)
+    for (i = 0; i < times; i++)
+    {
+        /* go 100 ms past the next sample, so no new sample lands before the flag check */
+        sps30_interface_delay_ms(1100 - (sps30_interface_now_ms() - (uint32_t)(gs_sim.start_us / 1000)) % 1000);
+        if ((interface == SPS30_INTERFACE_IIC) &&
+            ((sps30_read_data_flag(&gs_handle, &flag) != 0) || (flag != SPS30_DATA_READY_FLAG_AVAILABLE)))
+        {
+            sps30_interface_debug_print("sps30: check data ready flag failed.\n");
+            (void)sps30_deinit(&gs_handle);
+            
+            return 1;
+        }
+        gs_sim.value[0] = 1.0f + (float)(i % 100);
+        if ((sps30_read(&gs_handle, &pm) != 0) || (a_sps30_sim_test_check(&pm) != 0))
+        {
+            sps30_interface_debug_print("sps30: IEEE754 read failed.\n");
+            (void)sps30_deinit(&gs_handle);
+            
+            return 1;
+        }
+        if ((interface == SPS30_INTERFACE_IIC) &&
+            ((sps30_read_data_flag(&gs_handle, &flag) != 0) || (flag != SPS30_DATA_READY_FLAG_NOT_READY)))
+        {
+            sps30_interface_debug_print("sps30: check data ready flag failed.\n");
+            (void)sps30_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    
+    /* the read mode can't change under a pending read */
+    sps30_interface_delay_ms(1000);
+    gs_sim.value[0] = 2.5f;
+    if ((sps30_read_begin(&gs_handle, sps30_interface_now_ms()) != 0) ||
+        (sps30_set_read_mode(&gs_handle, SPS30_READ_MODE_DIRECT) != 5))
+    {
+        sps30_interface_debug_print("sps30: IEEE754 async read failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    do
+    {
+        sps30_interface_delay_ms(1);
+        res = sps30_read_poll(&gs_handle, sps30_interface_now_ms(), &pm);
+    } while (res == 5);
+    if ((res != 0) || (a_sps30_sim_test_check(&pm) != 0))
+    {
+        sps30_interface_debug_print("sps30: IEEE754 async read failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sps30_interface_debug_print("sps30: IEEE754 read test passed.\n");
+#endif
+    
+    /* start fan cleaning */
+    res = sps30_start_fan_cleaning(&gs_handle);
+    if (res != 0)
+    {
+        sps30_interface_debug_print("sps30: start fan cleaning failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sps30_interface_delay_ms(10000);
+    
+    /* stop measurement */
+    res = sps30_stop_measurement(&gs_handle);
+    if (res != 0)
+    {
+        sps30_interface_debug_print("sps30: stop measurement failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* UINT16 read test */
+    res = sps30_start_measurement(&gs_handle, SPS30_FORMAT_UINT16);
+    if (res != 0)
+    {
+        sps30_interface_debug_print("sps30: start measurement failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (i = 0; i < times; i++)
+    {
+        /* one sample per second */
+        sps30_interface_delay_ms(1000);
+        gs_sim.value[4] = 10.0f + (float)(i % 1000);
+        if ((sps30_read_u16(&gs_handle, &pm_u16) != 0) || (a_sps30_sim_test_check_u16(&pm_u16) != 0))
+        {
+            sps30_interface_debug_print("sps30: UINT16 read failed.\n");
+            (void)sps30_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    sps30_interface_debug_print("sps30: UINT16 read test passed.\n");
+    
+    /* a direct read within 1 s of the last one is stale */
+    sps30_interface_delay_ms(1000);
+    gs_sim.value[4] = 7.0f;
+    now = sps30_interface_now_ms();
+    if ((sps30_set_read_mode(&gs_handle, SPS30_READ_MODE_DIRECT) != 0) ||
+        (sps30_read_direct(&gs_handle, now, &raw) != 0) ||
+        (sps30_decode_raw_u16(&raw, &pm_u16) != 0) || (a_sps30_sim_test_check_u16(&pm_u16) != 0) ||
+#if ((SPS30_ENABLE_TRACE == 1) || (SPS30_ENABLE_STATS == 1)) && (SPS30_STATIC_PORT != 1)
+        (sps30_read_u16(&gs_handle, &pm_u16) != 5) ||
+#endif
+        (sps30_read_direct(&gs_handle, now + 999, &raw) != 5))
+    {
+        sps30_interface_debug_print("sps30: direct read failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sps30_interface_delay_ms(1000);
+    if ((sps30_read_direct(&gs_handle, now + 1000, &raw) != 0) ||
+        (sps30_set_read_mode(&gs_handle, SPS30_READ_MODE_CHECK_FLAG) != 0))
+    {
+        sps30_interface_debug_print("sps30: direct read failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sps30_interface_debug_print("sps30: direct read test passed.\n");
+    
+    /* stop measurement */
+    res = sps30_stop_measurement(&gs_handle);
+    if (res != 0)
+    {
+        sps30_interface_debug_print("sps30: stop measurement failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* check the device status */
+    gs_sim.status = 1UL << 21;
+    if ((sps30_get_device_status(&gs_handle, &status) != 0) || (status != (1UL << 21)) ||
+        (sps30_clear_device_status(&gs_handle) != 0) ||
+        (sps30_get_device_status(&gs_handle, &status) != 0) || (status != 0))
+    {
+        sps30_interface_debug_print("sps30: check device status failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sps30_interface_debug_print("sps30: check device status passed.\n");
+    
+    /* check sleep and wake up */
+    if ((sps30_sleep(&gs_handle) != 0) || (gs_sim.state != SPS30_SIM_STATE_SLEEP) ||
+        (sps30_wake_up(&gs_handle) != 0) || (gs_sim.state != SPS30_SIM_STATE_IDLE))
+    {
+        sps30_interface_debug_print("sps30: check sleep and wake up failed.\n");
+        (void)sps30_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sps30_interface_debug_print("sps30: check sleep and wake up passed.\n");
+    
+    /* finish sim test */
+    sps30_interface_debug_print("sps30: virtual time is %d ms.\n", (int)(gs_sim.now_us / 1000));
+    sps30_interface_debug_print("sps30: finish sim test.\n");
+    (void)sps30_deinit(&gs_handle);
+    
+    return 0;
+}
+
+/**
+ * @brief     simulator test
+ * @param[in] interface chip interface
+ * @param[in] times test times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      runs on the host against the software model, the simulator is
+ *            set as the interface time source, so every wait is virtual
+ */
+uint8_t sps30_sim_test(sps30_interface_t interface, uint32_t times)
+{
+    uint8_t res;
+    
+    (void)sps30_sim_init(&gs_sim);
+    sps30_interface_set_clock(&gs_sim.clock);
+    res = a_sps30_sim_test_run(interface, times);
+    sps30_interface_set_clock(NULL);
+    
+    return res;
+}